@@ -0,0 +1,244 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeBeliefMap.h"
+
+//=============================================================================
+// FMazeBeliefTopology
+//=============================================================================
+
+void FMazeBeliefTopology::Build(TArrayView<const uint8> Walkable, FIntPoint InSize, float DiffusionRate, uint64 InGridHash)
+{
+    Size = InSize;
+    GridHash = InGridHash;
+    NumFloor = 0;
+
+    // Above 0.25 a cell with four neighbours would give away more than it has
+    Rate = FMath::Clamp(DiffusionRate, 0.0f, 0.25f);
+
+    if (Size.X <= 0 || Size.Y <= 0 || Walkable.Num() != Size.X * Size.Y)
+    {
+        Stride = 0;
+        Keep.Reset();
+        Spread.Reset();
+        Floor.Reset();
+        RowSpans.Reset();
+        return;
+    }
+
+    // Border column on both sides, rounded up to whole vectors
+    Stride = Align(Size.X + 2, 4);
+    const int32 NumPadded = Stride * (Size.Y + 2);
+
+    Floor.SetNumZeroed(NumPadded);
+    Keep.SetNumZeroed(NumPadded);
+    Spread.SetNumZeroed(NumPadded);
+    RowSpans.Init(FIntPoint::ZeroValue, Size.Y + 2);
+
+    for (int32 Y = 0; Y < Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < Size.X; ++X)
+        {
+            Floor[ToPadded(FIntPoint(X, Y))] = Walkable[Y * Size.X + X] ? 1 : 0;
+        }
+    }
+
+    for (int32 Row = 1; Row <= Size.Y; ++Row)
+    {
+        int32 First = INDEX_NONE;
+        int32 Last = INDEX_NONE;
+
+        for (int32 Column = 1; Column <= Size.X; ++Column)
+        {
+            const int32 Index = Row * Stride + Column;
+            if (!Floor[Index])
+            {
+                continue;
+            }
+
+            const int32 Neighbors = Floor[Index - 1] + Floor[Index + 1] + Floor[Index - Stride] + Floor[Index + Stride];
+            Keep[Index] = 1.0f - Rate * Neighbors;
+            Spread[Index] = Rate;
+            ++NumFloor;
+
+            First = First == INDEX_NONE ? Column : First;
+            Last = Column;
+        }
+
+        if (First != INDEX_NONE)
+        {
+            RowSpans[Row] = FIntPoint(AlignDown(First, 4), Align(Last + 1, 4));
+        }
+    }
+}
+
+void FMazeBeliefTopology::Diffuse(const float* RESTRICT In, float* RESTRICT Out) const
+{
+    const float* RESTRICT KeepData = Keep.GetData();
+    const float* RESTRICT SpreadData = Spread.GetData();
+
+    /*
+        4 cells per iteration. The neighbour loads are the same row shifted
+        by one float (unaligned loads) and the rows above and below. Walls
+        inside a span have Keep = Spread = 0 and come out as 0; cells outside
+        every span are never written and stay 0.
+    */
+    for (int32 Row = 1; Row <= Size.Y; ++Row)
+    {
+        const int32 RowStart = Row * Stride;
+        const int32 End = RowStart + RowSpans[Row].Y;
+
+        for (int32 i = RowStart + RowSpans[Row].X; i < End; i += 4)
+        {
+            const VectorRegister4Float Center = VectorLoad(In + i);
+            const VectorRegister4Float Neighbors = VectorAdd(
+                VectorAdd(VectorLoad(In + i - 1), VectorLoad(In + i + 1)),
+                VectorAdd(VectorLoad(In + i - Stride), VectorLoad(In + i + Stride)));
+
+            const VectorRegister4Float Kept = VectorMultiply(VectorLoad(KeepData + i), Center);
+            VectorStore(VectorMultiplyAdd(VectorLoad(SpreadData + i), Neighbors, Kept), Out + i);
+        }
+    }
+}
+
+//=============================================================================
+// FMazeBeliefMap
+//=============================================================================
+
+void FMazeBeliefMap::Reset(const FMazeBeliefTopology& Topology)
+{
+    const int32 NumPadded = Topology.GetNumPadded();
+    Size = Topology.GetSize();
+    Current.SetNumUninitialized(NumPadded, EAllowShrinking::No);
+    Scratch.SetNumUninitialized(NumPadded, EAllowShrinking::No);
+    FMemory::Memzero(Current.GetData(), NumPadded * sizeof(float));
+    FMemory::Memzero(Scratch.GetData(), NumPadded * sizeof(float));
+
+    Total = 0.0f;
+    MostLikelyCell = FIntPoint(-1, -1);
+
+    if (!Topology.IsValid())
+    {
+        return;
+    }
+
+    const float Uniform = 1.0f / Topology.GetNumFloor();
+    for (int32 i = 0; i < NumPadded; ++i)
+    {
+        if (Topology.IsFloor(i))
+        {
+            Current[i] = Uniform;
+        }
+    }
+    Total = 1.0f;
+}
+
+bool FMazeBeliefMap::Matches(const FMazeBeliefTopology& Topology) const
+{
+    return Size == Topology.GetSize() && Current.Num() == Topology.GetNumPadded() && Current.Num() > 0;
+}
+
+void FMazeBeliefMap::Conform(const FMazeBeliefTopology& Topology)
+{
+    if (!Matches(Topology))
+    {
+        Reset(Topology);
+        return;
+    }
+
+    // Spans may have shrunk: the kernel would no longer overwrite cells
+    // outside them, so both buffers must hold 0 there
+    for (int32 i = 0; i < Current.Num(); ++i)
+    {
+        if (!Topology.IsFloor(i))
+        {
+            Current[i] = 0.0f;
+        }
+    }
+    FMemory::Memzero(Scratch.GetData(), Scratch.Num() * sizeof(float));
+
+    Settle(Topology, {});
+}
+
+void FMazeBeliefMap::Diffuse(const FMazeBeliefTopology& Topology, int32 Steps)
+{
+    for (int32 Step = 0; Step < Steps; ++Step)
+    {
+        Topology.Diffuse(Current.GetData(), Scratch.GetData());
+        Swap(Current, Scratch);
+    }
+}
+
+void FMazeBeliefMap::Collapse(const FMazeBeliefTopology& Topology, FIntPoint Cell)
+{
+    FMemory::Memzero(Current.GetData(), Current.Num() * sizeof(float));
+
+    Current[Topology.ToPadded(Cell)] = 1.0f;
+    Total = 1.0f;
+    MostLikelyCell = Cell;
+}
+
+void FMazeBeliefMap::Settle(const FMazeBeliefTopology& Topology, TArrayView<const int32> KeepClear)
+{
+    if (!Topology.IsValid() || !Matches(Topology))
+    {
+        return;
+    }
+
+    const int32 Stride = Topology.GetStride();
+
+    double Sum = 0.0;
+    float Best = 0.0f;
+    int32 BestIndex = INDEX_NONE;
+
+    for (int32 Row = 1; Row <= Size.Y; ++Row)
+    {
+        const FIntPoint Span = Topology.GetRowSpan(Row);
+        for (int32 i = Row * Stride + Span.X; i < Row * Stride + Span.Y; ++i)
+        {
+            const float Value = Current[i];
+            Sum += Value;
+            if (Value > Best)
+            {
+                Best = Value;
+                BestIndex = i;
+            }
+        }
+    }
+
+    if (Sum <= UE_SMALL_NUMBER)
+    {
+        // Everything ruled out (searched the whole reachable area): start
+        // over with "anywhere I am not looking"
+        Reset(Topology);
+        for (const int32 Index : KeepClear)
+        {
+            Current[Index] = 0.0f;
+        }
+        Settle(Topology, {});
+        return;
+    }
+
+    // Keep values well inside float range as observations eat the total
+    if (Sum < 1.0e-3)
+    {
+        const float Scale = static_cast<float>(1.0 / Sum);
+        for (float& Value : Current)
+        {
+            Value *= Scale;
+        }
+        Sum = 1.0;
+    }
+
+    Total = static_cast<float>(Sum);
+    MostLikelyCell = Topology.FromPadded(BestIndex);
+}
+
+float FMazeBeliefMap::GetProbability(const FMazeBeliefTopology& Topology, FIntPoint Cell) const
+{
+    if (Cell.X < 0 || Cell.X >= Size.X || Cell.Y < 0 || Cell.Y >= Size.Y || Total <= 0.0f || !Matches(Topology))
+    {
+        return 0.0f;
+    }
+
+    return Current[Topology.ToPadded(Cell)] / Total;
+}
@@ -0,0 +1,144 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    VectorRegister4Float:
+        - UE's portable SIMD type (SSE on x64, NEON on ARM), 4 floats
+        - VectorLoad / VectorStore accept unaligned pointers
+
+    BELIEF MAP:
+        - One probability per cell: "how likely is the player here?"
+        - DIFFUSE: every floor cell passes a fraction of its probability to
+          each floor neighbour (the player may have walked there)
+        - OBSERVE: cells the enemy can see and where the player is NOT get
+          zero; if the player IS seen, everything collapses onto that cell
+        - The enemy never reads the player's position unless it sees it
+
+    PADDED LAYOUT:
+        - The grid is stored with a one-cell wall border and rows rounded
+          up to a multiple of 4 floats
+        - Every neighbour read is then in bounds, so the kernel has no
+          edge cases and processes 4 cells per instruction
+=============================================================================*/
+
+/**
+ * Diffusion weights for one maze layout, shared by every belief map on it.
+ *
+ *   P'[i] = Keep[i] * P[i] + Spread[i] * (P[E] + P[W] + P[S] + P[N])
+ *
+ * Spread is the diffusion rate on floor cells, Keep = 1 - Rate * (floor
+ * neighbours). Both are 0 on walls, so walls never hold probability and
+ * the total is conserved.
+ */
+class THELASTMASK_API FMazeBeliefTopology
+{
+public:
+    /**
+     * Build from walkability.
+     *
+     * @param Walkable - One byte per cell, row-major (1 = floor)
+     * @param DiffusionRate - Share passed to each neighbour per step (clamped to 0..0.25)
+     * @param InGridHash - Layout hash, so owners can tell when to rebuild
+     */
+    void Build(TArrayView<const uint8> Walkable, FIntPoint InSize, float DiffusionRate, uint64 InGridHash);
+
+    /** One diffusion step, In -> Out (padded arrays of GetNumPadded floats) */
+    void Diffuse(const float* RESTRICT In, float* RESTRICT Out) const;
+
+    bool IsValid() const { return NumFloor > 0; }
+
+    FIntPoint GetSize() const { return Size; }
+    int32 GetStride() const { return Stride; }
+    int32 GetNumPadded() const { return Floor.Num(); }
+    int32 GetNumFloor() const { return NumFloor; }
+    uint64 GetGridHash() const { return GridHash; }
+    float GetDiffusionRate() const { return Rate; }
+
+    /** Padded index of a grid cell (no bounds check) */
+    int32 ToPadded(FIntPoint Cell) const { return (Cell.Y + 1) * Stride + Cell.X + 1; }
+
+    /** Grid cell of a padded index */
+    FIntPoint FromPadded(int32 Index) const { return FIntPoint(Index % Stride - 1, Index / Stride - 1); }
+
+    /** Is this padded index a floor cell? */
+    bool IsFloor(int32 Index) const { return Floor[Index] != 0; }
+
+    /** Columns [X, Y) of a padded row that can hold probability (multiples of 4) */
+    FIntPoint GetRowSpan(int32 PaddedRow) const { return RowSpans[PaddedRow]; }
+
+private:
+    FIntPoint Size = FIntPoint::ZeroValue;
+    int32 Stride = 0;
+    int32 NumFloor = 0;
+    uint64 GridHash = 0;
+    float Rate = 0.0f;
+
+    TArray<float> Keep;
+    TArray<float> Spread;
+    TArray<uint8> Floor;
+
+    /** Per padded row: first and end column to process (floor cells only, rounded out to 4) */
+    TArray<FIntPoint> RowSpans;
+};
+
+/**
+ * One enemy's belief about where the player is.
+ *
+ * Probabilities are stored unnormalized (diffusion is linear, so scaling
+ * can wait); GetProbability divides by the running total.
+ */
+class THELASTMASK_API FMazeBeliefMap
+{
+public:
+    /** Spread belief evenly over every floor cell ("could be anywhere") */
+    void Reset(const FMazeBeliefTopology& Topology);
+
+    /** Was Reset called with a topology of this size? */
+    bool Matches(const FMazeBeliefTopology& Topology) const;
+
+    /**
+     * Adopt a rebuilt topology of the same size: belief on cells that became
+     * walls is dropped. Falls back to Reset if the size changed.
+     */
+    void Conform(const FMazeBeliefTopology& Topology);
+
+    /** Run diffusion steps (SIMD kernel, no allocations) */
+    void Diffuse(const FMazeBeliefTopology& Topology, int32 Steps);
+
+    /** The player is not here: zero a cell (padded index) */
+    void ClearCell(int32 PaddedIndex) { Current[PaddedIndex] = 0.0f; }
+
+    /** The player is here: all belief on one cell */
+    void Collapse(const FMazeBeliefTopology& Topology, FIntPoint Cell);
+
+    /**
+     * Recompute the total and the most likely cell after observations.
+     * Renormalizes when the total gets small, and resets (excluding
+     * KeepClear cells) if every bit of belief was ruled out.
+     */
+    void Settle(const FMazeBeliefTopology& Topology, TArrayView<const int32> KeepClear);
+
+    /** Normalized probability of a grid cell (0 out of bounds) */
+    float GetProbability(const FMazeBeliefTopology& Topology, FIntPoint Cell) const;
+
+    /** Most likely cell as of the last Settle */
+    FIntPoint GetMostLikelyCell() const { return MostLikelyCell; }
+
+    /** Unnormalized values, padded layout */
+    const TArray<float>& GetValues() const { return Current; }
+
+    /** Sum of GetValues over the floor, as of the last Settle */
+    float GetTotal() const { return Total; }
+
+private:
+    TArray<float> Current;
+    TArray<float> Scratch;
+    FIntPoint Size = FIntPoint::ZeroValue;
+    float Total = 0.0f;
+    FIntPoint MostLikelyCell = FIntPoint(-1, -1);
+};
@@ -0,0 +1,377 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeDerivedData.h"
+
+/*=============================================================================
+    CLEARANCE: TWO-PASS DISTANCE TRANSFORM
+
+    With the Chebyshev metric (diagonal step = straight step = 1) the exact
+    distance to the nearest wall can be found with two sweeps:
+
+    Forward  (top-left -> bottom-right):  look at left, up-left, up, up-right
+    Backward (bottom-right -> top-left):  look at right, down-right, down, down-left
+
+    Each cell takes min(neighbours) + 1. Walls are 0. No queue, no search,
+    and the forward sweep only needs rows that have already been seen,
+    which is what makes the streaming build possible.
+
+    The same two sweeps work on a window: cells just outside it keep
+    their (still correct) values and act as the boundary.
+=============================================================================*/
+
+void FMazeDerivedData::Build(const TArray<FMazeCell>& Cells, FIntPoint InSize)
+{
+    if (Cells.Num() != InSize.X * InSize.Y)
+    {
+        Reset();
+        return;
+    }
+
+    BeginBuild(InSize);
+    for (int32 Y = 0; Y < Size.Y; ++Y)
+    {
+        AddRow(Cells, Y);
+    }
+    FinishBuild(Cells);
+}
+
+void FMazeDerivedData::BeginBuild(FIntPoint InSize)
+{
+    Size = InSize;
+    FloorCount = 0;
+
+    const int32 NumCells = FMath::Max(Size.X * Size.Y, 0);
+    Topology.SetNumUninitialized(NumCells);
+    Clearance.SetNumUninitialized(NumCells);
+    Components.Reset();
+    NumComponents = 0;
+}
+
+void FMazeDerivedData::AddRow(const TArray<FMazeCell>& Cells, int32 Y)
+{
+    // Forward clearance sweep for this row
+    for (int32 X = 0; X < Size.X; ++X)
+    {
+        const int32 Index = Y * Size.X + X;
+
+        if (!Cells[Index].bIsFloor)
+        {
+            Clearance[Index] = 0;
+            continue;
+        }
+
+        ++FloorCount;
+
+        const uint8 Nearest = FMath::Min(
+            FMath::Min(ClearanceAt(X - 1, Y), ClearanceAt(X - 1, Y - 1)),
+            FMath::Min(ClearanceAt(X, Y - 1), ClearanceAt(X + 1, Y - 1)));
+
+        Clearance[Index] = static_cast<uint8>(FMath::Min<int32>(Nearest + 1, MaxClearance));
+    }
+
+    // The row above now has both of its neighbours rows available
+    if (Y > 0)
+    {
+        ComputeTopologyRow(Cells, Y - 1);
+    }
+}
+
+void FMazeDerivedData::FinishBuild(const TArray<FMazeCell>& Cells)
+{
+    if (Size.Y > 0)
+    {
+        ComputeTopologyRow(Cells, Size.Y - 1);
+    }
+
+    // Backward clearance sweep
+    for (int32 Y = Size.Y - 1; Y >= 0; --Y)
+    {
+        for (int32 X = Size.X - 1; X >= 0; --X)
+        {
+            const int32 Index = Y * Size.X + X;
+            if (Clearance[Index] == 0)
+            {
+                continue;
+            }
+
+            const uint8 Nearest = FMath::Min(
+                FMath::Min(ClearanceAt(X + 1, Y), ClearanceAt(X + 1, Y + 1)),
+                FMath::Min(ClearanceAt(X, Y + 1), ClearanceAt(X - 1, Y + 1)));
+
+            Clearance[Index] = FMath::Min<uint8>(Clearance[Index], static_cast<uint8>(Nearest + 1));
+        }
+    }
+
+    LabelAllComponents(Cells);
+}
+
+void FMazeDerivedData::RefreshCells(const TArray<FMazeCell>& Cells, TArrayView<const FIntPoint> ChangedCells)
+{
+    if (ChangedCells.Num() == 0 || !IsBuiltFor(Size) || Cells.Num() != Topology.Num())
+    {
+        return;
+    }
+
+    // Bounding box of the edit (Max is exclusive)
+    FIntRect Dirty(ChangedCells[0], ChangedCells[0] + FIntPoint(1, 1));
+    for (const FIntPoint& Cell : ChangedCells)
+    {
+        Dirty.Include(Cell);
+        Dirty.Include(Cell + FIntPoint(1, 1));
+    }
+
+    const FIntPoint GridMax = Size;
+    auto ClampRect = [GridMax](FIntRect Rect)
+    {
+        Rect.Min = Rect.Min.ComponentMax(FIntPoint::ZeroValue);
+        Rect.Max = Rect.Max.ComponentMin(GridMax);
+        return Rect;
+    };
+
+    //=========================================================================
+    // TOPOLOGY (3x3 neighbourhood -> changed cells grown by 1)
+    //=========================================================================
+
+    const FIntRect TopologyRect = ClampRect(Dirty.Inner(FIntPoint(-1, -1)));
+    for (int32 Y = TopologyRect.Min.Y; Y < TopologyRect.Max.Y; ++Y)
+    {
+        for (int32 X = TopologyRect.Min.X; X < TopologyRect.Max.X; ++X)
+        {
+            Topology[Y * Size.X + X] = static_cast<uint8>(ComputeTopology(Cells, X, Y));
+        }
+    }
+
+    //=========================================================================
+    // CLEARANCE (capped at MaxClearance -> changed cells grown by MaxClearance)
+    //=========================================================================
+
+    ComputeClearanceRect(Cells, ClampRect(Dirty.Inner(FIntPoint(-MaxClearance, -MaxClearance))));
+
+    //=========================================================================
+    // COMPONENTS
+    // Brush strokes flip many cells at once, so the whole edit is handled
+    // as one: every region touching a changed cell (before the edit) is
+    // dropped, then relabelled by flooding from the changed cells and their
+    // floor neighbours. Floods only ever reach dropped regions and new
+    // floor, so the rest of the grid keeps its IDs.
+    //=========================================================================
+
+    const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+    // Snapshot before any ID is touched: Components still describes the old grid
+    TSet<int32> ChangedIndices;
+    TSet<int32> AffectedIds;
+    for (const FIntPoint& Cell : ChangedCells)
+    {
+        const int32 Index = Cell.Y * Size.X + Cell.X;
+        bool bAlreadyChanged = false;
+        ChangedIndices.Add(Index, &bAlreadyChanged);
+        if (bAlreadyChanged)
+        {
+            continue;
+        }
+
+        const bool bWasFloor = Components[Index] != INDEX_NONE;
+        FloorCount += static_cast<int32>(Cells[Index].bIsFloor) - static_cast<int32>(bWasFloor);
+
+        if (bWasFloor)
+        {
+            AffectedIds.Add(Components[Index]);
+        }
+        for (const FIntPoint& Offset : Offsets)
+        {
+            const int32 Id = GetComponent(Cell + Offset);
+            if (Id != INDEX_NONE)
+            {
+                AffectedIds.Add(Id);
+            }
+        }
+    }
+
+    for (int32 Index : ChangedIndices)
+    {
+        Components[Index] = INDEX_NONE;
+    }
+    NumComponents -= AffectedIds.Num();
+
+    auto FloodFrom = [&](int32 Seed)
+    {
+        const int32 Id = Components[Seed];
+        if (Cells[Seed].bIsFloor && (Id == INDEX_NONE || AffectedIds.Contains(Id)))
+        {
+            FloodComponent(Cells, Seed, NextComponentId++);
+            ++NumComponents;
+        }
+    };
+
+    for (int32 Index : ChangedIndices)
+    {
+        const FIntPoint Cell(Index % Size.X, Index / Size.X);
+        FloodFrom(Index);
+        for (const FIntPoint& Offset : Offsets)
+        {
+            const FIntPoint Neighbor = Cell + Offset;
+            if (IsInBounds(Neighbor))
+            {
+                FloodFrom(Neighbor.Y * Size.X + Neighbor.X);
+            }
+        }
+    }
+}
+
+void FMazeDerivedData::Reset()
+{
+    Size = FIntPoint::ZeroValue;
+    Topology.Reset();
+    Clearance.Reset();
+    Components.Reset();
+    FloorCount = 0;
+    NumComponents = 0;
+    NextComponentId = 0;
+}
+
+void FMazeDerivedData::ComputeClearanceRect(const TArray<FMazeCell>& Cells, const FIntRect& Rect)
+{
+    // Reset the window: walls to 0, floor to "as far as it gets"
+    for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+    {
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            const int32 Index = Y * Size.X + X;
+            Clearance[Index] = Cells[Index].bIsFloor ? MaxClearance : 0;
+        }
+    }
+
+    // Forward sweep: pulls in the rows above and the columns to the left
+    for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+    {
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            const int32 Index = Y * Size.X + X;
+            if (Clearance[Index] == 0)
+            {
+                continue;
+            }
+
+            const uint8 Nearest = FMath::Min(
+                FMath::Min(ClearanceAt(X - 1, Y), ClearanceAt(X - 1, Y - 1)),
+                FMath::Min(ClearanceAt(X, Y - 1), ClearanceAt(X + 1, Y - 1)));
+
+            Clearance[Index] = FMath::Min<uint8>(Clearance[Index], static_cast<uint8>(Nearest + 1));
+        }
+    }
+
+    // Backward sweep: pulls in the rows below and the columns to the right
+    for (int32 Y = Rect.Max.Y - 1; Y >= Rect.Min.Y; --Y)
+    {
+        for (int32 X = Rect.Max.X - 1; X >= Rect.Min.X; --X)
+        {
+            const int32 Index = Y * Size.X + X;
+            if (Clearance[Index] == 0)
+            {
+                continue;
+            }
+
+            const uint8 Nearest = FMath::Min(
+                FMath::Min(ClearanceAt(X + 1, Y), ClearanceAt(X + 1, Y + 1)),
+                FMath::Min(ClearanceAt(X, Y + 1), ClearanceAt(X - 1, Y + 1)));
+
+            Clearance[Index] = FMath::Min<uint8>(Clearance[Index], static_cast<uint8>(Nearest + 1));
+        }
+    }
+}
+
+void FMazeDerivedData::LabelAllComponents(const TArray<FMazeCell>& Cells)
+{
+    Components.Init(INDEX_NONE, Topology.Num());
+    NumComponents = 0;
+    NextComponentId = 0;
+
+    for (int32 Index = 0; Index < Components.Num(); ++Index)
+    {
+        if (Cells[Index].bIsFloor && Components[Index] == INDEX_NONE)
+        {
+            FloodComponent(Cells, Index, NextComponentId++);
+            ++NumComponents;
+        }
+    }
+}
+
+int32 FMazeDerivedData::FloodComponent(const TArray<FMazeCell>& Cells, int32 Seed, int32 NewId)
+{
+    TArray<int32> Stack;
+    Stack.Add(Seed);
+    Components[Seed] = NewId;
+    int32 Relabelled = 1;
+
+    while (Stack.Num() > 0)
+    {
+        const int32 Current = Stack.Pop(EAllowShrinking::No);
+        const int32 X = Current % Size.X;
+        const int32 Y = Current / Size.X;
+
+        const int32 Neighbors[] = {
+            X + 1 < Size.X ? Current + 1 : INDEX_NONE,
+            X > 0 ? Current - 1 : INDEX_NONE,
+            Y + 1 < Size.Y ? Current + Size.X : INDEX_NONE,
+            Y > 0 ? Current - Size.X : INDEX_NONE
+        };
+
+        for (int32 Neighbor : Neighbors)
+        {
+            if (Neighbor != INDEX_NONE && Cells[Neighbor].bIsFloor && Components[Neighbor] != NewId)
+            {
+                Components[Neighbor] = NewId;
+                Stack.Add(Neighbor);
+                ++Relabelled;
+            }
+        }
+    }
+
+    return Relabelled;
+}
+
+void FMazeDerivedData::ComputeTopologyRow(const TArray<FMazeCell>& Cells, int32 Y)
+{
+    for (int32 X = 0; X < Size.X; ++X)
+    {
+        Topology[Y * Size.X + X] = static_cast<uint8>(ComputeTopology(Cells, X, Y));
+    }
+}
+
+EMazeCellTopology FMazeDerivedData::ComputeTopology(const TArray<FMazeCell>& Cells, int32 X, int32 Y) const
+{
+    if (!IsFloorAt(Cells, X, Y))
+    {
+        return EMazeCellTopology::Wall;
+    }
+
+    const bool bEast = IsFloorAt(Cells, X + 1, Y);
+    const bool bWest = IsFloorAt(Cells, X - 1, Y);
+    const bool bSouth = IsFloorAt(Cells, X, Y + 1);
+    const bool bNorth = IsFloorAt(Cells, X, Y - 1);
+    const int32 OpenCount = bEast + bWest + bSouth + bNorth;
+
+    const bool bDiagonalsOpen =
+        IsFloorAt(Cells, X + 1, Y + 1) && IsFloorAt(Cells, X - 1, Y + 1) &&
+        IsFloorAt(Cells, X + 1, Y - 1) && IsFloorAt(Cells, X - 1, Y - 1);
+
+    if (OpenCount == 4 && bDiagonalsOpen)
+    {
+        return EMazeCellTopology::Room;
+    }
+    if (OpenCount >= 3)
+    {
+        return EMazeCellTopology::Junction;
+    }
+    if (OpenCount == 2)
+    {
+        const bool bStraight = (bEast && bWest) || (bNorth && bSouth);
+        return bStraight ? EMazeCellTopology::Corridor : EMazeCellTopology::Corner;
+    }
+    if (OpenCount == 1)
+    {
+        return EMazeCellTopology::DeadEnd;
+    }
+    return EMazeCellTopology::Isolated;
+}
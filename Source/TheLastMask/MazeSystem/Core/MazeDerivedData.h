@@ -0,0 +1,165 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MazeTypes.h"
+
+/*=============================================================================
+    DERIVED DATA
+
+    Values that can always be recomputed from the floor/wall grid, but are
+    too expensive to recompute every time someone asks. They are NOT saved
+    with the asset: UMazeGridData rebuilds them on load and after edits.
+
+    Topology:
+        - One EMazeCellTopology per cell (dead end, corridor, junction...)
+        - Depends only on the 3x3 neighbourhood
+
+    Clearance:
+        - Chebyshev distance (in cells) from a floor cell to the nearest
+          wall, counting the area outside the grid as wall
+        - 0 = wall, 1 = touching a wall (incl. diagonally), 2+ = open space
+        - Capped at MaxClearance so edits only disturb a bounded area
+
+    Components:
+        - Connected region ID per floor cell (4-connected), INDEX_NONE for walls
+        - Two cells with different IDs can never reach each other
+
+    The build is row-based (BeginBuild / AddRow / FinishBuild) so that
+    importers can produce derived data while the grid is still streaming in.
+    After small edits, RefreshCells updates only what the edit can affect.
+=============================================================================*/
+
+/**
+ * Cached per-cell analysis of a maze grid.
+ * Plain C++ (not reflected): owned by UMazeGridData and rebuilt, never saved.
+ */
+struct THELASTMASK_API FMazeDerivedData
+{
+    /** Clearance values are clamped to this */
+    static constexpr uint8 MaxClearance = 15;
+
+    /** Grid dimensions the data was built for */
+    FIntPoint Size = FIntPoint::ZeroValue;
+
+    /** EMazeCellTopology per cell (Index = Y * SizeX + X) */
+    TArray<uint8> Topology;
+
+    /** Distance to nearest wall per cell, 0..MaxClearance */
+    TArray<uint8> Clearance;
+
+    /** Connected region per cell, INDEX_NONE for walls. IDs are not contiguous after edits. */
+    TArray<int32> Components;
+
+    /** Number of walkable cells */
+    int32 FloorCount = 0;
+
+    /** Number of distinct regions */
+    int32 NumComponents = 0;
+
+    //=========================================================================
+    // BUILD
+    //=========================================================================
+
+    /** Build everything from a complete cell array */
+    void Build(const TArray<FMazeCell>& Cells, FIntPoint InSize);
+
+    /** Start a row-by-row build */
+    void BeginBuild(FIntPoint InSize);
+
+    /**
+     * Feed one row. Rows must arrive in order (0, 1, 2...).
+     * Only rows 0..Y of Cells need to be filled in when this is called.
+     */
+    void AddRow(const TArray<FMazeCell>& Cells, int32 Y);
+
+    /** Finish a row-by-row build once every row has been added */
+    void FinishBuild(const TArray<FMazeCell>& Cells);
+
+    /**
+     * Update after some cells flipped between floor and wall.
+     * 
+     * Topology is redone for the changed cells and their 8 neighbours,
+     * clearance for a window MaxClearance cells around them (clearance is
+     * capped, so nothing farther can change), and components only for the
+     * regions touching a changed cell.
+     * 
+     * @param Cells - Grid after the edit
+     * @param ChangedCells - Cells whose bIsFloor changed
+     */
+    void RefreshCells(const TArray<FMazeCell>& Cells, TArrayView<const FIntPoint> ChangedCells);
+
+    /** Drop all data */
+    void Reset();
+
+    //=========================================================================
+    // QUERIES
+    //=========================================================================
+
+    /** Was this built for a grid of the given size? */
+    bool IsBuiltFor(FIntPoint InSize) const
+    {
+        return Size == InSize && Topology.Num() == InSize.X * InSize.Y;
+    }
+
+    /** Topology of a cell (Wall if out of bounds) */
+    EMazeCellTopology GetTopology(FIntPoint Cell) const
+    {
+        return IsInBounds(Cell)
+            ? static_cast<EMazeCellTopology>(Topology[Cell.Y * Size.X + Cell.X])
+            : EMazeCellTopology::Wall;
+    }
+
+    /** Component ID of a cell (INDEX_NONE for walls and out of bounds) */
+    int32 GetComponent(FIntPoint Cell) const
+    {
+        return IsInBounds(Cell) && Components.Num() == Topology.Num() ? Components[Cell.Y * Size.X + Cell.X] : INDEX_NONE;
+    }
+
+    /** Clearance of a cell (0 if out of bounds) */
+    uint8 GetClearance(FIntPoint Cell) const
+    {
+        return IsInBounds(Cell) ? Clearance[Cell.Y * Size.X + Cell.X] : 0;
+    }
+
+    bool IsInBounds(FIntPoint Cell) const
+    {
+        return Cell.X >= 0 && Cell.X < Size.X && Cell.Y >= 0 && Cell.Y < Size.Y
+            && Topology.Num() == Size.X * Size.Y;
+    }
+
+private:
+    /** Classify every cell of one row (needs the rows above and below) */
+    void ComputeTopologyRow(const TArray<FMazeCell>& Cells, int32 Y);
+
+    /** Classify one cell from its 3x3 neighbourhood */
+    EMazeCellTopology ComputeTopology(const TArray<FMazeCell>& Cells, int32 X, int32 Y) const;
+
+    /** Both clearance sweeps over a rectangle; cells outside it are read as-is */
+    void ComputeClearanceRect(const TArray<FMazeCell>& Cells, const FIntRect& Rect);
+
+    /** Label every region from scratch */
+    void LabelAllComponents(const TArray<FMazeCell>& Cells);
+
+    /**
+     * Flood a region from Seed, writing NewId over cells whose ID is not NewId.
+     * @return Cells relabelled
+     */
+    int32 FloodComponent(const TArray<FMazeCell>& Cells, int32 Seed, int32 NewId);
+
+    /** Next unused component ID */
+    int32 NextComponentId = 0;
+
+    /** Is (X, Y) a floor cell? Out of bounds counts as wall. */
+    bool IsFloorAt(const TArray<FMazeCell>& Cells, int32 X, int32 Y) const
+    {
+        return X >= 0 && X < Size.X && Y >= 0 && Y < Size.Y && Cells[Y * Size.X + X].bIsFloor;
+    }
+
+    /** Clearance read with out-of-bounds = wall */
+    uint8 ClearanceAt(int32 X, int32 Y) const
+    {
+        return (X >= 0 && X < Size.X && Y >= 0 && Y < Size.Y) ? Clearance[Y * Size.X + X] : 0;
+    }
+};
@@ -0,0 +1,154 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeEditJournal.h"
+
+int32 FMazeEditJournal::Begin(FName Label)
+{
+    if (OpenDepth++ == 0)
+    {
+        OpenTransaction = FMazeEditTransaction();
+        OpenTransaction.Id = NextId++;
+        OpenTransaction.Label = Label;
+        OpenTransaction.FirstEdit = Edits.Num();
+    }
+
+    return OpenTransaction.Id;
+}
+
+int32 FMazeEditJournal::End()
+{
+    if (OpenDepth == 0 || --OpenDepth > 0)
+    {
+        return 0;
+    }
+
+    OpenTransaction.NumEdits = Edits.Num() - OpenTransaction.FirstEdit;
+    if (OpenTransaction.NumEdits == 0)
+    {
+        return 0;
+    }
+
+    Transactions.Add(OpenTransaction);
+    Trim();
+
+    // Trim drops oldest first, so only an oversized transaction loses itself
+    if (Transactions.Num() == 0 || Transactions.Last().Id != OpenTransaction.Id)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeEditJournal: Transaction %d (%d edits) exceeds MaxEdits (%d) and can't be rolled back"),
+            OpenTransaction.Id, OpenTransaction.NumEdits, MaxEdits);
+        return 0;
+    }
+    return OpenTransaction.Id;
+}
+
+void FMazeEditJournal::Record(int32 Index, uint8 OldValue, uint8 NewValue)
+{
+    checkf(OpenDepth > 0, TEXT("FMazeEditJournal::Record called outside a transaction"));
+
+    FMazeCellEdit& Edit = Edits.AddDefaulted_GetRef();
+    Edit.Index = Index;
+    Edit.OldValue = OldValue;
+    Edit.NewValue = NewValue;
+}
+
+bool FMazeEditJournal::TakeTransaction(int32 Id, TArray<FMazeCellEdit>& OutEdits)
+{
+    OutEdits.Reset();
+
+    // Rollbacks are almost always recent: search from the newest
+    int32 TransactionIndex = INDEX_NONE;
+    for (int32 i = Transactions.Num() - 1; i >= 0; --i)
+    {
+        if (Transactions[i].Id == Id)
+        {
+            TransactionIndex = i;
+            break;
+        }
+    }
+
+    if (TransactionIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FMazeEditTransaction Taken = Transactions[TransactionIndex];
+
+    // Later transactions sit after it in Edits: refuse if any touched the same cells
+    const int32 LaterFirst = Taken.FirstEdit + Taken.NumEdits;
+    if (LaterFirst < Edits.Num())
+    {
+        TSet<int32> TakenCells;
+        TakenCells.Reserve(Taken.NumEdits);
+        for (int32 i = Taken.FirstEdit; i < LaterFirst; ++i)
+        {
+            TakenCells.Add(Edits[i].Index);
+        }
+
+        for (int32 i = LaterFirst; i < Edits.Num(); ++i)
+        {
+            if (TakenCells.Contains(Edits[i].Index))
+            {
+                return false;
+            }
+        }
+    }
+
+    OutEdits.Reserve(Taken.NumEdits);
+    for (int32 i = Taken.FirstEdit + Taken.NumEdits - 1; i >= Taken.FirstEdit; --i)
+    {
+        OutEdits.Add(Edits[i]);
+    }
+
+    // Close the gap; the newest transaction (the usual case) needs no move
+    Edits.RemoveAt(Taken.FirstEdit, Taken.NumEdits, EAllowShrinking::No);
+    Transactions.RemoveAt(TransactionIndex, 1, EAllowShrinking::No);
+    for (int32 i = TransactionIndex; i < Transactions.Num(); ++i)
+    {
+        Transactions[i].FirstEdit -= Taken.NumEdits;
+    }
+    if (OpenDepth > 0)
+    {
+        OpenTransaction.FirstEdit -= Taken.NumEdits;
+    }
+
+    return true;
+}
+
+int32 FMazeEditJournal::GetLatestTransactionId() const
+{
+    return Transactions.Num() > 0 ? Transactions.Last().Id : 0;
+}
+
+void FMazeEditJournal::Reset()
+{
+    Edits.Reset();
+    Transactions.Reset();
+    OpenTransaction = FMazeEditTransaction();
+    OpenDepth = 0;
+}
+
+void FMazeEditJournal::Trim()
+{
+    int32 NumDropped = 0;
+    int32 EditsDropped = 0;
+
+    while (NumDropped < Transactions.Num() && Edits.Num() - EditsDropped > MaxEdits)
+    {
+        EditsDropped += Transactions[NumDropped].NumEdits;
+        ++NumDropped;
+    }
+
+    if (NumDropped == 0)
+    {
+        return;
+    }
+
+    Edits.RemoveAt(0, EditsDropped, EAllowShrinking::No);
+    Transactions.RemoveAt(0, NumDropped, EAllowShrinking::No);
+    for (FMazeEditTransaction& Transaction : Transactions)
+    {
+        Transaction.FirstEdit -= EditsDropped;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("MazeEditJournal: Dropped %d oldest transactions (%d edits)"), NumDropped, EditsDropped);
+}
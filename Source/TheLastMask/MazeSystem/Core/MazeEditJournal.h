@@ -0,0 +1,122 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    JOURNAL (undo log):
+        - Every edit is stored as (cell, old value, new value)
+        - Undoing = writing the old values back, newest first
+        - Cost is proportional to the edit, never to the grid size
+
+    TRANSACTIONS:
+        - Edits are grouped (one "shifting walls" event = one transaction)
+        - A transaction is rolled back as a whole, by its id
+=============================================================================*/
+
+/**
+ * One recorded cell change. 8 bytes.
+ * Values are walkability bytes (0 = wall, 1 = floor).
+ */
+struct FMazeCellEdit
+{
+    int32 Index = INDEX_NONE;
+    uint8 OldValue = 0;
+    uint8 NewValue = 0;
+};
+
+/**
+ * A group of edits that are undone together.
+ */
+struct FMazeEditTransaction
+{
+    /** Unique id (> 0) */
+    int32 Id = 0;
+
+    /** What caused it, for logs and debugging */
+    FName Label;
+
+    /** Range in the journal's edit array */
+    int32 FirstEdit = 0;
+    int32 NumEdits = 0;
+};
+
+/**
+ * Transaction log of runtime grid edits (see AMazeManager::SetCellsFloor).
+ *
+ * Edits live in one flat array; transactions are ranges into it. Only
+ * edits are stored, so a 1000-transaction session of small wall shifts
+ * costs a few KB. When MaxEdits is exceeded, the oldest transactions are
+ * forgotten (they can no longer be rolled back).
+ */
+class THELASTMASK_API FMazeEditJournal
+{
+public:
+    /** Oldest transactions are dropped beyond this many edits */
+    int32 MaxEdits = 1 << 16;
+
+    /**
+     * Open a transaction. Nested Begin calls join the open one.
+     * @return Id of the open transaction
+     */
+    int32 Begin(FName Label);
+
+    /**
+     * Close the open transaction (the outermost End closes it).
+     * Transactions without edits are discarded.
+     * @return Id of the closed transaction, 0 if it was empty, still nested,
+     *         or on its own larger than MaxEdits (dropped at once)
+     */
+    int32 End();
+
+    /** Is a transaction open? */
+    bool IsOpen() const { return OpenDepth > 0; }
+
+    /** Add an edit to the open transaction */
+    void Record(int32 Index, uint8 OldValue, uint8 NewValue);
+
+    /**
+     * Remove a transaction and hand back its edits, newest first (the order
+     * to undo them in).
+     *
+     * Refused while a later transaction changed any of the same cells:
+     * undoing out of order would write old values over the later edits
+     * and leave cells the later rollback can no longer restore.
+     *
+     * @return False if the id is unknown (never existed, already rolled back,
+     *         or dropped for space), the transaction is still open, or a
+     *         later transaction overlaps it (roll that one back first)
+     */
+    bool TakeTransaction(int32 Id, TArray<FMazeCellEdit>& OutEdits);
+
+    /** Id of the newest closed transaction (0 if none) */
+    int32 GetLatestTransactionId() const;
+
+    /** Closed transactions, oldest first */
+    const TArray<FMazeEditTransaction>& GetTransactions() const { return Transactions; }
+
+    /** Forget everything (new maze) */
+    void Reset();
+
+    /** Bytes held by the journal */
+    SIZE_T GetAllocatedSize() const { return Edits.GetAllocatedSize() + Transactions.GetAllocatedSize(); }
+
+private:
+    /** Drop the oldest transactions until the edit count fits MaxEdits */
+    void Trim();
+
+    /** All edits, grouped by transaction in order */
+    TArray<FMazeCellEdit> Edits;
+
+    /** Closed transactions, oldest first (ascending ids) */
+    TArray<FMazeEditTransaction> Transactions;
+
+    /** Transaction being recorded */
+    FMazeEditTransaction OpenTransaction;
+    int32 OpenDepth = 0;
+
+    int32 NextId = 1;
+};
@@ -2,3 +2,125 @@
 
 
 #include "MazeGridData.h"
+#include "MazeGridImage.h"
+#include "MazeGridHash.h"
+
+void UMazeGridData::PostLoad()
+{
+    Super::PostLoad();
+
+    // Derived data is never saved; rebuild it once the cells are in memory
+    RebuildDerivedData();
+
+    if (!IsBakeConsistent())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeGridData: %s cells (hash %s) differ from the baked level (hash %s). Re-bake the maze."),
+            *GetName(), *GetGridHashString(), *FMazeGridHash::ToString(BakedGridHash));
+    }
+}
+
+void UMazeGridData::RebuildDerivedData()
+{
+    if (IsValid())
+    {
+        DerivedData.Build(Cells, FIntPoint(SizeX, SizeY));
+    }
+    else
+    {
+        DerivedData.Reset();
+    }
+
+    GridHash = FMazeGridHash::Compute(Cells, FIntPoint(SizeX, SizeY));
+}
+
+const FMazeDerivedData& UMazeGridData::GetDerivedData() const
+{
+    if (IsValid() && !DerivedData.IsBuiltFor(FIntPoint(SizeX, SizeY)))
+    {
+        DerivedData.Build(Cells, FIntPoint(SizeX, SizeY));
+        GridHash = FMazeGridHash::Compute(Cells, FIntPoint(SizeX, SizeY));
+    }
+
+    return DerivedData;
+}
+
+uint64 UMazeGridData::GetGridHash() const
+{
+    // Same staleness rule as the derived data: both are built together
+    GetDerivedData();
+    return IsValid() ? GridHash : 0;
+}
+
+FString UMazeGridData::GetGridHashString() const
+{
+    return FMazeGridHash::ToString(GetGridHash());
+}
+
+int32 UMazeGridData::PaintCells(TArrayView<const FIntPoint> InCells, bool bFloor, TArray<FIntPoint>* OutChanged)
+{
+    TArray<FIntPoint> LocalChanged;
+    TArray<FIntPoint>& Changed = OutChanged ? *OutChanged : LocalChanged;
+    Changed.Reset();
+
+    if (!IsValid())
+    {
+        return 0;
+    }
+
+    // Make sure the incremental refresh has something to start from
+    GetDerivedData();
+
+    for (const FIntPoint& Cell : InCells)
+    {
+        if (Cell.X < 0 || Cell.X >= SizeX || Cell.Y < 0 || Cell.Y >= SizeY)
+        {
+            continue;
+        }
+
+        FMazeCell& Target = Cells[Cell.Y * SizeX + Cell.X];
+        if (Target.bIsFloor != bFloor)
+        {
+            if (Changed.Num() == 0)
+            {
+                Modify();
+            }
+
+            Target.bIsFloor = bFloor;
+            GridHash = FMazeGridHash::Toggle(GridHash, Cell.Y * SizeX + Cell.X);
+            Changed.Add(Cell);
+        }
+    }
+
+    DerivedData.RefreshCells(Cells, Changed);
+    return Changed.Num();
+}
+
+#if WITH_EDITOR
+void UMazeGridData::ImportFromImage()
+{
+    FString Error;
+    Modify();
+
+    if (!FMazeGridImageCodec::Import(*this, ImageFile.FilePath, Error, RawImageSize))
+    {
+        UE_LOG(LogTemp, Error, TEXT("MazeGridData: Import failed: %s"), *Error);
+        return;
+    }
+
+    MarkPackageDirty();
+    UE_LOG(LogTemp, Log, TEXT("MazeGridData: Imported %dx%d grid (%d floors) from %s"),
+        SizeX, SizeY, DerivedData.FloorCount, *ImageFile.FilePath);
+}
+
+void UMazeGridData::ExportToImage()
+{
+    FString Error;
+    if (!FMazeGridImageCodec::Export(*this, ImageFile.FilePath, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("MazeGridData: Export failed: %s"), *Error);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MazeGridData: Exported %dx%d grid to %s"), SizeX, SizeY, *ImageFile.FilePath);
+}
+#endif
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "MazeTypes.h"
+#include "MazeDerivedData.h"
 #include "MazeGridData.generated.h"
 
 /*=============================================================================
@@ -93,6 +94,53 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze Grid")
     TArray<FMazeCell> Cells;
 
+    //=========================================================================
+    // MARKERS ((-1,-1) = not set)
+    //=========================================================================
+
+    /** Where the player starts */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze Grid|Markers")
+    FIntPoint SpawnCell = FIntPoint(-1, -1);
+
+    /** Where the exit should go */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze Grid|Markers")
+    FIntPoint ExitCell = FIntPoint(-1, -1);
+
+    /** Where the key should go */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze Grid|Markers")
+    FIntPoint KeyCell = FIntPoint(-1, -1);
+
+    //=========================================================================
+    // CONSISTENCY
+    //=========================================================================
+
+    /**
+     * Grid hash when the level geometry was last baked or painted from this
+     * asset (0 = never). If Cells change without a re-bake (image import,
+     * hand edits) the level and the data no longer agree.
+     */
+    UPROPERTY(VisibleAnywhere, Category = "Maze Grid|Consistency")
+    uint64 BakedGridHash = 0;
+
+#if WITH_EDITORONLY_DATA
+    //=========================================================================
+    // IMAGE IMPORT / EXPORT (editor only)
+    //=========================================================================
+
+    /**
+     * Image to import from / export to.
+     * .png / .pgm = 8-bit, .pbm = 1-bit, .raw = headerless 8-bit.
+     * See FMazeGridImageCodec for the pixel values.
+     */
+    UPROPERTY(EditAnywhere, Category = "Maze Grid|Image",
+        meta = (FilePathFilter = "Maze images (*.png;*.pgm;*.pbm;*.raw)|*.png;*.pgm;*.pbm;*.raw"))
+    FFilePath ImageFile;
+
+    /** Width and height of a headerless .raw image */
+    UPROPERTY(EditAnywhere, Category = "Maze Grid|Image")
+    FIntPoint RawImageSize = FIntPoint::ZeroValue;
+#endif
+
     //=========================================================================
     // UTILITY
     //=========================================================================
@@ -122,4 +170,106 @@ public:
     {
         return Cells.Num() - GetFloorCount();
     }
+
+    //=========================================================================
+    // DERIVED DATA (rebuilt on load, never saved)
+    //=========================================================================
+
+    /**
+     * Topology and clearance for every cell.
+     * Built on first use, or when the grid size changed. Editing Cells in
+     * place is not detected: PaintCells keeps this current, anything else
+     * must call RebuildDerivedData.
+     */
+    const FMazeDerivedData& GetDerivedData() const;
+
+    /** Recompute derived data now. Call after editing Cells. */
+    void RebuildDerivedData();
+
+    /** Topology of a single cell */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze Grid")
+    EMazeCellTopology GetCellTopology(FIntPoint Cell) const
+    {
+        return GetDerivedData().GetTopology(Cell);
+    }
+
+    /** Distance (cells) from a floor cell to the nearest wall */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze Grid")
+    int32 GetCellClearance(FIntPoint Cell) const
+    {
+        return GetDerivedData().GetClearance(Cell);
+    }
+
+    /** Connected region of a floor cell (INDEX_NONE for walls) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze Grid")
+    int32 GetCellComponent(FIntPoint Cell) const
+    {
+        return GetDerivedData().GetComponent(Cell);
+    }
+
+    /** Number of separate walkable regions (1 for a fully connected maze) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze Grid")
+    int32 GetComponentCount() const
+    {
+        return GetDerivedData().NumComponents;
+    }
+
+    //=========================================================================
+    // GRID HASH (see FMazeGridHash)
+    //=========================================================================
+
+    /**
+     * 64-bit Zobrist hash of size + floor/wall layout.
+     * Computed once on load, updated in O(1) per painted cell.
+     * Use it as a cache key, or compare it with UMazePathfinder::GetGridHash.
+     */
+    uint64 GetGridHash() const;
+
+    /** Grid hash as 16 hex digits */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze Grid")
+    FString GetGridHashString() const;
+
+    /** Does the baked level geometry match Cells? (true if never baked) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze Grid")
+    bool IsBakeConsistent() const
+    {
+        return BakedGridHash == 0 || BakedGridHash == GetGridHash();
+    }
+
+    //=========================================================================
+    // EDITING
+    //=========================================================================
+
+    /**
+     * Turn cells into floor or wall and refresh derived data for just the
+     * affected area (see FMazeDerivedData::RefreshCells).
+     * 
+     * @param InCells - Cells to paint (out of bounds ones are ignored)
+     * @param bFloor - True = floor, false = wall
+     * @param OutChanged - Optional: receives the cells that actually flipped
+     * @return Number of cells that flipped
+     */
+    int32 PaintCells(TArrayView<const FIntPoint> InCells, bool bFloor, TArray<FIntPoint>* OutChanged = nullptr);
+
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    /** Replace this grid with the contents of ImageFile */
+    UFUNCTION(CallInEditor, Category = "Maze Grid|Image")
+    void ImportFromImage();
+
+    /** Write this grid to ImageFile */
+    UFUNCTION(CallInEditor, Category = "Maze Grid|Image")
+    void ExportToImage();
+#endif
+
+private:
+    /** The image codec fills Cells and DerivedData in one streaming pass */
+    friend struct FMazeGridImageCodec;
+
+    /** Cached analysis of Cells (mutable: lazily built from const getters) */
+    mutable FMazeDerivedData DerivedData;
+
+    /** Hash of Cells, kept in step with DerivedData (never saved) */
+    mutable uint64 GridHash = 0;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeGridHash.h"
+#include "MazeTypes.h"
+
+namespace MazeGridHash
+{
+    /**
+     * XOR of CellKey(i) over every floor cell.
+     *
+     * Branch-free (floor state becomes an all-ones / all-zeros mask) with
+     * four independent accumulators, so the four mixer chains overlap in the
+     * pipeline and the compiler is free to vectorize. UE's portable vector
+     * registers have no 64-bit multiply, so there is no hand-written SIMD here.
+     */
+    template <typename IsFloorFn>
+    uint64 XorFloorKeys(int32 Num, IsFloorFn IsFloor)
+    {
+        uint64 Acc0 = 0;
+        uint64 Acc1 = 0;
+        uint64 Acc2 = 0;
+        uint64 Acc3 = 0;
+
+        int32 i = 0;
+        for (; i + 4 <= Num; i += 4)
+        {
+            Acc0 ^= FMazeGridHash::CellKey(i + 0) & (0ull - static_cast<uint64>(IsFloor(i + 0)));
+            Acc1 ^= FMazeGridHash::CellKey(i + 1) & (0ull - static_cast<uint64>(IsFloor(i + 1)));
+            Acc2 ^= FMazeGridHash::CellKey(i + 2) & (0ull - static_cast<uint64>(IsFloor(i + 2)));
+            Acc3 ^= FMazeGridHash::CellKey(i + 3) & (0ull - static_cast<uint64>(IsFloor(i + 3)));
+        }
+
+        for (; i < Num; ++i)
+        {
+            Acc0 ^= FMazeGridHash::CellKey(i) & (0ull - static_cast<uint64>(IsFloor(i)));
+        }
+
+        return Acc0 ^ Acc1 ^ Acc2 ^ Acc3;
+    }
+}
+
+uint64 FMazeGridHash::Compute(TArrayView<const FMazeCell> Cells, FIntPoint Size)
+{
+    if (Size.X <= 0 || Size.Y <= 0 || Cells.Num() != Size.X * Size.Y)
+    {
+        return 0;
+    }
+
+    const FMazeCell* Data = Cells.GetData();
+    return SizeKey(Size) ^ MazeGridHash::XorFloorKeys(Cells.Num(),
+        [Data](int32 Index) { return Data[Index].bIsFloor ? 1u : 0u; });
+}
+
+uint64 FMazeGridHash::Compute(TArrayView<const uint8> Walkable, FIntPoint Size)
+{
+    if (Size.X <= 0 || Size.Y <= 0 || Walkable.Num() != Size.X * Size.Y)
+    {
+        return 0;
+    }
+
+    const uint8* Data = Walkable.GetData();
+    return SizeKey(Size) ^ MazeGridHash::XorFloorKeys(Walkable.Num(),
+        [Data](int32 Index) { return Data[Index] != 0 ? 1u : 0u; });
+}
@@ -0,0 +1,78 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    ZOBRIST HASHING:
+        - Every cell gets a fixed random 64-bit key
+        - Grid hash = XOR of the keys of all floor cells (plus a size key)
+        - XOR is its own inverse, so flipping one cell is one XOR: O(1)
+        - Undoing an edit gives back exactly the old hash
+
+    SPLITMIX64:
+        - Tiny integer mixer (add, shift-xor, multiply)
+        - Used to derive cell keys from the cell index on the fly, so there
+          is no key table to store, load or keep in sync between machines
+=============================================================================*/
+
+struct FMazeCell;
+
+/**
+ * 64-bit Zobrist hash of a maze grid's floor/wall layout.
+ *
+ * The same grid hashes to the same value everywhere: in UMazeGridData
+ * (asset), in UMazePathfinder (runtime grid), on server and client, across
+ * platforms. Only size and floor/wall state count; markers, cell size and
+ * world positions do not.
+ *
+ * Two grids with equal hashes are identical for every practical purpose
+ * (collision odds ~1 in 2^64), so the hash works as a cache key and as a
+ * cheap "are we looking at the same maze?" check.
+ */
+struct THELASTMASK_API FMazeGridHash
+{
+    /** Key of a floor cell at a flat index */
+    static FORCEINLINE uint64 CellKey(int32 Index)
+    {
+        return Mix(static_cast<uint64>(static_cast<uint32>(Index)) ^ 0x6D617A6563656C6Cull);
+    }
+
+    /** Key of the grid dimensions (so a 10x20 and a 20x10 grid differ) */
+    static FORCEINLINE uint64 SizeKey(FIntPoint Size)
+    {
+        const uint64 Packed = (static_cast<uint64>(static_cast<uint32>(Size.X)) << 32) | static_cast<uint32>(Size.Y);
+        return Mix(Packed ^ 0x6D617A6573697A65ull);
+    }
+
+    /** Hash after flipping one cell (floor <-> wall) */
+    static FORCEINLINE uint64 Toggle(uint64 Hash, int32 Index)
+    {
+        return Hash ^ CellKey(Index);
+    }
+
+    /** Hash a grid of cells in one pass (0 if Cells doesn't match Size) */
+    static uint64 Compute(TArrayView<const FMazeCell> Cells, FIntPoint Size);
+
+    /** Hash a grid of walkable flags (non-zero = floor) in one pass */
+    static uint64 Compute(TArrayView<const uint8> Walkable, FIntPoint Size);
+
+    /** 16 hex digits, for logs and Blueprints (which have no uint64) */
+    static FString ToString(uint64 Hash)
+    {
+        return FString::Printf(TEXT("%016llx"), Hash);
+    }
+
+private:
+    /** SplitMix64 finalizer */
+    static FORCEINLINE uint64 Mix(uint64 Value)
+    {
+        Value += 0x9E3779B97F4A7C15ull;
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+};
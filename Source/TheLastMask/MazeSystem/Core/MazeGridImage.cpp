@@ -0,0 +1,526 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeGridImage.h"
+#include "MazeGridData.h"
+#include "MazeGridHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+
+namespace MazeImage
+{
+    /** Largest accepted side. 8192^2 cells is the large-maze tier. */
+    constexpr int32 MaxSide = 8192;
+
+    bool ReadByte(FArchive& Ar, uint8& OutByte)
+    {
+        if (Ar.AtEnd())
+        {
+            return false;
+        }
+        Ar.Serialize(&OutByte, 1);
+        return !Ar.IsError();
+    }
+
+    /**
+     * Read one whitespace-separated netpbm header token, skipping # comments.
+     * Consumes exactly one whitespace byte after the token, which is what the
+     * format requires between the last header field and the pixel data.
+     */
+    bool ReadHeaderToken(FArchive& Ar, FString& OutToken)
+    {
+        OutToken.Reset();
+        uint8 Char = 0;
+
+        while (true)
+        {
+            if (!ReadByte(Ar, Char))
+            {
+                return false;
+            }
+
+            if (Char == '#')
+            {
+                while (ReadByte(Ar, Char) && Char != '\n')
+                {
+                }
+                continue;
+            }
+
+            if (!FChar::IsWhitespace(static_cast<TCHAR>(Char)))
+            {
+                break;
+            }
+        }
+
+        do
+        {
+            OutToken.AppendChar(static_cast<TCHAR>(Char));
+            if (!ReadByte(Ar, Char))
+            {
+                break;
+            }
+        }
+        while (!FChar::IsWhitespace(static_cast<TCHAR>(Char)));
+
+        return true;
+    }
+
+    bool IsValidSize(int32 Width, int32 Height)
+    {
+        return Width > 0 && Height > 0 && Width <= MaxSide && Height <= MaxSide;
+    }
+}
+
+//=============================================================================
+// PUBLIC ENTRY POINTS
+//=============================================================================
+
+bool FMazeGridImageCodec::Import(UMazeGridData& Grid, const FString& Filename, FString& OutError, FIntPoint RawSize)
+{
+    const FString Extension = FPaths::GetExtension(Filename).ToLower();
+
+    if (Extension == TEXT("pgm") || Extension == TEXT("pbm"))
+    {
+        return ImportNetpbm(Grid, Filename, OutError);
+    }
+    if (Extension == TEXT("raw"))
+    {
+        return ImportRaw(Grid, Filename, RawSize, OutError);
+    }
+    if (Extension == TEXT("png"))
+    {
+        return ImportPng(Grid, Filename, OutError);
+    }
+
+    OutError = FString::Printf(TEXT("Unsupported image extension '%s'"), *Extension);
+    return false;
+}
+
+bool FMazeGridImageCodec::Export(const UMazeGridData& Grid, const FString& Filename, FString& OutError)
+{
+    if (!Grid.IsValid())
+    {
+        OutError = TEXT("Grid has no data");
+        return false;
+    }
+
+    const FString Extension = FPaths::GetExtension(Filename).ToLower();
+
+    if (Extension == TEXT("pgm"))
+    {
+        return ExportStreamed(Grid, Filename, /*bOneBit=*/ false, /*bHeader=*/ true, OutError);
+    }
+    if (Extension == TEXT("pbm"))
+    {
+        return ExportStreamed(Grid, Filename, /*bOneBit=*/ true, /*bHeader=*/ true, OutError);
+    }
+    if (Extension == TEXT("raw"))
+    {
+        return ExportStreamed(Grid, Filename, /*bOneBit=*/ false, /*bHeader=*/ false, OutError);
+    }
+    if (Extension == TEXT("png"))
+    {
+        return ExportPng(Grid, Filename, OutError);
+    }
+
+    OutError = FString::Printf(TEXT("Unsupported image extension '%s'"), *Extension);
+    return false;
+}
+
+//=============================================================================
+// ROW CONVERSION
+//=============================================================================
+
+void FMazeGridImageCodec::BeginImport(UMazeGridData& Grid, FIntPoint Size)
+{
+    Grid.SizeX = Size.X;
+    Grid.SizeY = Size.Y;
+    Grid.Seed = 0;
+    Grid.SpawnCell = FIntPoint(-1, -1);
+    Grid.ExitCell = FIntPoint(-1, -1);
+    Grid.KeyCell = FIntPoint(-1, -1);
+
+    // Empty() first so the old and new grid are never allocated together
+    Grid.Cells.Empty();
+    Grid.Cells.Reserve(Size.X * Size.Y);
+
+    Grid.DerivedData.BeginBuild(Size);
+}
+
+void FMazeGridImageCodec::ImportRow(UMazeGridData& Grid, int32 Y, const uint8* Pixels)
+{
+    const float CellSize = Grid.CellSize;
+
+    for (int32 X = 0; X < Grid.SizeX; ++X)
+    {
+        const uint8 Value = Pixels[X];
+        const bool bIsFloor = Value >= 128;
+
+        // Markers are floor either way. A value seen twice is ordinary art,
+        // not a marker: flag it (-2) and FinishImport clears it.
+        auto SetMarker = [X, Y](FIntPoint& Marker)
+        {
+            Marker = Marker.X == -1 ? FIntPoint(X, Y) : FIntPoint(-2, -2);
+        };
+
+        switch (Value)
+        {
+            case SpawnValue: SetMarker(Grid.SpawnCell); break;
+            case ExitValue:  SetMarker(Grid.ExitCell);  break;
+            case KeyValue:   SetMarker(Grid.KeyCell);   break;
+            default: break;
+        }
+
+        // Same world position convention as UMazeGenerator
+        const FVector WorldPos(X * CellSize + CellSize * 0.5f, Y * CellSize + CellSize * 0.5f, 0.0f);
+        Grid.Cells.Emplace(FIntPoint(X, Y), WorldPos, bIsFloor);
+    }
+
+    // Derived data follows the rows as they arrive
+    Grid.DerivedData.AddRow(Grid.Cells, Y);
+}
+
+void FMazeGridImageCodec::FinishImport(UMazeGridData& Grid)
+{
+    for (FIntPoint* Marker : { &Grid.SpawnCell, &Grid.ExitCell, &Grid.KeyCell })
+    {
+        if (Marker->X == -2)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MazeGridImage: A marker value appears more than once, marker left unset"));
+            *Marker = FIntPoint(-1, -1);
+        }
+    }
+
+    Grid.DerivedData.FinishBuild(Grid.Cells);
+    Grid.GridHash = FMazeGridHash::Compute(Grid.Cells, FIntPoint(Grid.SizeX, Grid.SizeY));
+}
+
+void FMazeGridImageCodec::ExportRow(const UMazeGridData& Grid, int32 Y, uint8* OutPixels)
+{
+    const int32 RowStart = Y * Grid.SizeX;
+    for (int32 X = 0; X < Grid.SizeX; ++X)
+    {
+        OutPixels[X] = Grid.Cells[RowStart + X].bIsFloor ? FloorValue : WallValue;
+    }
+
+    auto StampMarker = [Y, OutPixels, &Grid](const FIntPoint& Marker, uint8 Value)
+    {
+        if (Marker.Y == Y && Marker.X >= 0 && Marker.X < Grid.SizeX)
+        {
+            OutPixels[Marker.X] = Value;
+        }
+    };
+
+    StampMarker(Grid.SpawnCell, SpawnValue);
+    StampMarker(Grid.ExitCell, ExitValue);
+    StampMarker(Grid.KeyCell, KeyValue);
+}
+
+//=============================================================================
+// NETPBM / RAW (streamed)
+//=============================================================================
+
+bool FMazeGridImageCodec::ImportNetpbm(UMazeGridData& Grid, const FString& Filename, FString& OutError)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+    if (!Reader)
+    {
+        OutError = FString::Printf(TEXT("Cannot open %s"), *Filename);
+        return false;
+    }
+
+    FString Magic, WidthToken, HeightToken;
+    if (!MazeImage::ReadHeaderToken(*Reader, Magic) ||
+        !MazeImage::ReadHeaderToken(*Reader, WidthToken) ||
+        !MazeImage::ReadHeaderToken(*Reader, HeightToken))
+    {
+        OutError = TEXT("Truncated netpbm header");
+        return false;
+    }
+
+    const bool bOneBit = (Magic == TEXT("P4"));
+    if (!bOneBit && Magic != TEXT("P5"))
+    {
+        OutError = FString::Printf(TEXT("Unsupported netpbm type '%s' (need binary P4 or P5)"), *Magic);
+        return false;
+    }
+
+    int32 MaxValue = 1;
+    if (!bOneBit)
+    {
+        FString MaxToken;
+        if (!MazeImage::ReadHeaderToken(*Reader, MaxToken))
+        {
+            OutError = TEXT("Truncated netpbm header");
+            return false;
+        }
+        MaxValue = FCString::Atoi(*MaxToken);
+        if (MaxValue <= 0 || MaxValue > 255)
+        {
+            OutError = TEXT("Only 8-bit PGM files are supported");
+            return false;
+        }
+    }
+
+    const int32 Width = FCString::Atoi(*WidthToken);
+    const int32 Height = FCString::Atoi(*HeightToken);
+    if (!MazeImage::IsValidSize(Width, Height))
+    {
+        OutError = FString::Printf(TEXT("Invalid image size %dx%d"), Width, Height);
+        return false;
+    }
+
+    // Check the length before BeginImport touches the grid: a truncated
+    // file must leave the existing asset as it was
+    const int32 PackedRowBytes = bOneBit ? (Width + 7) / 8 : Width;
+    const int64 PixelBytes = static_cast<int64>(PackedRowBytes) * Height;
+    const int64 Remaining = Reader->TotalSize() - Reader->Tell();
+    if (Remaining < PixelBytes)
+    {
+        OutError = FString::Printf(TEXT("Truncated file: %lld pixel bytes, %dx%d needs %lld"),
+            Remaining, Width, Height, PixelBytes);
+        return false;
+    }
+
+    BeginImport(Grid, FIntPoint(Width, Height));
+
+    TArray<uint8> PackedRow;
+    PackedRow.SetNumUninitialized(PackedRowBytes);
+    TArray<uint8> Pixels;
+    Pixels.SetNumUninitialized(Width);
+
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        Reader->Serialize(PackedRow.GetData(), PackedRowBytes);
+        if (Reader->IsError())
+        {
+            // Length was checked up front, so this is an I/O failure
+            OutError = FString::Printf(TEXT("Read error at row %d"), Y);
+            Grid.Cells.Empty();
+            Grid.DerivedData.Reset();
+            return false;
+        }
+
+        if (bOneBit)
+        {
+            // PBM: MSB first, 1 = black = wall
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const bool bBlack = (PackedRow[X >> 3] >> (7 - (X & 7))) & 1;
+                Pixels[X] = bBlack ? WallValue : FloorValue;
+            }
+        }
+        else if (MaxValue == 255)
+        {
+            FMemory::Memcpy(Pixels.GetData(), PackedRow.GetData(), Width);
+        }
+        else
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                Pixels[X] = static_cast<uint8>(PackedRow[X] * 255 / MaxValue);
+            }
+        }
+
+        ImportRow(Grid, Y, Pixels.GetData());
+    }
+
+    FinishImport(Grid);
+    return true;
+}
+
+bool FMazeGridImageCodec::ImportRaw(UMazeGridData& Grid, const FString& Filename, FIntPoint RawSize, FString& OutError)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+    if (!Reader)
+    {
+        OutError = FString::Printf(TEXT("Cannot open %s"), *Filename);
+        return false;
+    }
+
+    // No header: size comes from the caller, or the file is assumed square
+    const int64 FileSize = Reader->TotalSize();
+    if (RawSize.X <= 0 || RawSize.Y <= 0)
+    {
+        const int32 Side = FMath::FloorToInt32(FMath::Sqrt(static_cast<double>(FileSize)));
+        RawSize = FIntPoint(Side, Side);
+    }
+
+    if (!MazeImage::IsValidSize(RawSize.X, RawSize.Y) || static_cast<int64>(RawSize.X) * RawSize.Y != FileSize)
+    {
+        OutError = FString::Printf(TEXT("Raw file is %lld bytes, which does not match %dx%d"),
+            FileSize, RawSize.X, RawSize.Y);
+        return false;
+    }
+
+    // Size matched the file above, so BeginImport only runs on a complete file
+    BeginImport(Grid, RawSize);
+
+    TArray<uint8> Pixels;
+    Pixels.SetNumUninitialized(RawSize.X);
+
+    for (int32 Y = 0; Y < RawSize.Y; ++Y)
+    {
+        Reader->Serialize(Pixels.GetData(), RawSize.X);
+        if (Reader->IsError())
+        {
+            OutError = FString::Printf(TEXT("Read error at row %d"), Y);
+            Grid.Cells.Empty();
+            Grid.DerivedData.Reset();
+            return false;
+        }
+
+        ImportRow(Grid, Y, Pixels.GetData());
+    }
+
+    FinishImport(Grid);
+    return true;
+}
+
+bool FMazeGridImageCodec::ExportStreamed(const UMazeGridData& Grid, const FString& Filename, bool bOneBit, bool bHeader, FString& OutError)
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+    if (!Writer)
+    {
+        OutError = FString::Printf(TEXT("Cannot write %s"), *Filename);
+        return false;
+    }
+
+    if (bHeader)
+    {
+        const FString Header = bOneBit
+            ? FString::Printf(TEXT("P4\n# The Last Mask maze (1 = wall)\n%d %d\n"), Grid.SizeX, Grid.SizeY)
+            : FString::Printf(TEXT("P5\n# The Last Mask maze (0 wall, 255 floor, 251 spawn, 252 exit, 253 key)\n%d %d\n255\n"),
+                Grid.SizeX, Grid.SizeY);
+
+        FTCHARToUTF8 HeaderUtf8(*Header);
+        Writer->Serialize(const_cast<ANSICHAR*>(HeaderUtf8.Get()), HeaderUtf8.Length());
+    }
+
+    TArray<uint8> Pixels;
+    Pixels.SetNumUninitialized(Grid.SizeX);
+    TArray<uint8> PackedRow;
+    PackedRow.SetNumUninitialized((Grid.SizeX + 7) / 8);
+
+    for (int32 Y = 0; Y < Grid.SizeY; ++Y)
+    {
+        ExportRow(Grid, Y, Pixels.GetData());
+
+        if (bOneBit)
+        {
+            FMemory::Memzero(PackedRow.GetData(), PackedRow.Num());
+            for (int32 X = 0; X < Grid.SizeX; ++X)
+            {
+                if (Pixels[X] == WallValue)
+                {
+                    PackedRow[X >> 3] |= static_cast<uint8>(0x80 >> (X & 7));
+                }
+            }
+            Writer->Serialize(PackedRow.GetData(), PackedRow.Num());
+        }
+        else
+        {
+            Writer->Serialize(Pixels.GetData(), Pixels.Num());
+        }
+    }
+
+    if (!Writer->Close())
+    {
+        OutError = FString::Printf(TEXT("Failed while writing %s"), *Filename);
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+// PNG (engine codec, whole image)
+//=============================================================================
+
+bool FMazeGridImageCodec::ImportPng(UMazeGridData& Grid, const FString& Filename, FString& OutError)
+{
+    IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+    TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+
+    TArray64<uint8> GrayPlane;
+    {
+        // Scoped so the compressed file is freed before rows are converted
+        TArray<uint8> Compressed;
+        if (!FFileHelper::LoadFileToArray(Compressed, *Filename))
+        {
+            OutError = FString::Printf(TEXT("Cannot open %s"), *Filename);
+            return false;
+        }
+
+        if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Compressed.GetData(), Compressed.Num()))
+        {
+            OutError = TEXT("Not a valid PNG file");
+            return false;
+        }
+
+        // 1-bit and 8-bit gray (and color) PNGs all come out as 8-bit gray
+        if (!ImageWrapper->GetRaw(ERGBFormat::Gray, 8, GrayPlane))
+        {
+            OutError = TEXT("PNG decode failed");
+            return false;
+        }
+    }
+
+    const int32 Width = static_cast<int32>(ImageWrapper->GetWidth());
+    const int32 Height = static_cast<int32>(ImageWrapper->GetHeight());
+    ImageWrapper.Reset();
+
+    if (!MazeImage::IsValidSize(Width, Height) || GrayPlane.Num() != static_cast<int64>(Width) * Height)
+    {
+        OutError = FString::Printf(TEXT("Invalid image size %dx%d"), Width, Height);
+        return false;
+    }
+
+    BeginImport(Grid, FIntPoint(Width, Height));
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        ImportRow(Grid, Y, GrayPlane.GetData() + static_cast<int64>(Y) * Width);
+    }
+    FinishImport(Grid);
+
+    return true;
+}
+
+bool FMazeGridImageCodec::ExportPng(const UMazeGridData& Grid, const FString& Filename, FString& OutError)
+{
+    IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+    TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+    if (!ImageWrapper.IsValid())
+    {
+        OutError = TEXT("PNG encoder unavailable");
+        return false;
+    }
+
+    // The engine encoder needs the whole plane: 1 byte per cell
+    TArray64<uint8> GrayPlane;
+    GrayPlane.SetNumUninitialized(static_cast<int64>(Grid.SizeX) * Grid.SizeY);
+    for (int32 Y = 0; Y < Grid.SizeY; ++Y)
+    {
+        ExportRow(Grid, Y, GrayPlane.GetData() + static_cast<int64>(Y) * Grid.SizeX);
+    }
+
+    if (!ImageWrapper->SetRaw(GrayPlane.GetData(), GrayPlane.Num(), Grid.SizeX, Grid.SizeY, ERGBFormat::Gray, 8))
+    {
+        OutError = TEXT("PNG encode failed");
+        return false;
+    }
+    GrayPlane.Empty();
+
+    const TArray64<uint8>& Compressed = ImageWrapper->GetCompressed();
+    if (!FFileHelper::SaveArrayToFile(Compressed, *Filename))
+    {
+        OutError = FString::Printf(TEXT("Cannot write %s"), *Filename);
+        return false;
+    }
+
+    return true;
+}
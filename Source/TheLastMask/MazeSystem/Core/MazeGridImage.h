@@ -0,0 +1,89 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    FArchive (from IFileManager::CreateFileReader / CreateFileWriter):
+        - UE's binary stream; Serialize(Ptr, Num) reads or writes raw bytes
+        - Reading one row at a time keeps memory flat no matter the file size
+
+    IImageWrapper:
+        - Engine PNG/JPG/EXR codec (module "ImageWrapper")
+        - SetCompressed + GetRaw decodes, SetRaw + GetCompressed encodes
+        - Works on whole images only (no row callbacks)
+
+    NETPBM (.pgm / .pbm):
+        - Tiny text header ("P5 <W> <H> 255") followed by raw pixel rows
+        - Opens in GIMP, Krita, Photoshop (plugin) and most image tools
+=============================================================================*/
+
+class UMazeGridData;
+
+/**
+ * Image import/export for maze grids.
+ *
+ * PIXEL VALUES (8-bit formats):
+ *      0 = wall          255 = floor
+ *    251 = spawn         252 = exit          253 = key
+ *   Any other value: >= 128 floor, else wall (markers are floor too).
+ *   Marker values sit off the usual gray levels, and one that appears more
+ *   than once is read as plain floor, so painted art never moves a marker.
+ *   1-bit .pbm stores floor/wall only (1 = black = wall, as PBM defines it).
+ *
+ * STREAMING:
+ *   .pgm, .pbm and .raw are read and written one row at a time: the file is
+ *   never held in memory, only a single row buffer. Cells and derived data
+ *   (topology, clearance) are filled in the same pass.
+ *   .png goes through the engine codec, which decodes the whole image; only
+ *   its 8-bit gray plane (1 byte per cell) is kept while rows are converted.
+ */
+struct THELASTMASK_API FMazeGridImageCodec
+{
+    static constexpr uint8 WallValue = 0;
+    static constexpr uint8 SpawnValue = 251;
+    static constexpr uint8 ExitValue = 252;
+    static constexpr uint8 KeyValue = 253;
+    static constexpr uint8 FloorValue = 255;
+
+    /**
+     * Replace a grid with the contents of an image.
+     *
+     * @param Grid - Grid to overwrite (size, cells, markers, derived data)
+     * @param Filename - .png, .pgm, .pbm or .raw
+     * @param OutError - Reason on failure
+     * @param RawSize - Width/height for headerless .raw (zero = assume square)
+     * @return True on success. Bad headers and truncated files are refused
+     *         before Grid is touched; only an I/O error mid-read empties it.
+     */
+    static bool Import(UMazeGridData& Grid, const FString& Filename, FString& OutError,
+        FIntPoint RawSize = FIntPoint::ZeroValue);
+
+    /**
+     * Write a grid to an image. Format is picked from the extension.
+     */
+    static bool Export(const UMazeGridData& Grid, const FString& Filename, FString& OutError);
+
+private:
+    static bool ImportNetpbm(UMazeGridData& Grid, const FString& Filename, FString& OutError);
+    static bool ImportRaw(UMazeGridData& Grid, const FString& Filename, FIntPoint RawSize, FString& OutError);
+    static bool ImportPng(UMazeGridData& Grid, const FString& Filename, FString& OutError);
+
+    static bool ExportStreamed(const UMazeGridData& Grid, const FString& Filename, bool bOneBit, bool bHeader, FString& OutError);
+    static bool ExportPng(const UMazeGridData& Grid, const FString& Filename, FString& OutError);
+
+    /** Reset the grid for a Width x Height import */
+    static void BeginImport(UMazeGridData& Grid, FIntPoint Size);
+
+    /** Append one row of 8-bit pixel values */
+    static void ImportRow(UMazeGridData& Grid, int32 Y, const uint8* Pixels);
+
+    /** Finalize derived data once every row is in */
+    static void FinishImport(UMazeGridData& Grid);
+
+    /** Encode one grid row to 8-bit pixel values */
+    static void ExportRow(const UMazeGridData& Grid, int32 Y, uint8* OutPixels);
+};
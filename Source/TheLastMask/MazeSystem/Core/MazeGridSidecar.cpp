@@ -0,0 +1,225 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeGridSidecar.h"
+#include "MazeGridData.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+    int64 AlignPlane(int64 Offset)
+    {
+        return Align(Offset, FMazeGridSidecar::PlaneAlignment);
+    }
+
+    /** Write zeros up to Offset */
+    void PadTo(FArchive& Ar, int64 Offset)
+    {
+        static const uint8 Zeros[4096] = {};
+        while (Ar.Tell() < Offset)
+        {
+            const int64 Num = FMath::Min<int64>(Offset - Ar.Tell(), sizeof(Zeros));
+            Ar.Serialize(const_cast<uint8*>(Zeros), Num);
+        }
+    }
+}
+
+FMazeGridSidecar::FMazeGridSidecar() = default;
+
+FMazeGridSidecar::~FMazeGridSidecar()
+{
+    Close();
+}
+
+FString FMazeGridSidecar::GetPathFor(const UMazeGridData& GridData)
+{
+    return FPackageName::LongPackageNameToFilename(GridData.GetPackage()->GetName(), TEXT(".mazeplanes"));
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool FMazeGridSidecar::Write(const FString& Filename, FIntPoint Size, uint64 GridHash,
+    TArrayView<const uint8> Walkable, TArrayView<const FIntPoint> Landmarks,
+    TArrayView<const uint16> LandmarkDistances, FString& OutError)
+{
+    const int64 NumCells = static_cast<int64>(Size.X) * Size.Y;
+    if (Size.X <= 0 || Size.Y <= 0 || Walkable.Num() != NumCells)
+    {
+        OutError = FString::Printf(TEXT("Walkable plane has %d cells, expected %dx%d"), Walkable.Num(), Size.X, Size.Y);
+        return false;
+    }
+
+    if (LandmarkDistances.Num() != NumCells * Landmarks.Num())
+    {
+        OutError = FString::Printf(TEXT("Landmark plane has %d values, expected %lld"),
+            LandmarkDistances.Num(), NumCells * Landmarks.Num());
+        return false;
+    }
+
+    FHeader Header;
+    FMemory::Memzero(Header);
+    Header.Magic = Magic;
+    Header.Version = Version;
+    Header.SizeX = Size.X;
+    Header.SizeY = Size.Y;
+    Header.GridHash = GridHash;
+    Header.NumLandmarks = Landmarks.Num();
+    Header.WalkableOffset = AlignPlane(LandmarkCellsOffset + Landmarks.Num() * 2 * sizeof(int32));
+    Header.LandmarkOffset = AlignPlane(Header.WalkableOffset + NumCells);
+    Header.FileSize = Header.LandmarkOffset + LandmarkDistances.Num() * sizeof(uint16);
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+    if (!Writer)
+    {
+        OutError = FString::Printf(TEXT("Cannot write %s"), *Filename);
+        return false;
+    }
+
+    Writer->Serialize(&Header, sizeof(Header));
+    for (const FIntPoint& Cell : Landmarks)
+    {
+        int32 XY[2] = { Cell.X, Cell.Y };
+        Writer->Serialize(XY, sizeof(XY));
+    }
+
+    PadTo(*Writer, Header.WalkableOffset);
+    Writer->Serialize(const_cast<uint8*>(Walkable.GetData()), Walkable.Num());
+
+    PadTo(*Writer, Header.LandmarkOffset);
+    Writer->Serialize(const_cast<uint16*>(LandmarkDistances.GetData()), LandmarkDistances.Num() * sizeof(uint16));
+
+    const bool bOk = !Writer->IsError() && Writer->Close();
+    if (!bOk)
+    {
+        OutError = FString::Printf(TEXT("Error while writing %s"), *Filename);
+    }
+    return bOk;
+}
+
+//=============================================================================
+// MAP
+//=============================================================================
+
+bool FMazeGridSidecar::Open(const FString& Filename, FString& OutError)
+{
+    Close();
+
+    Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+    if (!Handle)
+    {
+        OutError = FString::Printf(TEXT("Cannot map %s (missing, or packed compressed)"), *Filename);
+        return false;
+    }
+
+    const int64 FileSize = Handle->GetFileSize();
+    if (FileSize < static_cast<int64>(sizeof(FHeader)))
+    {
+        OutError = FString::Printf(TEXT("%s is too small to be a sidecar"), *Filename);
+        Close();
+        return false;
+    }
+
+    Region.Reset(Handle->MapRegion(0, FileSize));
+    if (!Region)
+    {
+        OutError = FString::Printf(TEXT("Cannot map %lld bytes of %s"), FileSize, *Filename);
+        Close();
+        return false;
+    }
+
+    // Only the header page is touched here; planes page in on first read
+    const FHeader* Mapped = reinterpret_cast<const FHeader*>(Region->GetMappedPtr());
+    const int64 NumCells = static_cast<int64>(Mapped->SizeX) * Mapped->SizeY;
+
+    if (Mapped->Magic != Magic || Mapped->Version != Version)
+    {
+        OutError = FString::Printf(TEXT("%s is not a version %u sidecar"), *Filename, Version);
+    }
+    else if (Mapped->SizeX <= 0 || Mapped->SizeY <= 0 || Mapped->NumLandmarks < 0 || Mapped->FileSize != FileSize)
+    {
+        OutError = FString::Printf(TEXT("%s has a corrupt header"), *Filename);
+    }
+    else if (Mapped->WalkableOffset < LandmarkCellsOffset + Mapped->NumLandmarks * 2 * static_cast<int64>(sizeof(int32)) ||
+        Mapped->LandmarkOffset < Mapped->WalkableOffset + NumCells ||
+        Mapped->LandmarkOffset + NumCells * Mapped->NumLandmarks * static_cast<int64>(sizeof(uint16)) > FileSize ||
+        Mapped->WalkableOffset % PlaneAlignment != 0 || Mapped->LandmarkOffset % PlaneAlignment != 0)
+    {
+        OutError = FString::Printf(TEXT("%s has planes outside the file"), *Filename);
+    }
+    else
+    {
+        Header = Mapped;
+        return true;
+    }
+
+    Close();
+    return false;
+}
+
+void FMazeGridSidecar::Close()
+{
+    Header = nullptr;
+
+    // The region must go before the handle that owns the mapping
+    Region.Reset();
+    Handle.Reset();
+}
+
+//=============================================================================
+// QUERIES
+//=============================================================================
+
+FIntPoint FMazeGridSidecar::GetSize() const
+{
+    return Header ? FIntPoint(Header->SizeX, Header->SizeY) : FIntPoint::ZeroValue;
+}
+
+uint64 FMazeGridSidecar::GetGridHash() const
+{
+    return Header ? Header->GridHash : 0;
+}
+
+int32 FMazeGridSidecar::GetNumLandmarks() const
+{
+    return Header ? Header->NumLandmarks : 0;
+}
+
+void FMazeGridSidecar::GetLandmarks(TArray<FIntPoint>& OutLandmarks) const
+{
+    OutLandmarks.Reset();
+    if (!Header)
+    {
+        return;
+    }
+
+    const int32* XY = reinterpret_cast<const int32*>(reinterpret_cast<const uint8*>(Header) + LandmarkCellsOffset);
+    for (int32 i = 0; i < Header->NumLandmarks; ++i)
+    {
+        OutLandmarks.Add(FIntPoint(XY[i * 2], XY[i * 2 + 1]));
+    }
+}
+
+TArrayView<const uint8> FMazeGridSidecar::GetWalkable() const
+{
+    if (!Header)
+    {
+        return TArrayView<const uint8>();
+    }
+
+    return TArrayView<const uint8>(reinterpret_cast<const uint8*>(Header) + Header->WalkableOffset, Header->SizeX * Header->SizeY);
+}
+
+TArrayView<const uint16> FMazeGridSidecar::GetLandmarkDistances() const
+{
+    if (!Header)
+    {
+        return TArrayView<const uint16>();
+    }
+
+    const uint8* Base = reinterpret_cast<const uint8*>(Header) + Header->LandmarkOffset;
+    return TArrayView<const uint16>(reinterpret_cast<const uint16*>(Base), Header->SizeX * Header->SizeY * Header->NumLandmarks);
+}
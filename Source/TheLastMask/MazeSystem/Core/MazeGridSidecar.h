@@ -0,0 +1,115 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    IMappedFileHandle / IMappedFileRegion (from IPlatformFile::OpenMapped):
+        - Memory-maps a file: its bytes appear at a pointer without being
+          read or copied
+        - The OS pages them in the first time they are touched, so opening
+          a 500 MB file costs the same as opening a 5 KB one
+        - Read only; unmapped when the region and handle are destroyed
+
+    Page alignment:
+        - Pages are 4 KB (64 KB allocation granularity on Windows)
+        - Starting every plane on a 64 KB boundary means touching one plane
+          never pages in the tail of another
+
+    Staging:
+        - The file sits next to the .uasset but is not an asset: add its
+          folder to "Additional Non-Asset Directories To Copy", and keep it
+          out of compressed pak files (a compressed entry cannot be mapped)
+=============================================================================*/
+
+class UMazeGridData;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Uncompressed grid planes stored next to a UMazeGridData asset
+ * ("<Asset>.mazeplanes"), for mazes too large to rebuild on load.
+ *
+ * LAYOUT (native endian):
+ *   Header, then landmark cells (int32 X, Y each)
+ *   Walkable plane: 1 byte per cell, 64 KB aligned
+ *   Landmark plane: uint16 per cell per landmark, cell-major, 64 KB aligned
+ *   (the same layout UMazePathfinder keeps in memory, so it reads in place)
+ *
+ * Write once from the editor (AMazeManager::WriteGridSidecar); at runtime
+ * Open maps the file and the pathfinder keeps the sidecar alive for as
+ * long as it reads from it.
+ */
+class THELASTMASK_API FMazeGridSidecar
+{
+public:
+    static constexpr uint32 Magic = 0x4D5A5043; // "MZPC"
+    static constexpr uint32 Version = 1;
+    static constexpr int64 PlaneAlignment = 64 * 1024;
+
+    FMazeGridSidecar();
+    ~FMazeGridSidecar();
+
+    /** "<Content path of the asset>.mazeplanes" */
+    static FString GetPathFor(const UMazeGridData& GridData);
+
+    /**
+     * Write the planes to disk.
+     *
+     * @param Walkable - 1 byte per cell, row-major
+     * @param Landmarks - Landmark cells (may be empty)
+     * @param LandmarkDistances - Cells * Landmarks.Num() values, cell-major
+     * @param OutError - Reason on failure
+     */
+    static bool Write(const FString& Filename, FIntPoint Size, uint64 GridHash,
+        TArrayView<const uint8> Walkable, TArrayView<const FIntPoint> Landmarks,
+        TArrayView<const uint16> LandmarkDistances, FString& OutError);
+
+    /** Map a sidecar file. Validates the header, touches no plane data. */
+    bool Open(const FString& Filename, FString& OutError);
+
+    /** Unmap (views handed out before become invalid) */
+    void Close();
+
+    bool IsOpen() const { return Header != nullptr; }
+
+    FIntPoint GetSize() const;
+    uint64 GetGridHash() const;
+    int32 GetNumLandmarks() const;
+
+    /** Landmark cells, copied out (a handful of values) */
+    void GetLandmarks(TArray<FIntPoint>& OutLandmarks) const;
+
+    /** Walkable plane, in place */
+    TArrayView<const uint8> GetWalkable() const;
+
+    /** Landmark distances, in place */
+    TArrayView<const uint16> GetLandmarkDistances() const;
+
+private:
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        int32 SizeX;
+        int32 SizeY;
+        uint64 GridHash;
+        int32 NumLandmarks;
+        int32 Reserved;
+        int64 WalkableOffset;
+        int64 LandmarkOffset;
+        int64 FileSize;
+    };
+
+    /** Landmark cells start right after the header */
+    static constexpr int64 LandmarkCellsOffset = sizeof(FHeader);
+
+    TUniquePtr<IMappedFileHandle> Handle;
+    TUniquePtr<IMappedFileRegion> Region;
+
+    /** Start of the mapping, null when closed */
+    const FHeader* Header = nullptr;
+};
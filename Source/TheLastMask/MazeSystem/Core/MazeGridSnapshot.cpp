@@ -0,0 +1,208 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeGridSnapshot.h"
+#include "Misc/ScopeLock.h"
+
+//=============================================================================
+// FMazeGridVersion
+//=============================================================================
+
+bool FMazeGridVersion::BuildDistanceField(TArrayView<const FIntPoint> Sources, TArray<int32>& OutDistances) const
+{
+    const int32 NumCells = Size.X * Size.Y;
+    OutDistances.Init(INDEX_NONE, NumCells);
+
+    TArray<int32> Queue;
+    Queue.Reserve(NumCells);
+
+    for (const FIntPoint& Source : Sources)
+    {
+        if (IsWalkable(Source))
+        {
+            const int32 Index = Source.Y * Size.X + Source.X;
+            if (OutDistances[Index] == INDEX_NONE)
+            {
+                OutDistances[Index] = 0;
+                Queue.Add(Index);
+            }
+        }
+    }
+
+    if (Queue.Num() == 0)
+    {
+        return false;
+    }
+
+    const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+    for (int32 Head = 0; Head < Queue.Num(); ++Head)
+    {
+        const int32 Index = Queue[Head];
+        const FIntPoint Cell(Index % Size.X, Index / Size.X);
+        const int32 NextDistance = OutDistances[Index] + 1;
+
+        for (const FIntPoint& Offset : Offsets)
+        {
+            const FIntPoint Neighbor = Cell + Offset;
+            if (IsWalkable(Neighbor))
+            {
+                const int32 NeighborIndex = Neighbor.Y * Size.X + Neighbor.X;
+                if (OutDistances[NeighborIndex] == INDEX_NONE)
+                {
+                    OutDistances[NeighborIndex] = NextDistance;
+                    Queue.Add(NeighborIndex);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================
+// FMazeGridVersionStore
+//=============================================================================
+
+FMazeGridVersionStore::~FMazeGridVersionStore()
+{
+    Reset();
+}
+
+void FMazeGridVersionStore::Initialize(TArrayView<const uint8> Walkable, FIntPoint Size, uint64 GridHash)
+{
+    FScopeLock Lock(&WriterLock);
+
+    if (Size.X <= 0 || Size.Y <= 0 || Walkable.Num() != Size.X * Size.Y)
+    {
+        Install(nullptr);
+        return;
+    }
+
+    FMazeGridVersion* NewVersion = new FMazeGridVersion();
+    NewVersion->Version = 1;
+    NewVersion->GridHash = GridHash;
+    NewVersion->Size = Size;
+    NewVersion->PageCount = FIntPoint((Size.X + FMazeGridPage::Mask) >> FMazeGridPage::Shift,
+        (Size.Y + FMazeGridPage::Mask) >> FMazeGridPage::Shift);
+    NewVersion->Pages.SetNum(NewVersion->PageCount.X * NewVersion->PageCount.Y);
+
+    for (int32 PageY = 0; PageY < NewVersion->PageCount.Y; ++PageY)
+    {
+        for (int32 PageX = 0; PageX < NewVersion->PageCount.X; ++PageX)
+        {
+            FMazeGridPage* Page = new FMazeGridPage();
+            FMemory::Memzero(Page->Cells, sizeof(Page->Cells));
+
+            // Copy the page's rows (edge pages are partly outside the grid)
+            const int32 StartX = PageX << FMazeGridPage::Shift;
+            const int32 StartY = PageY << FMazeGridPage::Shift;
+            const int32 Width = FMath::Min(FMazeGridPage::Size, Size.X - StartX);
+            const int32 Height = FMath::Min(FMazeGridPage::Size, Size.Y - StartY);
+
+            for (int32 Row = 0; Row < Height; ++Row)
+            {
+                FMemory::Memcpy(&Page->Cells[Row << FMazeGridPage::Shift],
+                    &Walkable[(StartY + Row) * Size.X + StartX], Width);
+            }
+
+            NewVersion->Pages[PageY * NewVersion->PageCount.X + PageX] = Page;
+        }
+    }
+
+    Install(NewVersion);
+}
+
+uint64 FMazeGridVersionStore::Publish(TArrayView<const FIntPoint> ChangedCells, TFunctionRef<uint8(int32)> ReadCell, uint64 GridHash)
+{
+    FScopeLock Lock(&WriterLock);
+
+    const FMazeGridVersion* Previous = CurrentOwner.GetReference();
+    if (!Previous)
+    {
+        return 0;
+    }
+
+    // New version: same page pointers, so untouched pages are shared
+    FMazeGridVersion* NewVersion = new FMazeGridVersion();
+    NewVersion->Version = Previous->Version + 1;
+    NewVersion->GridHash = GridHash;
+    NewVersion->Size = Previous->Size;
+    NewVersion->PageCount = Previous->PageCount;
+    NewVersion->Pages = Previous->Pages;
+
+    // Pages copied for this version (at most one copy per page)
+    TArray<int32, TInlineAllocator<16>> CopiedPages;
+
+    for (const FIntPoint& Cell : ChangedCells)
+    {
+        if (Cell.X < 0 || Cell.X >= NewVersion->Size.X || Cell.Y < 0 || Cell.Y >= NewVersion->Size.Y)
+        {
+            continue;
+        }
+
+        const int32 PageIndex = (Cell.Y >> FMazeGridPage::Shift) * NewVersion->PageCount.X + (Cell.X >> FMazeGridPage::Shift);
+        if (!CopiedPages.Contains(PageIndex))
+        {
+            FMazeGridPage* Copy = new FMazeGridPage();
+            FMemory::Memcpy(Copy->Cells, NewVersion->Pages[PageIndex]->Cells, sizeof(Copy->Cells));
+            NewVersion->Pages[PageIndex] = Copy;
+            CopiedPages.Add(PageIndex);
+        }
+
+        NewVersion->Pages[PageIndex]->Cells[((Cell.Y & FMazeGridPage::Mask) << FMazeGridPage::Shift) | (Cell.X & FMazeGridPage::Mask)] =
+            ReadCell(Cell.Y * NewVersion->Size.X + Cell.X);
+    }
+
+    const uint64 NewVersionNumber = NewVersion->Version;
+    Install(NewVersion);
+    return NewVersionNumber;
+}
+
+FMazeGridSnapshot FMazeGridVersionStore::Acquire() const
+{
+    // Announce first, so a writer knows someone may still grab the old pointer
+    AcquiringReaders.fetch_add(1);
+    FMazeGridSnapshot Snapshot(Current.load());
+    AcquiringReaders.fetch_sub(1);
+    return Snapshot;
+}
+
+uint64 FMazeGridVersionStore::GetVersion() const
+{
+    const FMazeGridSnapshot Snapshot = Acquire();
+    return Snapshot ? Snapshot->Version : 0;
+}
+
+void FMazeGridVersionStore::Reset()
+{
+    FScopeLock Lock(&WriterLock);
+    Install(nullptr);
+}
+
+void FMazeGridVersionStore::Install(FMazeGridVersion* NewVersion)
+{
+    if (CurrentOwner)
+    {
+        Retired.Add(MoveTemp(CurrentOwner));
+    }
+
+    CurrentOwner = NewVersion;
+    Current.store(NewVersion);
+
+    ReclaimRetired();
+}
+
+void FMazeGridVersionStore::ReclaimRetired()
+{
+    /*
+        Current no longer points at anything in Retired. A reader that
+        starts acquiring from now on gets the new version, so once nobody
+        is mid-acquire, every old version has all the references it will
+        ever get and the store can let go of its own. Readers still holding
+        one delete it when they are done.
+    */
+    if (Retired.Num() > 0 && AcquiringReaders.load() == 0)
+    {
+        Retired.Reset();
+    }
+}
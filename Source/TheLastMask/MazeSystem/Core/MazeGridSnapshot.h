@@ -0,0 +1,164 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/RefCounting.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    FRefCountBase + TRefCountPtr:
+        - Intrusive, thread-safe reference counting (the count lives in the
+          object, updated with atomics)
+        - The object deletes itself when the last TRefCountPtr lets go,
+          on whichever thread that happens to be
+
+    std::atomic:
+        - Reads and writes that other threads see whole, never half-done
+        - Used for the "current version" pointer readers pick up
+
+    COPY-ON-WRITE PAGES:
+        - The grid is split into 64x64 pages (4 KB each)
+        - A new version shares every page with the previous one except
+          the pages it edits, which are copied first
+        - Published pages are never written again, so readers need no locks
+=============================================================================*/
+
+/**
+ * 64x64 cells of walkability (1 = floor). Immutable once published.
+ */
+class THELASTMASK_API FMazeGridPage : public FRefCountBase
+{
+public:
+    static constexpr int32 Shift = 6;
+    static constexpr int32 Size = 1 << Shift;
+    static constexpr int32 Mask = Size - 1;
+
+    uint8 Cells[Size * Size];
+};
+
+/**
+ * One consistent version of the runtime grid.
+ *
+ * Hold it through a FMazeGridSnapshot for as long as a query runs: the
+ * cells never change underneath, whatever the game thread edits meanwhile.
+ */
+class THELASTMASK_API FMazeGridVersion : public FRefCountBase
+{
+public:
+    /** Increases by one per published edit batch */
+    uint64 Version = 0;
+
+    /** Zobrist hash of this version (see FMazeGridHash) */
+    uint64 GridHash = 0;
+
+    /** Grid dimensions in cells */
+    FIntPoint Size = FIntPoint::ZeroValue;
+
+    /** Pages along X and Y */
+    FIntPoint PageCount = FIntPoint::ZeroValue;
+
+    /** Row-major pages (shared with other versions) */
+    TArray<TRefCountPtr<FMazeGridPage>> Pages;
+
+    /** Is the cell floor? False out of bounds. */
+    bool IsWalkable(FIntPoint Cell) const
+    {
+        if (Cell.X < 0 || Cell.X >= Size.X || Cell.Y < 0 || Cell.Y >= Size.Y)
+        {
+            return false;
+        }
+
+        const FMazeGridPage& Page = *Pages[(Cell.Y >> FMazeGridPage::Shift) * PageCount.X + (Cell.X >> FMazeGridPage::Shift)];
+        return Page.Cells[((Cell.Y & FMazeGridPage::Mask) << FMazeGridPage::Shift) | (Cell.X & FMazeGridPage::Mask)] != 0;
+    }
+
+    /**
+     * Multi-source BFS on this version (same output as
+     * UMazePathfinder::BuildDistanceField). Safe on any thread.
+     */
+    bool BuildDistanceField(TArrayView<const FIntPoint> Sources, TArray<int32>& OutDistances) const;
+};
+
+/** A reader's reference to one grid version */
+using FMazeGridSnapshot = TRefCountPtr<const FMazeGridVersion>;
+
+/**
+ * Multi-version store for the runtime grid.
+ *
+ * READERS (any thread):
+ *   Acquire() returns the latest version without taking a lock. Work on
+ *   the snapshot, then drop it.
+ *
+ * WRITERS:
+ *   Publish() builds the next version from the current one, copying only
+ *   the pages the edit touches, then swaps it in. Writers serialize among
+ *   themselves, never with readers.
+ *
+ * RECLAIM:
+ *   A replaced version stays alive as long as any reader holds it and is
+ *   deleted by the last one to let go. The store drops its own reference
+ *   once no reader can still be in the middle of picking the old version
+ *   up (checked on every publish).
+ */
+class THELASTMASK_API FMazeGridVersionStore
+{
+public:
+    FMazeGridVersionStore() = default;
+    ~FMazeGridVersionStore();
+
+    FMazeGridVersionStore(const FMazeGridVersionStore&) = delete;
+    FMazeGridVersionStore& operator=(const FMazeGridVersionStore&) = delete;
+
+    /**
+     * Start over with a full grid (version 1). Readers still holding
+     * snapshots of the previous grid keep them.
+     *
+     * @param Walkable - One byte per cell, row-major
+     */
+    void Initialize(TArrayView<const uint8> Walkable, FIntPoint Size, uint64 GridHash);
+
+    /**
+     * Publish edited cells as a new version.
+     *
+     * @param ChangedCells - Cells to update
+     * @param ReadCell - New walkability byte for a flat cell index
+     * @param GridHash - Hash of the grid after the edit
+     * @return The new version number (0 if not initialized)
+     */
+    uint64 Publish(TArrayView<const FIntPoint> ChangedCells, TFunctionRef<uint8(int32)> ReadCell, uint64 GridHash);
+
+    /** Latest version. Lock-free; null before Initialize. */
+    FMazeGridSnapshot Acquire() const;
+
+    /** Latest version number (0 before Initialize) */
+    uint64 GetVersion() const;
+
+    /** Drop everything (readers keep what they hold) */
+    void Reset();
+
+private:
+    /** Swap in a new version and retire the old one. Writer lock held. */
+    void Install(FMazeGridVersion* NewVersion);
+
+    /** Release retired versions no reader can still be picking up. Writer lock held. */
+    void ReclaimRetired();
+
+    /** What readers load */
+    std::atomic<const FMazeGridVersion*> Current { nullptr };
+
+    /** Readers between loading Current and taking their reference */
+    mutable std::atomic<int32> AcquiringReaders { 0 };
+
+    /** The store's own reference to Current (writers only) */
+    TRefCountPtr<FMazeGridVersion> CurrentOwner;
+
+    /** Replaced versions the store still references (writers only) */
+    TArray<TRefCountPtr<FMazeGridVersion>> Retired;
+
+    /** Serializes writers; readers never take it */
+    FCriticalSection WriterLock;
+};
@@ -0,0 +1,237 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazePackedPath.h"
+
+namespace MazePackedPath
+{
+    /** Direction code -> step. 0 = East, 1 = South, 2 = West, 3 = North */
+    constexpr int32 DeltaX[4] = { 1, 0, -1, 0 };
+    constexpr int32 DeltaY[4] = { 0, 1, 0, -1 };
+
+    /** Refuse to decode absurd sizes from the network */
+    constexpr int32 MaxRunBytes = 64 * 1024;
+    constexpr int32 MaxCells = 8192 * 8192;
+
+    /** Step -> direction code, INDEX_NONE if not a unit 4-neighbour step */
+    int32 GetDirectionCode(const FIntPoint& Step)
+    {
+        if (Step.Y == 0)
+        {
+            if (Step.X == 1) return 0;
+            if (Step.X == -1) return 2;
+        }
+        else if (Step.X == 0)
+        {
+            if (Step.Y == 1) return 1;
+            if (Step.Y == -1) return 3;
+        }
+        return INDEX_NONE;
+    }
+
+    /** Read one varint, false if it runs off the end or past 32 bits */
+    bool ReadVarint(const uint8*& Read, const uint8* ReadEnd, uint32& OutValue)
+    {
+        OutValue = 0;
+        uint32 Shift = 0;
+        uint8 Byte = 0;
+        do
+        {
+            if (Read >= ReadEnd || Shift > 28)
+            {
+                return false;
+            }
+            Byte = *Read++;
+            OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+            Shift += 7;
+        }
+        while (Byte & 0x80);
+        return true;
+    }
+
+    /** Total steps the runs describe, INDEX_NONE if corrupt. Allocates nothing. */
+    int64 CountSteps(TArrayView<const uint8> Runs)
+    {
+        const uint8* Read = Runs.GetData();
+        const uint8* const ReadEnd = Read + Runs.Num();
+
+        int64 Steps = 0;
+        uint32 Value = 0;
+        while (Read < ReadEnd)
+        {
+            if (!ReadVarint(Read, ReadEnd, Value))
+            {
+                return INDEX_NONE;
+            }
+            Steps += static_cast<int64>(Value >> 2) + 1;
+        }
+        return Steps;
+    }
+
+    void WriteVarint(TArray<uint8>& Out, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(static_cast<uint8>(Value | 0x80));
+            Value >>= 7;
+        }
+        Out.Add(static_cast<uint8>(Value));
+    }
+}
+
+bool FMazePackedPath::Encode(TArrayView<const FIntPoint> Path)
+{
+    Reset();
+
+    if (Path.Num() == 0)
+    {
+        return true;
+    }
+
+    StartCell = Path[0];
+    NumCells = Path.Num();
+
+    // A run starts with its first step and grows while the direction holds
+    int32 RunDirection = INDEX_NONE;
+    uint32 RunLength = 0;
+
+    for (int32 i = 1; i < Path.Num(); ++i)
+    {
+        const int32 Direction = MazePackedPath::GetDirectionCode(Path[i] - Path[i - 1]);
+        if (Direction == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MazePackedPath: Cells %d and %d are not neighbours, cannot pack"), i - 1, i);
+            Reset();
+            return false;
+        }
+
+        if (Direction == RunDirection)
+        {
+            ++RunLength;
+            continue;
+        }
+
+        if (RunLength > 0)
+        {
+            MazePackedPath::WriteVarint(Runs, ((RunLength - 1) << 2) | static_cast<uint32>(RunDirection));
+        }
+
+        RunDirection = Direction;
+        RunLength = 1;
+    }
+
+    if (RunLength > 0)
+    {
+        MazePackedPath::WriteVarint(Runs, ((RunLength - 1) << 2) | static_cast<uint32>(RunDirection));
+    }
+
+    // The receiving side would refuse it anyway
+    if (Runs.Num() > MazePackedPath::MaxRunBytes || NumCells > MazePackedPath::MaxCells)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePackedPath: Path of %d cells packs to %d bytes, over the limit"), NumCells, Runs.Num());
+        Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool FMazePackedPath::Decode(TArray<FIntPoint>& OutPath, int32 MaxCells) const
+{
+    OutPath.Reset();
+
+    if (NumCells <= 0)
+    {
+        return NumCells == 0 && Runs.Num() == 0;
+    }
+
+    // Validate before allocating: NumCells comes off the wire, and a dozen
+    // bytes could otherwise ask for hundreds of MB
+    if (NumCells > MaxCells || MazePackedPath::CountSteps(Runs) != NumCells - 1)
+    {
+        return false;
+    }
+
+    // Size once, then write through a raw pointer: no per-cell growth checks
+    OutPath.SetNumUninitialized(NumCells);
+    FIntPoint* Write = OutPath.GetData();
+
+    FIntPoint Current = StartCell;
+    *Write++ = Current;
+
+    const uint8* Read = Runs.GetData();
+    const uint8* const ReadEnd = Read + Runs.Num();
+
+    // Runs were checked above, so every varint reads and every run fits
+    uint32 Value = 0;
+    while (MazePackedPath::ReadVarint(Read, ReadEnd, Value))
+    {
+        const uint32 Direction = Value & 3;
+        const int64 RunLength = static_cast<int64>(Value >> 2) + 1;
+
+        // Straight run: the same delta added RunLength times
+        const FIntPoint Step(MazePackedPath::DeltaX[Direction], MazePackedPath::DeltaY[Direction]);
+        for (int64 i = 0; i < RunLength; ++i)
+        {
+            Current += Step;
+            *Write++ = Current;
+        }
+    }
+
+    return true;
+}
+
+void FMazePackedPath::Reset()
+{
+    StartCell = FIntPoint(-1, -1);
+    NumCells = 0;
+    Runs.Reset();
+}
+
+int32 FMazePackedPath::GetPackedSize() const
+{
+    // Rough varint sizes of the header fields + the run bytes
+    auto VarintSize = [](uint32 Value) { return Value < 0x80 ? 1 : Value < 0x4000 ? 2 : Value < 0x200000 ? 3 : 4; };
+
+    return VarintSize(static_cast<uint32>(StartCell.X + 1)) + VarintSize(static_cast<uint32>(StartCell.Y + 1))
+        + VarintSize(static_cast<uint32>(NumCells)) + VarintSize(static_cast<uint32>(Runs.Num())) + Runs.Num();
+}
+
+bool FMazePackedPath::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // +1 so the (-1,-1) "empty" start packs as zeros
+    uint32 PackedStartX = static_cast<uint32>(StartCell.X + 1);
+    uint32 PackedStartY = static_cast<uint32>(StartCell.Y + 1);
+    uint32 PackedNumCells = static_cast<uint32>(NumCells);
+    uint32 PackedNumRunBytes = static_cast<uint32>(Runs.Num());
+
+    Ar.SerializeIntPacked(PackedStartX);
+    Ar.SerializeIntPacked(PackedStartY);
+    Ar.SerializeIntPacked(PackedNumCells);
+    Ar.SerializeIntPacked(PackedNumRunBytes);
+
+    if (Ar.IsLoading())
+    {
+        if (PackedNumRunBytes > MazePackedPath::MaxRunBytes || PackedNumCells > MazePackedPath::MaxCells)
+        {
+            Reset();
+            bOutSuccess = false;
+            return true;
+        }
+
+        StartCell = FIntPoint(static_cast<int32>(PackedStartX) - 1, static_cast<int32>(PackedStartY) - 1);
+        NumCells = static_cast<int32>(PackedNumCells);
+        Runs.SetNumUninitialized(static_cast<int32>(PackedNumRunBytes));
+    }
+
+    Ar.Serialize(Runs.GetData(), Runs.Num());
+
+    bOutSuccess = !Ar.IsError();
+
+    // Runs must describe exactly NumCells - 1 steps (no allocation here)
+    if (bOutSuccess && Ar.IsLoading() && NumCells > 0 && MazePackedPath::CountSteps(Runs) != NumCells - 1)
+    {
+        Reset();
+        bOutSuccess = false;
+    }
+    return true;
+}
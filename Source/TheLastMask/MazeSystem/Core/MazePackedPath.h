@@ -0,0 +1,105 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MazePackedPath.generated.h"
+
+class UPackageMap;
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    NetSerialize + TStructOpsTypeTraits<...>::WithNetSerializer:
+        - Lets a USTRUCT write its own replication format
+        - Called instead of the default property-by-property serializer
+        - bOutSuccess = false tells the net driver the data was corrupt
+
+    FArchive::SerializeIntPacked:
+        - Writes a uint32 using 1-5 bytes (7 bits per byte)
+        - Small numbers (the common case) cost a single byte
+
+    VARINT:
+        - Same idea as SerializeIntPacked, done by hand into a byte array
+        - Low 7 bits carry data, the high bit means "another byte follows"
+=============================================================================*/
+
+/**
+ * A maze path packed as runs of straight moves.
+ *
+ * FORMAT:
+ *   StartCell, then one varint per run:
+ *       value = ((RunLength - 1) << 2) | Direction
+ *       Direction: 0 = East, 1 = South, 2 = West, 3 = North
+ *   Runs of up to 32 cells fit in one byte.
+ *
+ * SIZE:
+ *   A 200-cell maze path has a few dozen turns, so it packs into a few
+ *   dozen bytes, vs 4800 bytes for PathWorldPositions (24 bytes per FVector).
+ *
+ * Use this to replicate Mask 1 results to a co-op partner, or to store
+ * paths in replays and caches.
+ */
+USTRUCT(BlueprintType)
+struct THELASTMASK_API FMazePackedPath
+{
+    GENERATED_BODY()
+
+    /** First cell of the path ((-1,-1) = empty path) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    FIntPoint StartCell = FIntPoint(-1, -1);
+
+    /** Number of cells in the decoded path (including StartCell) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    int32 NumCells = 0;
+
+    /** Varint-encoded direction runs */
+    UPROPERTY()
+    TArray<uint8> Runs;
+
+    /**
+     * Pack a path of 4-connected grid cells.
+     *
+     * @param Path - Cells, each one step from the previous
+     * @return False (and an empty result) if two cells are not neighbours,
+     *         or the path is too long to decode on the other side
+     */
+    bool Encode(TArrayView<const FIntPoint> Path);
+
+    /**
+     * Unpack into grid cells.
+     *
+     * @param OutPath - Receives NumCells cells
+     * @param MaxCells - Refuse longer paths (pass the receiving grid's cell count)
+     * @return False if the data is corrupt, NumCells disagrees with the runs,
+     *         or the path is over MaxCells. Checked before anything is allocated.
+     */
+    bool Decode(TArray<FIntPoint>& OutPath, int32 MaxCells = MAX_int32) const;
+
+    /** Reset to an empty path */
+    void Reset();
+
+    /** Is there a path stored? */
+    bool IsEmpty() const { return NumCells == 0; }
+
+    /** Size in bytes on the wire (approximate, excluding packet headers) */
+    int32 GetPackedSize() const;
+
+    /** Custom replication: start cell + run bytes, no per-cell data */
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FMazePackedPath& Other) const
+    {
+        return StartCell == Other.StartCell && NumCells == Other.NumCells && Runs == Other.Runs;
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FMazePackedPath> : public TStructOpsTypeTraitsBase2<FMazePackedPath>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true
+    };
+};
@@ -1,27 +1,40 @@
 // Copyright The Last Mask Team. All Rights Reserved.
 
 #include "MazePathfinder.h"
+#include "MazeGridHash.h"
+#include "MazeGridSidecar.h"
+#include "Async/ParallelFor.h"
 
 /*=============================================================================
-    BFS (BREADTH-FIRST SEARCH) ALGORITHM
+    A* WITH ALT (A*, LANDMARKS, TRIANGLE INEQUALITY)
     
-    Why BFS for maze pathfinding?
-    - Guarantees shortest path in unweighted graphs
-    - Mazes are unweighted (all steps cost the same)
-    - Simple to implement and understand
-    - Fast enough for game-jam-sized mazes
+    Why not plain BFS or Manhattan A*?
+    - BFS explores every cell closer than the target, in all directions
+    - Manhattan distance ignores walls, so on braided or room-stamped
+      mazes it underestimates badly and A* degrades towards BFS
     
-    How it works:
-    1. Start at source cell, add to queue
-    2. Mark source as visited
-    3. While queue not empty:
-       a. Dequeue front cell (current)
-       b. If current == target, we're done!
-       c. For each unvisited walkable neighbor:
-          - Mark as visited
-          - Record "parent" (where we came from)
-          - Add to queue
-    4. Reconstruct path by following parents backward
+    ALT:
+    1. Pick K landmark cells spread across the maze
+    2. Store the true maze distance from each landmark to every cell
+    3. For any cell N and goal G, the triangle inequality gives
+           d(N, G) >= |d(L, N) - d(L, G)|     for every landmark L
+       The largest of these is an admissible heuristic that knows
+       about walls, so A* expands far fewer cells
+    
+    The search itself uses flat per-cell arrays (G score, parent) that
+    are reused across queries, and a binary heap for the open list.
+    
+    ROOM LATTICE
+    The generator works on a grid of rooms and only expands it to cells
+    at the end: room (RX, RY) becomes cell (2RX, 2RY), and a link between
+    two rooms becomes the connector cell between them. A connector has
+    exactly one way through, so searching cells spends half its pops on
+    them. The lattice search instead expands rooms (cost 2 per link) and
+    writes the connectors back while rebuilding the path.
+    
+    The 4-bit links are read back from the floor grid rather than kept
+    from generation: baked assets and imported images only store cells,
+    and the grid is the one thing runtime edits keep current.
 =============================================================================*/
 
 UMazePathfinder::UMazePathfinder()
@@ -33,241 +46,1852 @@ UMazePathfinder::UMazePathfinder()
 
 void UMazePathfinder::Initialize(const TArray<FMazeCell>& InCells, FIntPoint InMazeSize, float InCellSize)
 {
-    CachedCells = InCells;
     MazeSize = InMazeSize;
     CellSize = InCellSize;
-    bIsInitialized = (CachedCells.Num() == MazeSize.X * MazeSize.Y);
+    bIsInitialized = (InCells.Num() == MazeSize.X * MazeSize.Y);
 
     if (!bIsInitialized)
     {
         UE_LOG(LogTemp, Error, TEXT("MazePathfinder: Cell count (%d) doesn't match size (%d x %d = %d)"),
-            CachedCells.Num(), MazeSize.X, MazeSize.Y, MazeSize.X * MazeSize.Y);
+            InCells.Num(), MazeSize.X, MazeSize.Y, MazeSize.X * MazeSize.Y);
+        Walkable.Reset();
+        RoomLinks.Reset();
+        GridHash = 0;
+        return;
+    }
+
+    // Only walkability is needed for searching; keep it as one byte per cell.
+    // Re-initializing (maze swap) keeps the allocation if it is big enough.
+    Walkable.SetNumUninitialized(InCells.Num(), EAllowShrinking::No);
+    for (int32 i = 0; i < InCells.Num(); ++i)
+    {
+        Walkable[i] = InCells[i].bIsFloor ? 1 : 0;
     }
+    GridHash = FMazeGridHash::Compute(Walkable, MazeSize);
+
+    BuildRoomLattice();
+    BuildCorridorRuns();
+
+    // Landmarks and cached routes belong to the old grid
+    ClearLandmarks();
+    AlternativePathCache.Reset();
 }
 
-FMazePathResult UMazePathfinder::FindPath(FIntPoint Start, FIntPoint End)
+void UMazePathfinder::InitializeFromSidecar(const TSharedRef<FMazeGridSidecar>& Sidecar, float InCellSize)
 {
-    FMazePathResult Result;
-    Result.bSuccess = false;
-    Result.PathLength = 0;
+    MazeSize = Sidecar->GetSize();
+    CellSize = InCellSize;
+    bIsInitialized = Sidecar->IsOpen();
 
-    // Validation
     if (!bIsInitialized)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: Not initialized!"));
-        return Result;
+        UE_LOG(LogTemp, Error, TEXT("MazePathfinder: Sidecar is not open"));
+        Walkable.Reset();
+        RoomLinks.Reset();
+        GridHash = 0;
+        return;
     }
 
-    if (!IsValidCell(Start))
+    // One byte per cell and written by SetCellWalkable, so it is the one
+    // plane worth copying. The hash was computed when the file was written.
+    const TArrayView<const uint8> MappedWalkable = Sidecar->GetWalkable();
+    Walkable.SetNumUninitialized(MappedWalkable.Num(), EAllowShrinking::No);
+    FMemory::Memcpy(Walkable.GetData(), MappedWalkable.GetData(), MappedWalkable.Num());
+    GridHash = Sidecar->GetGridHash();
+
+    BuildRoomLattice();
+    BuildCorridorRuns();
+
+    ClearLandmarks();
+    AlternativePathCache.Reset();
+
+    // K * 2 bytes per cell: read in place, paged in as searches touch it
+    if (Sidecar->GetNumLandmarks() > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: Start position (%d, %d) is not walkable"),
-            Start.X, Start.Y);
-        return Result;
+        Sidecar->GetLandmarks(Landmarks);
+        LandmarkPlane = Sidecar->GetLandmarkDistances();
+        LandmarkGridHash = GridHash;
+        MappedSidecar = Sidecar;
     }
+}
 
-    if (!IsValidCell(End))
+bool UMazePathfinder::WriteSidecar(const FString& Filename, FString& OutError) const
+{
+    if (!bIsInitialized)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: End position (%d, %d) is not walkable"),
-            End.X, End.Y);
-        return Result;
+        OutError = TEXT("Pathfinder is not initialized");
+        return false;
     }
 
-    // Early out if start == end
-    if (Start == End)
+    // Landmarks left over from before a runtime edit don't match the grid
+    const bool bLandmarks = HasValidLandmarks();
+    return FMazeGridSidecar::Write(Filename, MazeSize, GridHash, Walkable,
+        bLandmarks ? TArrayView<const FIntPoint>(Landmarks) : TArrayView<const FIntPoint>(),
+        bLandmarks ? LandmarkPlane : TArrayView<const uint16>(), OutError);
+}
+
+//=============================================================================
+// ALT LANDMARKS
+//=============================================================================
+
+void UMazePathfinder::BuildLandmarks(int32 NumLandmarks)
+{
+    ClearLandmarks();
+
+    if (!bIsInitialized || NumLandmarks <= 0)
     {
-        Result.bSuccess = true;
-        Result.PathGridCoordinates.Add(Start);
-        Result.PathWorldPositions.Add(GridToWorld(Start));
-        Result.PathLength = 1;
-        return Result;
+        return;
     }
 
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumCells = Walkable.Num();
+
     //=========================================================================
-    // BFS IMPLEMENTATION
+    // SELECTION (farthest-point)
+    // 1st landmark: the cell farthest (in maze distance) from any floor
+    //   cell, which lands on the rim of the maze.
+    // Others: the floor cell farthest in grid distance from every landmark
+    //   picked so far. Grid distance keeps selection cheap and lets all
+    //   distance fields be computed together afterwards.
     //=========================================================================
 
-    // Track visited cells (using TSet for O(1) lookup)
-    TSet<FIntPoint> Visited;
+    int32 FirstFloor = Walkable.IndexOfByKey(1);
+    if (FirstFloor == INDEX_NONE)
+    {
+        return;
+    }
 
-    // Track parent of each cell for path reconstruction
-    // Key = cell, Value = parent (where we came from)
-    TMap<FIntPoint, FIntPoint> Parents;
+    TArray<int32> Distances;
+    BuildDistanceField({ IndexToGrid(FirstFloor) }, Distances);
 
-    // BFS queue
-    TQueue<FIntPoint> Queue;
+    int32 FirstLandmark = FirstFloor;
+    for (int32 i = 0; i < NumCells; ++i)
+    {
+        if (Distances[i] > Distances[FirstLandmark])
+        {
+            FirstLandmark = i;
+        }
+    }
 
-    // Initialize with start
-    Queue.Enqueue(Start);
-    Visited.Add(Start);
-    Parents.Add(Start, FIntPoint(-1, -1)); // Start has no parent
+    TArray<int32> LandmarkIndices;
+    LandmarkIndices.Add(FirstLandmark);
 
-    bool bFoundPath = false;
+    // Grid distance from each floor cell to its nearest landmark so far
+    TArray<int32> NearestLandmarkDistance;
+    NearestLandmarkDistance.Init(MAX_int32, NumCells);
 
-    // BFS loop
-    while (!Queue.IsEmpty())
+    while (LandmarkIndices.Num() < NumLandmarks)
     {
-        FIntPoint Current;
-        Queue.Dequeue(Current);
+        const FIntPoint Last = IndexToGrid(LandmarkIndices.Last());
 
-        // Did we reach the end?
-        if (Current == End)
+        int32 Best = INDEX_NONE;
+        int32 BestDistance = 0;
+        for (int32 i = 0; i < NumCells; ++i)
         {
-            bFoundPath = true;
+            // Only cells the first landmark reaches (same connected region)
+            if (Distances[i] == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const int32 ToLast = FMath::Abs(i % MazeSize.X - Last.X) + FMath::Abs(i / MazeSize.X - Last.Y);
+            NearestLandmarkDistance[i] = FMath::Min(NearestLandmarkDistance[i], ToLast);
+
+            if (NearestLandmarkDistance[i] > BestDistance)
+            {
+                BestDistance = NearestLandmarkDistance[i];
+                Best = i;
+            }
+        }
+
+        if (Best == INDEX_NONE)
+        {
+            // Fewer floor cells than requested landmarks
             break;
         }
 
-        // Process all walkable neighbors
-        TArray<FIntPoint> Neighbors = GetWalkableNeighbors(Current);
-        for (const FIntPoint& Neighbor : Neighbors)
+        LandmarkIndices.Add(Best);
+    }
+
+    //=========================================================================
+    // DISTANCE FIELDS (bit-parallel BFS, 64 landmarks per pass)
+    // Stored cell-major: the K values for a cell sit next to each other,
+    // so the heuristic reads one cache line per cell. Each batch writes
+    // its own lanes, so batches never touch the same entry.
+    //=========================================================================
+
+    const int32 K = LandmarkIndices.Num();
+    LandmarkDistances.Init(UnreachableLandmarkDistance, NumCells * K);
+
+    ParallelFor(FMath::DivideAndRoundUp(K, 64), [&](int32 Batch)
+    {
+        const int32 First = Batch * 64;
+        const TArrayView<const int32> BatchSources = TArrayView<const int32>(LandmarkIndices).Slice(First, FMath::Min(64, K - First));
+
+        RunMultiSourceBFS(BatchSources, [&](int32 Cell, uint64 Lanes, int32 Distance)
         {
-            if (!Visited.Contains(Neighbor))
+            // Clamping keeps the heuristic admissible: |min(a,c) - min(b,c)| <= |a - b|
+            const uint16 Clamped = static_cast<uint16>(FMath::Min(Distance, UnreachableLandmarkDistance - 1));
+            for (; Lanes; Lanes &= Lanes - 1)
             {
-                Visited.Add(Neighbor);
-                Parents.Add(Neighbor, Current);
-                Queue.Enqueue(Neighbor);
+                LandmarkDistances[Cell * K + First + static_cast<int32>(FMath::CountTrailingZeros64(Lanes))] = Clamped;
             }
-        }
+            return true;
+        });
+    });
+
+    for (int32 Index : LandmarkIndices)
+    {
+        Landmarks.Add(IndexToGrid(Index));
     }
+    LandmarkPlane = LandmarkDistances;
 
-    // If we didn't find a path, return failure
-    if (!bFoundPath)
+    LandmarkBuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    LandmarkGridHash = GridHash;
+
+    UE_LOG(LogTemp, Log, TEXT("MazePathfinder: Built %d landmarks in %.2f ms (%d KB)"),
+        K, LandmarkBuildMs, static_cast<int32>(LandmarkDistances.GetAllocatedSize() / 1024));
+}
+
+void UMazePathfinder::ClearLandmarks()
+{
+    Landmarks.Reset();
+    LandmarkDistances.Reset();
+    LandmarkPlane = TArrayView<const uint16>();
+    MappedSidecar.Reset();
+    LandmarkBuildMs = 0.0;
+    LandmarkGridHash = 0;
+}
+
+//=============================================================================
+// RUNTIME EDITS
+//=============================================================================
+
+bool UMazePathfinder::SetCellWalkable(FIntPoint GridPosition, bool bWalkable)
+{
+    if (!bIsInitialized || GridPosition.X < 0 || GridPosition.X >= MazeSize.X ||
+        GridPosition.Y < 0 || GridPosition.Y >= MazeSize.Y)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: No path found from (%d,%d) to (%d,%d)"),
-            Start.X, Start.Y, End.X, End.Y);
-        return Result;
+        return false;
     }
 
-    //=========================================================================
-    // PATH RECONSTRUCTION
-    // Walk backwards from End to Start using parent pointers
-    //=========================================================================
+    const int32 Index = GridToIndex(GridPosition);
+    const uint8 NewValue = bWalkable ? 1 : 0;
+    if (Walkable[Index] == NewValue)
+    {
+        return false;
+    }
+
+    // Only this cell and the connectors next to it can change lattice status
+    const int32 X = GridPosition.X;
+    const int32 Y = GridPosition.Y;
+    auto CountViolationsAround = [this, X, Y]()
+    {
+        int32 Count = IsLatticeViolation(X, Y);
+        Count += X > 0 && IsLatticeViolation(X - 1, Y);
+        Count += X + 1 < MazeSize.X && IsLatticeViolation(X + 1, Y);
+        Count += Y > 0 && IsLatticeViolation(X, Y - 1);
+        Count += Y + 1 < MazeSize.Y && IsLatticeViolation(X, Y + 1);
+        return Count;
+    };
 
-    TArray<FIntPoint> ReversedPath;
-    FIntPoint Current = End;
+    LatticeViolations -= CountViolationsAround();
+    Walkable[Index] = NewValue;
+    LatticeViolations += CountViolationsAround();
 
-    while (Current != FIntPoint(-1, -1))
+    // A connector changed: refresh the links of the rooms on both sides
+    if ((X & 1) != 0 && (Y & 1) == 0)
     {
-        ReversedPath.Add(Current);
-        
-        if (FIntPoint* ParentPtr = Parents.Find(Current))
+        UpdateRoomLinks(X / 2, Y / 2);
+        if (X + 1 < MazeSize.X)
         {
-            Current = *ParentPtr;
+            UpdateRoomLinks(X / 2 + 1, Y / 2);
         }
-        else
+    }
+    else if ((X & 1) == 0 && (Y & 1) != 0)
+    {
+        UpdateRoomLinks(X / 2, Y / 2);
+        if (Y + 1 < MazeSize.Y)
         {
-            break;
+            UpdateRoomLinks(X / 2, Y / 2 + 1);
         }
     }
 
-    // Reverse to get Start -> End order
-    Algo::Reverse(ReversedPath);
-
-    // Populate result
-    Result.bSuccess = true;
-    Result.PathGridCoordinates = ReversedPath;
-    Result.PathLength = ReversedPath.Num();
-
-    // Convert to world positions
-    Result.PathWorldPositions.Reserve(ReversedPath.Num());
-    for (const FIntPoint& GridPos : ReversedPath)
-    {
-        Result.PathWorldPositions.Add(GridToWorld(GridPos));
-    }
+    UpdateCorridorRuns(X, Y);
 
-    return Result;
+    GridHash = FMazeGridHash::Toggle(GridHash, Index);
+    return true;
 }
 
-FMazePathResult UMazePathfinder::FindPathFromWorld(FVector WorldStart, FIntPoint GridEnd)
+//=============================================================================
+// ROOM LATTICE
+//=============================================================================
+
+void UMazePathfinder::BuildRoomLattice()
 {
-    FIntPoint GridStart = WorldToGrid(WorldStart);
+    RoomGridSize = FIntPoint((MazeSize.X + 1) / 2, (MazeSize.Y + 1) / 2);
+    RoomLinks.SetNumUninitialized(RoomGridSize.X * RoomGridSize.Y, EAllowShrinking::No);
 
-    // If the world position maps to a wall, find nearest walkable cell
-    if (!IsValidCell(GridStart))
+    for (int32 RoomY = 0; RoomY < RoomGridSize.Y; ++RoomY)
     {
-        GridStart = FindNearestWalkableCell(GridStart);
-        
-        if (GridStart == FIntPoint(-1, -1))
+        for (int32 RoomX = 0; RoomX < RoomGridSize.X; ++RoomX)
         {
-            FMazePathResult FailResult;
-            FailResult.bSuccess = false;
-            return FailResult;
+            UpdateRoomLinks(RoomX, RoomY);
         }
     }
 
-    return FindPath(GridStart, GridEnd);
+    LatticeViolations = 0;
+    for (int32 Y = 0; Y < MazeSize.Y; ++Y)
+    {
+        for (int32 X = 0; X < MazeSize.X; ++X)
+        {
+            LatticeViolations += IsLatticeViolation(X, Y);
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("MazePathfinder: Room lattice %dx%d, %d violating cells"),
+        RoomGridSize.X, RoomGridSize.Y, LatticeViolations);
 }
 
-FIntPoint UMazePathfinder::WorldToGrid(FVector WorldPosition) const
+bool UMazePathfinder::IsLatticeViolation(int32 X, int32 Y) const
 {
-    // Grid origin is at (0,0,0), cells extend in +X and +Y
-    // Cell center is at (X * CellSize + CellSize/2, Y * CellSize + CellSize/2, 0)
-    // So to reverse: GridX = Floor(WorldX / CellSize)
-    
-    const int32 GridX = FMath::FloorToInt(WorldPosition.X / CellSize);
-    const int32 GridY = FMath::FloorToInt(WorldPosition.Y / CellSize);
-    
-    return FIntPoint(GridX, GridY);
+    const int32 Index = Y * MazeSize.X + X;
+    if (!Walkable[Index])
+    {
+        return false;
+    }
+
+    const bool bOddX = (X & 1) != 0;
+    const bool bOddY = (Y & 1) != 0;
+
+    if (bOddX && bOddY)
+    {
+        // Between four rooms: the generator never carves these
+        return true;
+    }
+
+    if (bOddX)
+    {
+        return X + 1 >= MazeSize.X || !Walkable[Index - 1] || !Walkable[Index + 1];
+    }
+
+    if (bOddY)
+    {
+        return Y + 1 >= MazeSize.Y || !Walkable[Index - MazeSize.X] || !Walkable[Index + MazeSize.X];
+    }
+
+    // Room
+    return false;
 }
 
-FVector UMazePathfinder::GridToWorld(FIntPoint GridPosition) const
+void UMazePathfinder::UpdateRoomLinks(int32 RoomX, int32 RoomY)
 {
-    return FVector(
-        GridPosition.X * CellSize + CellSize * 0.5f,
-        GridPosition.Y * CellSize + CellSize * 0.5f,
-        0.0f
-    );
+    const int32 X = RoomX * 2;
+    const int32 Y = RoomY * 2;
+    const int32 Index = Y * MazeSize.X + X;
+
+    uint8 Links = 0;
+    if (X + 1 < MazeSize.X && Walkable[Index + 1])
+    {
+        Links |= static_cast<uint8>(EMazeDirection::East);
+    }
+    if (X > 0 && Walkable[Index - 1])
+    {
+        Links |= static_cast<uint8>(EMazeDirection::West);
+    }
+    if (Y + 1 < MazeSize.Y && Walkable[Index + MazeSize.X])
+    {
+        Links |= static_cast<uint8>(EMazeDirection::South);
+    }
+    if (Y > 0 && Walkable[Index - MazeSize.X])
+    {
+        Links |= static_cast<uint8>(EMazeDirection::North);
+    }
+
+    RoomLinks[RoomY * RoomGridSize.X + RoomX] = Links;
 }
 
-bool UMazePathfinder::IsValidCell(FIntPoint GridPosition) const
+bool UMazePathfinder::SearchRoomLattice(int32 StartIndex, int32 EndIndex, bool bUseLandmarks, TArray<FIntPoint>& OutPath)
 {
-    // Check bounds
-    if (GridPosition.X < 0 || GridPosition.X >= MazeSize.X ||
-        GridPosition.Y < 0 || GridPosition.Y >= MazeSize.Y)
+    OutPath.Reset();
+    LastNodesExpanded = 0;
+
+    const FIntPoint StartCell = IndexToGrid(StartIndex);
+    const FIntPoint EndCell = IndexToGrid(EndIndex);
+
+    if (StartIndex == EndIndex)
     {
-        return false;
+        OutPath.Add(StartCell);
+        return true;
     }
 
-    // Check if floor (walkable)
-    const int32 Index = GridToIndex(GridPosition);
-    if (Index >= 0 && Index < CachedCells.Num())
+    const int32 NumRooms = RoomLinks.Num();
+    const int32 RoomsX = RoomGridSize.X;
+
+    //=========================================================================
+    // SCRATCH SETUP (same stamp scheme as SearchPath, sized per room)
+    //=========================================================================
+
+    if (RoomStamps.Num() != NumRooms)
     {
-        return CachedCells[Index].bIsFloor;
+        RoomStamps.SetNumUninitialized(NumRooms, EAllowShrinking::No);
+        FMemory::Memzero(RoomStamps.GetData(), NumRooms * sizeof(uint32));
+        RoomGScores.SetNumUninitialized(NumRooms, EAllowShrinking::No);
+        RoomParents.SetNumUninitialized(NumRooms, EAllowShrinking::No);
+        CurrentRoomStamp = 0;
     }
 
-    return false;
-}
+    if (++CurrentRoomStamp == 0)
+    {
+        FMemory::Memzero(RoomStamps.GetData(), RoomStamps.Num() * sizeof(uint32));
+        CurrentRoomStamp = 1;
+    }
 
-FIntPoint UMazePathfinder::FindNearestWalkableCell(FIntPoint GridPosition) const
-{
-    // Expanding square search
-    // Check in increasing radius until we find a walkable cell
-    
-    const int32 MaxRadius = FMath::Max(MazeSize.X, MazeSize.Y);
-    
-    for (int32 Radius = 0; Radius <= MaxRadius; ++Radius)
+    const uint32 OpenStamp = CurrentRoomStamp;
+
+    //=========================================================================
+    // ENDPOINTS
+    // A room maps to itself. A connector maps to the two rooms it joins,
+    // one step away: both are seeded (start) or accepted (goal).
+    //=========================================================================
+
+    auto GetEndRooms = [RoomsX](FIntPoint Cell, int32& OutA, int32& OutB)
     {
-        // Check all cells at this radius
-        for (int32 DX = -Radius; DX <= Radius; ++DX)
+        OutA = (Cell.Y / 2) * RoomsX + Cell.X / 2;
+        OutB = (Cell.X & 1) != 0 ? OutA + 1 : ((Cell.Y & 1) != 0 ? OutA + RoomsX : OutA);
+    };
+
+    int32 StartRoomA, StartRoomB, GoalRoomA, GoalRoomB;
+    GetEndRooms(StartCell, StartRoomA, StartRoomB);
+    GetEndRooms(EndCell, GoalRoomA, GoalRoomB);
+
+    const int32 StartOffset = StartRoomA != StartRoomB ? 1 : 0;
+    const int32 EndOffset = GoalRoomA != GoalRoomB ? 1 : 0;
+
+    auto RoomToCell = [RoomsX](int32 Room)
+    {
+        return FIntPoint((Room % RoomsX) * 2, (Room / RoomsX) * 2);
+    };
+
+    // Cell-distance heuristic to End, minus the last connector step (a goal
+    // room is one step short of a connector End). Still consistent: every
+    // link costs 2 and moves the room by 2 cells.
+    auto Heuristic = [&](int32 Room) -> int32
+    {
+        const FIntPoint Cell = RoomToCell(Room);
+        const int32 CellIndex = Cell.Y * MazeSize.X + Cell.X;
+        const int32 Manhattan = FMath::Abs(Cell.X - EndCell.X) + FMath::Abs(Cell.Y - EndCell.Y);
+        const int32 Estimate = bUseLandmarks ? FMath::Max(Manhattan, GetLandmarkHeuristic(CellIndex, EndIndex)) : Manhattan;
+        return FMath::Max(Estimate - EndOffset, 0);
+    };
+
+    OpenHeap.Reset();
+
+    auto Seed = [&](int32 Room)
+    {
+        RoomStamps[Room] = OpenStamp;
+        RoomGScores[Room] = StartOffset;
+        RoomParents[Room] = INDEX_NONE;
+        OpenHeap.HeapPush(FOpenNode{ StartOffset + Heuristic(Room), StartOffset, Room });
+    };
+
+    Seed(StartRoomA);
+    if (StartRoomB != StartRoomA)
+    {
+        Seed(StartRoomB);
+    }
+
+    // Link bits and room offsets for East, West, South, North
+    const uint8 LinkBits[] = {
+        static_cast<uint8>(EMazeDirection::East), static_cast<uint8>(EMazeDirection::West),
+        static_cast<uint8>(EMazeDirection::South), static_cast<uint8>(EMazeDirection::North) };
+    const int32 RoomOffsets[] = { 1, -1, RoomsX, -RoomsX };
+
+    int32 GoalRoom = INDEX_NONE;
+
+    while (OpenHeap.Num() > 0)
+    {
+        FOpenNode Node;
+        OpenHeap.HeapPop(Node, EAllowShrinking::No);
+
+        if (Node.G != RoomGScores[Node.Index])
         {
-            for (int32 DY = -Radius; DY <= Radius; ++DY)
+            continue;
+        }
+
+        ++LastNodesExpanded;
+
+        if (Node.Index == GoalRoomA || Node.Index == GoalRoomB)
+        {
+            GoalRoom = Node.Index;
+            break;
+        }
+
+        // Room, connector, room
+        const int32 NextG = Node.G + 2;
+        const uint8 Links = RoomLinks[Node.Index];
+
+        for (int32 Dir = 0; Dir < 4; ++Dir)
+        {
+            // A valid lattice has no open connector leading off the grid
+            if ((Links & LinkBits[Dir]) == 0)
             {
-                // Only check perimeter of this radius (optimization)
-                if (FMath::Abs(DX) != Radius && FMath::Abs(DY) != Radius)
-                {
-                    continue;
-                }
+                continue;
+            }
 
-                const FIntPoint TestPos(GridPosition.X + DX, GridPosition.Y + DY);
-                if (IsValidCell(TestPos))
-                {
-                    return TestPos;
-                }
+            const int32 Neighbor = Node.Index + RoomOffsets[Dir];
+            if (RoomStamps[Neighbor] == OpenStamp && RoomGScores[Neighbor] <= NextG)
+            {
+                continue;
             }
+
+            RoomStamps[Neighbor] = OpenStamp;
+            RoomGScores[Neighbor] = NextG;
+            RoomParents[Neighbor] = Node.Index;
+            OpenHeap.HeapPush(FOpenNode{ NextG + Heuristic(Neighbor), NextG, Neighbor });
         }
     }
 
-    // No walkable cell found
-    return FIntPoint(-1, -1);
+    if (GoalRoom == INDEX_NONE)
+    {
+        return false;
+    }
+
+    //=========================================================================
+    // PATH RECONSTRUCTION
+    // Walk the room parents back, writing the connector between each pair
+    // (their midpoint), plus the end connectors if Start/End are on one
+    //=========================================================================
+
+    OutPath.SetNumUninitialized(RoomGScores[GoalRoom] + EndOffset + 1);
+
+    int32 Write = OutPath.Num() - 1;
+    if (EndOffset)
+    {
+        OutPath[Write--] = EndCell;
+    }
+
+    for (int32 Room = GoalRoom; ; )
+    {
+        const FIntPoint RoomCell = RoomToCell(Room);
+        OutPath[Write--] = RoomCell;
+
+        const int32 Parent = RoomParents[Room];
+        if (Parent == INDEX_NONE)
+        {
+            break;
+        }
+
+        OutPath[Write--] = (RoomCell + RoomToCell(Parent)) / 2;
+        Room = Parent;
+    }
+
+    if (StartOffset)
+    {
+        OutPath[Write--] = StartCell;
+    }
+
+    check(Write == -1);
+    return true;
+}
+
+int32 UMazePathfinder::GetLandmarkHeuristic(int32 Index, int32 GoalIndex) const
+{
+    const int32 K = Landmarks.Num();
+    const uint16* FromCell = &LandmarkPlane[Index * K];
+    const uint16* FromGoal = &LandmarkPlane[GoalIndex * K];
+
+    int32 Best = 0;
+    for (int32 L = 0; L < K; ++L)
+    {
+        // A landmark that can't reach one of the two cells tells us nothing
+        if (FromCell[L] != UnreachableLandmarkDistance && FromGoal[L] != UnreachableLandmarkDistance)
+        {
+            Best = FMath::Max(Best, FMath::Abs(static_cast<int32>(FromCell[L]) - static_cast<int32>(FromGoal[L])));
+        }
+    }
+
+    return Best;
+}
+
+FMazePathBenchmarkResult UMazePathfinder::BenchmarkPathfinding(int32 NumQueries, int32 Seed)
+{
+    FMazePathBenchmarkResult Result;
+    Result.NumLandmarks = Landmarks.Num();
+    Result.LandmarkBuildMs = LandmarkBuildMs;
+    Result.LandmarkMemoryBytes = static_cast<int32>(LandmarkDistances.GetAllocatedSize());
+
+    if (!bIsInitialized || NumQueries <= 0)
+    {
+        return Result;
+    }
+
+    TArray<int32> FloorIndices;
+    for (int32 i = 0; i < Walkable.Num(); ++i)
+    {
+        if (Walkable[i])
+        {
+            FloorIndices.Add(i);
+        }
+    }
+
+    if (FloorIndices.Num() < 2)
+    {
+        return Result;
+    }
+
+    // Same random pairs for both runs
+    FRandomStream Random(Seed);
+    TArray<TPair<int32, int32>> Queries;
+    Queries.Reserve(NumQueries);
+    for (int32 i = 0; i < NumQueries; ++i)
+    {
+        Queries.Emplace(FloorIndices[Random.RandHelper(FloorIndices.Num())], FloorIndices[Random.RandHelper(FloorIndices.Num())]);
+    }
+
+    TArray<FIntPoint> Path;
+
+    auto RunQueries = [&](bool bUseLandmarks, bool bUseLattice, int64& OutExpanded, double& OutMs)
+    {
+        OutExpanded = 0;
+        const double StartTime = FPlatformTime::Seconds();
+        for (const TPair<int32, int32>& Query : Queries)
+        {
+            if (bUseLattice)
+            {
+                SearchRoomLattice(Query.Key, Query.Value, bUseLandmarks, Path);
+            }
+            else
+            {
+                SearchPath(Query.Key, Query.Value, bUseLandmarks, Path);
+            }
+            OutExpanded += LastNodesExpanded;
+        }
+        OutMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    };
+
+    int64 ManhattanExpanded = 0;
+    int64 LandmarkExpanded = 0;
+    int64 LatticeExpanded = 0;
+    RunQueries(false, false, ManhattanExpanded, Result.ManhattanMs);
+    RunQueries(HasValidLandmarks(), false, LandmarkExpanded, Result.LandmarkMs);
+
+    // Lattice availability, not the enable switch: the benchmark compares
+    Result.bRoomLattice = RoomLinks.Num() > 0 && LatticeViolations == 0;
+    if (Result.bRoomLattice)
+    {
+        RunQueries(HasValidLandmarks(), true, LatticeExpanded, Result.LatticeMs);
+    }
+
+    // Alternatives on a subset (each is several searches), cache bypassed
+    const int32 NumAlternativeQueries = FMath::Min(NumQueries, 100);
+    int32 AlternativesFound = 0;
+    AlternativePathCache.Reset();
+    const double AlternativeStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumAlternativeQueries; ++i)
+    {
+        AlternativesFound += FindAlternativePaths(IndexToGrid(Queries[i].Key), IndexToGrid(Queries[i].Value), 3).Num();
+    }
+    Result.AlternativePathsMs = (FPlatformTime::Seconds() - AlternativeStart) * 1000.0 / NumAlternativeQueries;
+    Result.AlternativePathsFound = AlternativesFound / static_cast<double>(NumAlternativeQueries);
+    AlternativePathCache.Reset();
+
+    Result.NumQueries = NumQueries;
+    Result.ManhattanNodesExpanded = ManhattanExpanded / static_cast<double>(NumQueries);
+    Result.LandmarkNodesExpanded = LandmarkExpanded / static_cast<double>(NumQueries);
+    Result.LatticeNodesExpanded = LatticeExpanded / static_cast<double>(NumQueries);
+    Result.CellSearchMemoryBytes = static_cast<int32>(GScores.GetAllocatedSize() + Parents.GetAllocatedSize() + SearchStamps.GetAllocatedSize());
+    Result.LatticeMemoryBytes = static_cast<int32>(RoomLinks.GetAllocatedSize() + RoomGScores.GetAllocatedSize()
+        + RoomParents.GetAllocatedSize() + RoomStamps.GetAllocatedSize());
+
+    UE_LOG(LogTemp, Log, TEXT("MazePathfinder benchmark (%dx%d, %d queries):"), MazeSize.X, MazeSize.Y, NumQueries);
+    UE_LOG(LogTemp, Log, TEXT("  Landmarks: %d, preprocess %.2f ms, %d bytes"),
+        Result.NumLandmarks, Result.LandmarkBuildMs, Result.LandmarkMemoryBytes);
+    UE_LOG(LogTemp, Log, TEXT("  Manhattan A*: %.1f expanded/query, %.3f ms total"),
+        Result.ManhattanNodesExpanded, Result.ManhattanMs);
+    UE_LOG(LogTemp, Log, TEXT("  ALT A*:       %.1f expanded/query, %.3f ms total"),
+        Result.LandmarkNodesExpanded, Result.LandmarkMs);
+    if (Result.bRoomLattice)
+    {
+        UE_LOG(LogTemp, Log, TEXT("  Lattice A*:   %.1f expanded/query, %.3f ms total"),
+            Result.LatticeNodesExpanded, Result.LatticeMs);
+        UE_LOG(LogTemp, Log, TEXT("  Search memory: %d bytes per cell grid, %d bytes lattice"),
+            Result.CellSearchMemoryBytes, Result.LatticeMemoryBytes);
+    }
+    UE_LOG(LogTemp, Log, TEXT("  Alternatives (K=3): %.1f routes/query, %.3f ms/query"),
+        Result.AlternativePathsFound, Result.AlternativePathsMs);
+
+    return Result;
+}
+
+FMazePathResult UMazePathfinder::FindPath(FIntPoint Start, FIntPoint End)
+{
+    FMazePathResult Result;
+    Result.bSuccess = false;
+    Result.PathLength = 0;
+
+    // Validation
+    if (!bIsInitialized)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: Not initialized!"));
+        return Result;
+    }
+
+    if (!IsValidCell(Start))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: Start position (%d, %d) is not walkable"),
+            Start.X, Start.Y);
+        return Result;
+    }
+
+    if (!IsValidCell(End))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: End position (%d, %d) is not walkable"),
+            End.X, End.Y);
+        return Result;
+    }
+
+    // Early out if start == end
+    if (Start == End)
+    {
+        Result.bSuccess = true;
+        Result.PathGridCoordinates.Add(Start);
+        Result.PathWorldPositions.Add(GridToWorld(Start));
+        Result.PathLength = 1;
+        return Result;
+    }
+
+    TArray<FIntPoint> Path;
+    const bool bFound = CanUseRoomLattice()
+        ? SearchRoomLattice(GridToIndex(Start), GridToIndex(End), HasValidLandmarks(), Path)
+        : SearchPath(GridToIndex(Start), GridToIndex(End), HasValidLandmarks(), Path);
+
+    if (!bFound)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: No path found from (%d,%d) to (%d,%d)"),
+            Start.X, Start.Y, End.X, End.Y);
+        return Result;
+    }
+
+    // Populate result
+    Result.bSuccess = true;
+    Result.PathLength = Path.Num();
+
+    // Convert to world positions
+    Result.PathWorldPositions.Reserve(Path.Num());
+    for (const FIntPoint& GridPos : Path)
+    {
+        Result.PathWorldPositions.Add(GridToWorld(GridPos));
+    }
+
+    Result.PathGridCoordinates = MoveTemp(Path);
+
+    return Result;
+}
+
+bool UMazePathfinder::SearchPath(int32 StartIndex, int32 EndIndex, bool bUseLandmarks, TArray<FIntPoint>& OutPath, const uint16* StepPenalty)
+{
+    OutPath.Reset();
+    LastNodesExpanded = 0;
+
+    const int32 NumCells = Walkable.Num();
+
+    //=========================================================================
+    // SCRATCH SETUP
+    // Buffers live across queries. A cell's G/Parent are only trusted when
+    // its stamp matches this search, so nothing is cleared per query.
+    //=========================================================================
+
+    if (SearchStamps.Num() != NumCells)
+    {
+        SearchStamps.SetNumUninitialized(NumCells, EAllowShrinking::No);
+        FMemory::Memzero(SearchStamps.GetData(), NumCells * sizeof(uint32));
+        GScores.SetNumUninitialized(NumCells, EAllowShrinking::No);
+        Parents.SetNumUninitialized(NumCells, EAllowShrinking::No);
+        CurrentStamp = 0;
+    }
+
+    if (++CurrentStamp == 0)
+    {
+        // Wrapped after 4 billion searches: start over
+        FMemory::Memzero(SearchStamps.GetData(), SearchStamps.Num() * sizeof(uint32));
+        CurrentStamp = 1;
+    }
+
+    const uint32 OpenStamp = CurrentStamp;
+    const int32 EndX = EndIndex % MazeSize.X;
+    const int32 EndY = EndIndex / MazeSize.X;
+
+    auto Heuristic = [&](int32 Index) -> int32
+    {
+        const int32 Manhattan = FMath::Abs(Index % MazeSize.X - EndX) + FMath::Abs(Index / MazeSize.X - EndY);
+        return bUseLandmarks ? FMath::Max(Manhattan, GetLandmarkHeuristic(Index, EndIndex)) : Manhattan;
+    };
+
+    OpenHeap.Reset();
+
+    SearchStamps[StartIndex] = OpenStamp;
+    GScores[StartIndex] = 0;
+    Parents[StartIndex] = INDEX_NONE;
+    OpenHeap.HeapPush(FOpenNode{ Heuristic(StartIndex), 0, StartIndex });
+
+    // Index offsets for East, West, South, North
+    const int32 IndexOffsets[] = { 1, -1, MazeSize.X, -MazeSize.X };
+
+    bool bFoundPath = false;
+
+    while (OpenHeap.Num() > 0)
+    {
+        FOpenNode Node;
+        OpenHeap.HeapPop(Node, EAllowShrinking::No);
+
+        // Stale entry: a shorter route to this cell was pushed later
+        if (Node.G != GScores[Node.Index])
+        {
+            continue;
+        }
+
+        ++LastNodesExpanded;
+
+        if (Node.Index == EndIndex)
+        {
+            bFoundPath = true;
+            break;
+        }
+
+        const int32 CurrentX = Node.Index % MazeSize.X;
+
+        for (int32 Dir = 0; Dir < 4; ++Dir)
+        {
+            // Don't wrap around the row ends
+            if ((Dir == 0 && CurrentX == MazeSize.X - 1) || (Dir == 1 && CurrentX == 0))
+            {
+                continue;
+            }
+
+            const int32 Neighbor = Node.Index + IndexOffsets[Dir];
+            if (Neighbor < 0 || Neighbor >= NumCells || !Walkable[Neighbor])
+            {
+                continue;
+            }
+
+            // Every step costs at least 1, so both heuristics stay admissible
+            const int32 NextG = Node.G + 1 + (StepPenalty ? StepPenalty[Neighbor] : 0);
+
+            if (SearchStamps[Neighbor] == OpenStamp && GScores[Neighbor] <= NextG)
+            {
+                continue;
+            }
+
+            SearchStamps[Neighbor] = OpenStamp;
+            GScores[Neighbor] = NextG;
+            Parents[Neighbor] = Node.Index;
+            OpenHeap.HeapPush(FOpenNode{ NextG + Heuristic(Neighbor), NextG, Neighbor });
+        }
+    }
+
+    if (!bFoundPath)
+    {
+        return false;
+    }
+
+    //=========================================================================
+    // PATH RECONSTRUCTION
+    // Walk backwards from End to Start using parent pointers
+    //=========================================================================
+
+    // G is the cell count only without penalties
+    int32 NumSteps = GScores[EndIndex];
+    if (StepPenalty)
+    {
+        NumSteps = 0;
+        for (int32 Cell = EndIndex; Cell != StartIndex; Cell = Parents[Cell])
+        {
+            ++NumSteps;
+        }
+    }
+
+    OutPath.SetNumUninitialized(NumSteps + 1);
+
+    int32 Current = EndIndex;
+    for (int32 i = OutPath.Num() - 1; i >= 0; --i)
+    {
+        OutPath[i] = FIntPoint(Current % MazeSize.X, Current / MazeSize.X);
+        Current = Parents[Current];
+    }
+
+    return true;
+}
+
+TArray<FMazePathResult> UMazePathfinder::FindAlternativePaths(FIntPoint Start, FIntPoint End, int32 NumPaths)
+{
+    TArray<FMazePathResult> Results;
+    NumPaths = FMath::Clamp(NumPaths, 1, 8);
+
+    if (!bIsInitialized || !IsValidCell(Start) || !IsValidCell(End))
+    {
+        return Results;
+    }
+
+    //=========================================================================
+    // CACHE (per Start/End, dropped wholesale when the grid changes)
+    //=========================================================================
+
+    if (AlternativePathGridHash != GridHash)
+    {
+        AlternativePathCache.Reset();
+        AlternativePathGridHash = GridHash;
+    }
+
+    const int32 StartIndex = GridToIndex(Start);
+    const int32 EndIndex = GridToIndex(End);
+    const uint64 CacheKey = (static_cast<uint64>(StartIndex) << 32) | static_cast<uint32>(EndIndex);
+
+    if (const FAlternativePathsEntry* Cached = AlternativePathCache.Find(CacheKey))
+    {
+        if (Cached->NumRequested >= NumPaths)
+        {
+            Results.Append(Cached->Paths.GetData(), FMath::Min(NumPaths, Cached->Paths.Num()));
+            return Results;
+        }
+    }
+
+    //=========================================================================
+    // PENALTY ITERATIONS
+    // Each accepted or rejected route makes its cells dearer. A route is
+    // kept only if at most MaxSharedFraction of its cells were on an
+    // earlier route.
+    //=========================================================================
+
+    constexpr uint16 PenaltyPerRoute = 4;
+    constexpr float MaxSharedFraction = 0.7f;
+    const int32 MaxIterations = NumPaths * 3;
+
+    const int32 NumCells = Walkable.Num();
+    if (StepPenalties.Num() != NumCells)
+    {
+        StepPenalties.SetNumZeroed(NumCells);
+    }
+
+    const bool bUseLandmarks = HasValidLandmarks();
+    TArray<FIntPoint> Path;
+
+    for (int32 Iteration = 0; Iteration < MaxIterations && Results.Num() < NumPaths; ++Iteration)
+    {
+        if (!SearchPath(StartIndex, EndIndex, bUseLandmarks, Path, Iteration > 0 ? StepPenalties.GetData() : nullptr))
+        {
+            break;
+        }
+
+        int32 Shared = 0;
+        for (const FIntPoint& Cell : Path)
+        {
+            const int32 Index = GridToIndex(Cell);
+            if (StepPenalties[Index] > 0)
+            {
+                ++Shared;
+            }
+            else
+            {
+                PenalizedCells.Add(Index);
+            }
+
+            StepPenalties[Index] = static_cast<uint16>(FMath::Min<int32>(StepPenalties[Index] + PenaltyPerRoute, MAX_uint16));
+        }
+
+        // The same route again: no detour left that is worth the penalty
+        if (Shared == Path.Num())
+        {
+            break;
+        }
+
+        if (Results.Num() > 0 && Shared > MaxSharedFraction * Path.Num())
+        {
+            continue;
+        }
+
+        FMazePathResult& Result = Results.AddDefaulted_GetRef();
+        Result.bSuccess = true;
+        Result.PathLength = Path.Num();
+        Result.PathWorldPositions.Reserve(Path.Num());
+        for (const FIntPoint& GridPos : Path)
+        {
+            Result.PathWorldPositions.Add(GridToWorld(GridPos));
+        }
+        Result.PathGridCoordinates = Path;
+    }
+
+    for (const int32 Index : PenalizedCells)
+    {
+        StepPenalties[Index] = 0;
+    }
+    PenalizedCells.Reset();
+
+    // Stable order for callers: shortest first
+    Results.StableSort([](const FMazePathResult& A, const FMazePathResult& B) { return A.PathLength < B.PathLength; });
+
+    // Bounded: flanking asks about a handful of (enemy, player) cell pairs at a time
+    constexpr int32 MaxCachedQueries = 256;
+    if (AlternativePathCache.Num() >= MaxCachedQueries)
+    {
+        AlternativePathCache.Reset();
+    }
+    FAlternativePathsEntry& Entry = AlternativePathCache.Add(CacheKey);
+    Entry.NumRequested = NumPaths;
+    Entry.Paths = Results;
+
+    return Results;
+}
+
+FMazePathResult UMazePathfinder::FindPathFromWorld(FVector WorldStart, FIntPoint GridEnd)
+{
+    FIntPoint GridStart = WorldToGrid(WorldStart);
+
+    // If the world position maps to a wall, find nearest walkable cell
+    if (!IsValidCell(GridStart))
+    {
+        GridStart = FindNearestWalkableCell(GridStart);
+        
+        if (GridStart == FIntPoint(-1, -1))
+        {
+            FMazePathResult FailResult;
+            FailResult.bSuccess = false;
+            return FailResult;
+        }
+    }
+
+    return FindPath(GridStart, GridEnd);
+}
+
+FIntPoint UMazePathfinder::WorldToGrid(FVector WorldPosition) const
+{
+    // Grid origin is at (0,0,0), cells extend in +X and +Y
+    // Cell center is at (X * CellSize + CellSize/2, Y * CellSize + CellSize/2, 0)
+    // So to reverse: GridX = Floor(WorldX / CellSize)
+    
+    const int32 GridX = FMath::FloorToInt(WorldPosition.X / CellSize);
+    const int32 GridY = FMath::FloorToInt(WorldPosition.Y / CellSize);
+    
+    return FIntPoint(GridX, GridY);
+}
+
+FVector UMazePathfinder::GridToWorld(FIntPoint GridPosition) const
+{
+    return FVector(
+        GridPosition.X * CellSize + CellSize * 0.5f,
+        GridPosition.Y * CellSize + CellSize * 0.5f,
+        0.0f
+    );
+}
+
+bool UMazePathfinder::IsValidCell(FIntPoint GridPosition) const
+{
+    // Check bounds
+    if (GridPosition.X < 0 || GridPosition.X >= MazeSize.X ||
+        GridPosition.Y < 0 || GridPosition.Y >= MazeSize.Y)
+    {
+        return false;
+    }
+
+    // Check if floor (walkable)
+    const int32 Index = GridToIndex(GridPosition);
+    if (Index >= 0 && Index < Walkable.Num())
+    {
+        return Walkable[Index] != 0;
+    }
+
+    return false;
+}
+
+FIntPoint UMazePathfinder::FindNearestWalkableCell(FIntPoint GridPosition) const
+{
+    // Expanding square search
+    // Check in increasing radius until we find a walkable cell
+    
+    const int32 MaxRadius = FMath::Max(MazeSize.X, MazeSize.Y);
+    
+    for (int32 Radius = 0; Radius <= MaxRadius; ++Radius)
+    {
+        // Check all cells at this radius
+        for (int32 DX = -Radius; DX <= Radius; ++DX)
+        {
+            for (int32 DY = -Radius; DY <= Radius; ++DY)
+            {
+                // Only check perimeter of this radius (optimization)
+                if (FMath::Abs(DX) != Radius && FMath::Abs(DY) != Radius)
+                {
+                    continue;
+                }
+
+                const FIntPoint TestPos(GridPosition.X + DX, GridPosition.Y + DY);
+                if (IsValidCell(TestPos))
+                {
+                    return TestPos;
+                }
+            }
+        }
+    }
+
+    // No walkable cell found
+    return FIntPoint(-1, -1);
+}
+
+void UMazePathfinder::ForEachVisibleCell(FIntPoint Origin, int32 Radius, TFunctionRef<void(FIntPoint)> Visit) const
+{
+    if (!IsValidCell(Origin))
+    {
+        return;
+    }
+    Visit(Origin);
+
+    const int32 RadiusSquared = Radius * Radius;
+
+    // One ray to every cell on the square around the viewer
+    for (int32 Offset = -Radius; Offset <= Radius; ++Offset)
+    {
+        TraceGridRay(Origin, Origin + FIntPoint(Offset, -Radius), RadiusSquared, Visit);
+        TraceGridRay(Origin, Origin + FIntPoint(Offset, Radius), RadiusSquared, Visit);
+        TraceGridRay(Origin, Origin + FIntPoint(-Radius, Offset), RadiusSquared, Visit);
+        TraceGridRay(Origin, Origin + FIntPoint(Radius, Offset), RadiusSquared, Visit);
+    }
+}
+
+bool UMazePathfinder::TraceGridRay(FIntPoint Origin, FIntPoint Target, int32 RadiusSquared, TFunctionRef<void(FIntPoint)> Visit) const
+{
+    const int32 DX = FMath::Abs(Target.X - Origin.X);
+    const int32 DY = -FMath::Abs(Target.Y - Origin.Y);
+    const int32 StepX = Origin.X < Target.X ? 1 : -1;
+    const int32 StepY = Origin.Y < Target.Y ? 1 : -1;
+    int32 Error = DX + DY;
+    FIntPoint Cell = Origin;
+
+    while (Cell != Target)
+    {
+        const int32 DoubleError = 2 * Error;
+        FIntPoint Next = Cell;
+        if (DoubleError >= DY)
+        {
+            Error += DY;
+            Next.X += StepX;
+        }
+        if (DoubleError <= DX)
+        {
+            Error += DX;
+            Next.Y += StepY;
+        }
+
+        // No peeking through the corner where two walls touch
+        if (Next.X != Cell.X && Next.Y != Cell.Y &&
+            !IsValidCell(FIntPoint(Next.X, Cell.Y)) && !IsValidCell(FIntPoint(Cell.X, Next.Y)))
+        {
+            return false;
+        }
+
+        if ((Next - Origin).SizeSquared() > RadiusSquared || !IsValidCell(Next))
+        {
+            return false;
+        }
+
+        Visit(Next);
+        Cell = Next;
+    }
+
+    return true;
+}
+
+int32 UMazePathfinder::GetRowRunId(FIntPoint Cell) const
+{
+    const bool bInside = Cell.X >= 0 && Cell.X < MazeSize.X && Cell.Y >= 0 && Cell.Y < MazeSize.Y;
+    return bInside && RowRunIds.Num() == Walkable.Num() ? RowRunIds[GridToIndex(Cell)] : INDEX_NONE;
+}
+
+int32 UMazePathfinder::GetColumnRunId(FIntPoint Cell) const
+{
+    const bool bInside = Cell.X >= 0 && Cell.X < MazeSize.X && Cell.Y >= 0 && Cell.Y < MazeSize.Y;
+    return bInside && ColumnRunIds.Num() == Walkable.Num() ? ColumnRunIds[GridToIndex(Cell)] : INDEX_NONE;
+}
+
+bool UMazePathfinder::HasStraightLineOfSight(FIntPoint A, FIntPoint B) const
+{
+    if (A.Y == B.Y)
+    {
+        const int32 Run = GetRowRunId(A);
+        return Run != INDEX_NONE && Run == GetRowRunId(B);
+    }
+
+    if (A.X == B.X)
+    {
+        const int32 Run = GetColumnRunId(A);
+        return Run != INDEX_NONE && Run == GetColumnRunId(B);
+    }
+
+    return false;
+}
+
+bool UMazePathfinder::HasLineOfSight(FIntPoint A, FIntPoint B, int32 MaxDistance) const
+{
+    const int32 RadiusSquared = MaxDistance > 0 ? MaxDistance * MaxDistance : MAX_int32;
+    if ((B - A).SizeSquared() > RadiusSquared)
+    {
+        return false;
+    }
+
+    // Corridors: the common case, no ray needed
+    if (A.X == B.X || A.Y == B.Y)
+    {
+        return HasStraightLineOfSight(A, B);
+    }
+
+    return IsValidCell(A) && TraceGridRay(A, B, RadiusSquared, [](FIntPoint) {});
+}
+
+void UMazePathfinder::BuildCorridorRuns()
+{
+    const int32 NumCells = Walkable.Num();
+    RowRunIds.SetNumUninitialized(NumCells, EAllowShrinking::No);
+    ColumnRunIds.SetNumUninitialized(NumCells, EAllowShrinking::No);
+
+    for (int32 Y = 0; Y < MazeSize.Y; ++Y)
+    {
+        int32 RunStart = INDEX_NONE;
+        for (int32 X = 0; X < MazeSize.X; ++X)
+        {
+            const int32 Index = Y * MazeSize.X + X;
+            RunStart = Walkable[Index] ? (RunStart == INDEX_NONE ? Index : RunStart) : INDEX_NONE;
+            RowRunIds[Index] = RunStart;
+        }
+    }
+
+    for (int32 X = 0; X < MazeSize.X; ++X)
+    {
+        int32 RunStart = INDEX_NONE;
+        for (int32 Y = 0; Y < MazeSize.Y; ++Y)
+        {
+            const int32 Index = Y * MazeSize.X + X;
+            RunStart = Walkable[Index] ? (RunStart == INDEX_NONE ? Index : RunStart) : INDEX_NONE;
+            ColumnRunIds[Index] = RunStart;
+        }
+    }
+}
+
+void UMazePathfinder::UpdateCorridorRuns(int32 X, int32 Y)
+{
+    // Relabel from the start of the floor stretch before the cell to the
+    // end of the one after it: a split or a merge never reaches further
+    auto Relabel = [this](TArray<int32>& RunIds, int32 Center, int32 Step, int32 Before, int32 After)
+    {
+        int32 First = Center;
+        for (int32 i = 0; i < Before && Walkable[First - Step]; ++i)
+        {
+            First -= Step;
+        }
+
+        int32 Last = Center;
+        for (int32 i = 0; i < After && Walkable[Last + Step]; ++i)
+        {
+            Last += Step;
+        }
+
+        int32 RunStart = INDEX_NONE;
+        for (int32 Index = First; Index <= Last; Index += Step)
+        {
+            RunStart = Walkable[Index] ? (RunStart == INDEX_NONE ? Index : RunStart) : INDEX_NONE;
+            RunIds[Index] = RunStart;
+        }
+    };
+
+    const int32 Index = GridToIndex(FIntPoint(X, Y));
+    Relabel(RowRunIds, Index, 1, X, MazeSize.X - 1 - X);
+    Relabel(ColumnRunIds, Index, MazeSize.X, Y, MazeSize.Y - 1 - Y);
+}
+
+bool UMazePathfinder::BuildDistanceField(const TArray<FIntPoint>& Sources, TArray<int32>& OutDistances) const
+{
+    const int32 NumCells = MazeSize.X * MazeSize.Y;
+    OutDistances.Init(INDEX_NONE, NumCells);
+
+    if (!bIsInitialized)
+    {
+        return false;
+    }
+
+    // Flat FIFO: every cell is enqueued at most once, so NumCells is enough
+    TArray<int32> Queue;
+    Queue.Reserve(NumCells);
+
+    for (const FIntPoint& Source : Sources)
+    {
+        if (IsValidCell(Source))
+        {
+            const int32 SourceIndex = GridToIndex(Source);
+            if (OutDistances[SourceIndex] == INDEX_NONE)
+            {
+                OutDistances[SourceIndex] = 0;
+                Queue.Add(SourceIndex);
+            }
+        }
+    }
+
+    if (Queue.Num() == 0)
+    {
+        return false;
+    }
+
+    // Index offsets for East, West, South, North
+    const int32 IndexOffsets[] = { 1, -1, MazeSize.X, -MazeSize.X };
+
+    for (int32 Head = 0; Head < Queue.Num(); ++Head)
+    {
+        const int32 Current = Queue[Head];
+        const int32 CurrentX = Current % MazeSize.X;
+        const int32 NextDistance = OutDistances[Current] + 1;
+
+        for (int32 Dir = 0; Dir < 4; ++Dir)
+        {
+            // Don't wrap around the row ends
+            if ((Dir == 0 && CurrentX == MazeSize.X - 1) || (Dir == 1 && CurrentX == 0))
+            {
+                continue;
+            }
+
+            const int32 Neighbor = Current + IndexOffsets[Dir];
+            if (Neighbor < 0 || Neighbor >= NumCells)
+            {
+                continue;
+            }
+
+            if (OutDistances[Neighbor] == INDEX_NONE && Walkable[Neighbor])
+            {
+                OutDistances[Neighbor] = NextDistance;
+                Queue.Add(Neighbor);
+            }
+        }
+    }
+
+    return true;
+}
+
+void UMazePathfinder::ForEachCellWithinSteps(FIntPoint Origin, int32 MaxSteps, TFunctionRef<void(FIntPoint, int32)> Visit) const
+{
+    if (!IsValidCell(Origin) || MaxSteps < 0)
+    {
+        return;
+    }
+
+    const int32 NumCells = MazeSize.X * MazeSize.Y;
+    const int32 IndexOffsets[] = { 1, -1, MazeSize.X, -MazeSize.X };
+
+    // Level by level, so the step count is the loop counter
+    TSet<int32> Seen;
+    TArray<int32> Frontier;
+    TArray<int32> Next;
+    Seen.Add(GridToIndex(Origin));
+    Frontier.Add(GridToIndex(Origin));
+
+    for (int32 Steps = 0; Frontier.Num() > 0; ++Steps)
+    {
+        for (int32 Current : Frontier)
+        {
+            Visit(IndexToGrid(Current), Steps);
+            if (Steps == MaxSteps)
+            {
+                continue;
+            }
+
+            const int32 CurrentX = Current % MazeSize.X;
+            for (int32 Dir = 0; Dir < 4; ++Dir)
+            {
+                if ((Dir == 0 && CurrentX == MazeSize.X - 1) || (Dir == 1 && CurrentX == 0))
+                {
+                    continue;
+                }
+
+                const int32 Neighbor = Current + IndexOffsets[Dir];
+                if (Neighbor >= 0 && Neighbor < NumCells && Walkable[Neighbor])
+                {
+                    bool bAlreadySeen = false;
+                    Seen.Add(Neighbor, &bAlreadySeen);
+                    if (!bAlreadySeen)
+                    {
+                        Next.Add(Neighbor);
+                    }
+                }
+            }
+        }
+
+        Swap(Frontier, Next);
+        Next.Reset();
+    }
+}
+
+void UMazePathfinder::RunMultiSourceBFS(TArrayView<const int32> SourceIndices, TFunctionRef<bool(int32, uint64, int32)> Visit) const
+{
+    check(SourceIndices.Num() <= 64);
+
+    const int32 NumCells = MazeSize.X * MazeSize.Y;
+
+    // Scratch stays allocated between calls and goes back all zero, so a
+    // search that stops early costs the cells it reached, not the grid
+    TUniquePtr<FMultiSourceBFSScratch> Scratch;
+    {
+        FScopeLock Lock(&BFSScratchLock);
+        if (BFSScratchPool.Num() > 0)
+        {
+            Scratch = BFSScratchPool.Pop(EAllowShrinking::No);
+        }
+    }
+    if (!Scratch)
+    {
+        Scratch = MakeUnique<FMultiSourceBFSScratch>();
+    }
+    if (Scratch->Seen.Num() != NumCells)
+    {
+        // First use, or the maze was resized
+        Scratch->Seen.SetNumZeroed(NumCells);
+        Scratch->Frontier.SetNumZeroed(NumCells);
+        Scratch->Next.SetNumZeroed(NumCells);
+    }
+
+    // Per cell: lanes that have reached it (Seen), lanes on the current
+    // frontier (Frontier) and lanes arriving next level (Next)
+    uint64* const Seen = Scratch->Seen.GetData();
+    TArray<uint64>* Frontier = &Scratch->Frontier;
+    TArray<uint64>* Next = &Scratch->Next;
+
+    // Cells with a non-zero Frontier / Next word, so a level only touches its own cells
+    TArray<int32>* FrontierCells = &Scratch->FrontierCells;
+    TArray<int32>* NextCells = &Scratch->NextCells;
+
+    // Every cell that got a non-zero word, to zero it again on the way out
+    TArray<int32>& TouchedCells = Scratch->TouchedCells;
+
+    auto Search = [&]()
+    {
+        for (int32 Lane = 0; Lane < SourceIndices.Num(); ++Lane)
+        {
+            const int32 Cell = SourceIndices[Lane];
+            if (Cell == INDEX_NONE)
+            {
+                continue;
+            }
+
+            if ((*Frontier)[Cell] == 0)
+            {
+                FrontierCells->Add(Cell);
+                TouchedCells.Add(Cell);
+            }
+            (*Frontier)[Cell] |= uint64(1) << Lane;
+        }
+
+        for (const int32 Cell : *FrontierCells)
+        {
+            Seen[Cell] = (*Frontier)[Cell];
+            if (!Visit(Cell, (*Frontier)[Cell], 0))
+            {
+                return;
+            }
+        }
+
+        const int32 IndexOffsets[] = { 1, -1, MazeSize.X, -MazeSize.X };
+
+        for (int32 Distance = 1; FrontierCells->Num() > 0; ++Distance)
+        {
+            // Expand: one OR per neighbour moves every lane on this cell at once
+            for (const int32 Cell : *FrontierCells)
+            {
+                const uint64 Lanes = (*Frontier)[Cell];
+                (*Frontier)[Cell] = 0;
+
+                const int32 CellX = Cell % MazeSize.X;
+                for (int32 Dir = 0; Dir < 4; ++Dir)
+                {
+                    if ((Dir == 0 && CellX == MazeSize.X - 1) || (Dir == 1 && CellX == 0))
+                    {
+                        continue;
+                    }
+
+                    const int32 Neighbor = Cell + IndexOffsets[Dir];
+                    if (Neighbor < 0 || Neighbor >= NumCells || !Walkable[Neighbor])
+                    {
+                        continue;
+                    }
+
+                    const uint64 Arriving = Lanes & ~Seen[Neighbor];
+                    if (Arriving)
+                    {
+                        if ((*Next)[Neighbor] == 0)
+                        {
+                            NextCells->Add(Neighbor);
+                            if (Seen[Neighbor] == 0)
+                            {
+                                TouchedCells.Add(Neighbor);
+                            }
+                        }
+                        (*Next)[Neighbor] |= Arriving;
+                    }
+                }
+            }
+
+            // Settle: lanes arriving this level are at Distance
+            for (const int32 Cell : *NextCells)
+            {
+                Seen[Cell] |= (*Next)[Cell];
+                if (!Visit(Cell, (*Next)[Cell], Distance))
+                {
+                    return;
+                }
+            }
+
+            // Frontier is all zero again, so it becomes the next Next
+            Swap(Frontier, Next);
+            Swap(FrontierCells, NextCells);
+            NextCells->Reset();
+        }
+    };
+    Search();
+
+    for (const int32 Cell : TouchedCells)
+    {
+        Seen[Cell] = 0;
+        Scratch->Frontier[Cell] = 0;
+        Scratch->Next[Cell] = 0;
+    }
+    TouchedCells.Reset();
+    Scratch->FrontierCells.Reset();
+    Scratch->NextCells.Reset();
+
+    FScopeLock Lock(&BFSScratchLock);
+    BFSScratchPool.Add(MoveTemp(Scratch));
+}
+
+bool UMazePathfinder::BuildDistanceFields(TArrayView<const FIntPoint> Sources, TArray<TArray<int32>>& OutFields) const
+{
+    const int32 NumCells = MazeSize.X * MazeSize.Y;
+    const int32 NumSources = Sources.Num();
+
+    OutFields.SetNum(NumSources);
+    for (TArray<int32>& Field : OutFields)
+    {
+        Field.Init(INDEX_NONE, NumCells);
+    }
+
+    if (!bIsInitialized)
+    {
+        return false;
+    }
+
+    TArray<int32> SourceIndices;
+    SourceIndices.Init(INDEX_NONE, NumSources);
+    bool bAnyValid = false;
+    for (int32 i = 0; i < NumSources; ++i)
+    {
+        if (IsValidCell(Sources[i]))
+        {
+            SourceIndices[i] = GridToIndex(Sources[i]);
+            bAnyValid = true;
+        }
+    }
+
+    const int32 NumBatches = FMath::DivideAndRoundUp(NumSources, 64);
+    ParallelFor(NumBatches, [&](int32 Batch)
+    {
+        const int32 First = Batch * 64;
+        const TArrayView<const int32> BatchSources = TArrayView<const int32>(SourceIndices).Slice(First, FMath::Min(64, NumSources - First));
+
+        RunMultiSourceBFS(BatchSources, [&](int32 Cell, uint64 Lanes, int32 Distance)
+        {
+            while (Lanes)
+            {
+                const int32 Lane = static_cast<int32>(FMath::CountTrailingZeros64(Lanes));
+                Lanes &= Lanes - 1;
+                OutFields[First + Lane][Cell] = Distance;
+            }
+            return true;
+        });
+    });
+
+    return bAnyValid;
+}
+
+void UMazePathfinder::BuildDistanceMatrix(TArrayView<const FIntPoint> Points, TArray<int32>& OutMatrix) const
+{
+    const int32 Num = Points.Num();
+    OutMatrix.Init(INDEX_NONE, Num * Num);
+
+    if (!bIsInitialized || Num == 0)
+    {
+        return;
+    }
+
+    // Which points sit on each cell (several may share one)
+    TMultiMap<int32, int32> PointsAtCell;
+    TArray<int32> PointIndices;
+    PointIndices.Init(INDEX_NONE, Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (IsValidCell(Points[i]))
+        {
+            PointIndices[i] = GridToIndex(Points[i]);
+            PointsAtCell.Add(PointIndices[i], i);
+        }
+    }
+
+    const int32 NumValid = PointsAtCell.Num();
+    const int32 NumBatches = FMath::DivideAndRoundUp(Num, 64);
+
+    ParallelFor(NumBatches, [&](int32 Batch)
+    {
+        const int32 First = Batch * 64;
+        const TArrayView<const int32> BatchSources = TArrayView<const int32>(PointIndices).Slice(First, FMath::Min(64, Num - First));
+
+        int32 Remaining = 0;
+        for (const int32 Source : BatchSources)
+        {
+            Remaining += Source != INDEX_NONE ? NumValid : 0;
+        }
+
+        RunMultiSourceBFS(BatchSources, [&](int32 Cell, uint64 Lanes, int32 Distance)
+        {
+            for (auto It = PointsAtCell.CreateConstKeyIterator(Cell); It; ++It)
+            {
+                for (uint64 Bits = Lanes; Bits; Bits &= Bits - 1)
+                {
+                    const int32 Lane = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+                    OutMatrix[(First + Lane) * Num + It.Value()] = Distance;
+                    --Remaining;
+                }
+            }
+
+            // Every source has reached every point
+            return Remaining > 0;
+        });
+    });
+}
+
+float UMazePathfinder::BenchmarkDistanceFields(int32 NumSources, int32 Seed)
+{
+    TArray<FIntPoint> FloorCells;
+    for (int32 i = 0; i < Walkable.Num(); ++i)
+    {
+        if (Walkable[i])
+        {
+            FloorCells.Add(IndexToGrid(i));
+        }
+    }
+
+    if (!bIsInitialized || FloorCells.Num() == 0 || NumSources <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: Distance field benchmark needs an initialized maze"));
+        return 0.0f;
+    }
+
+    FRandomStream Random(Seed);
+    TArray<FIntPoint> Sources;
+    for (int32 i = 0; i < NumSources; ++i)
+    {
+        Sources.Add(FloorCells[Random.RandRange(0, FloorCells.Num() - 1)]);
+    }
+
+    // Up to 64 sources the bit-parallel side is a single thread too
+    double StartTime = FPlatformTime::Seconds();
+    TArray<int32> Single;
+    for (const FIntPoint& Source : Sources)
+    {
+        BuildDistanceField({ Source }, Single);
+    }
+    const double SingleMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    TArray<TArray<int32>> Fields;
+    BuildDistanceFields(Sources, Fields);
+    const double BatchMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    const float Speedup = BatchMs > 0.0 ? static_cast<float>(SingleMs / BatchMs) : 0.0f;
+
+    UE_LOG(LogTemp, Log, TEXT("MazePathfinder: %d distance fields on %dx%d: %.2f ms one BFS each, %.2f ms bit-parallel (%.1fx)"),
+        NumSources, MazeSize.X, MazeSize.Y, SingleMs, BatchMs, Speedup);
+
+    return Speedup;
+}
+
+float UMazePathfinder::BenchmarkWorldToGridBatch(int32 NumPositions, int32 NumPasses, int32 Seed)
+{
+    if (!bIsInitialized || NumPositions <= 0 || NumPasses <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePathfinder: World-to-grid benchmark needs an initialized maze"));
+        return 0.0f;
+    }
+
+    // Pathfinder space is maze-local, so the matching projection is the identity
+    const FMazeGridProjection Projection = FMazeGridProjection::Make(FTransform::Identity, CellSize);
+
+    // A margin of 10% outside the grid exercises the INDEX_NONE lanes too
+    FRandomStream Random(Seed);
+    const float ExtentX = MazeSize.X * CellSize;
+    const float ExtentY = MazeSize.Y * CellSize;
+    TArray<float> WorldX;
+    TArray<float> WorldY;
+    WorldX.SetNumUninitialized(NumPositions);
+    WorldY.SetNumUninitialized(NumPositions);
+    for (int32 i = 0; i < NumPositions; ++i)
+    {
+        WorldX[i] = Random.FRandRange(-0.1f * ExtentX, 1.1f * ExtentX);
+        WorldY[i] = Random.FRandRange(-0.1f * ExtentY, 1.1f * ExtentY);
+    }
+
+    // Per-call path: what a crowd would do without the batch
+    TArray<int32> SingleIndices;
+    TArray<uint8> SingleWalkable;
+    SingleIndices.SetNumUninitialized(NumPositions);
+    SingleWalkable.SetNumUninitialized(NumPositions);
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        for (int32 i = 0; i < NumPositions; ++i)
+        {
+            const FIntPoint Cell = WorldToGrid(FVector(WorldX[i], WorldY[i], 0.0f));
+            const bool bInside = Cell.X >= 0 && Cell.X < MazeSize.X && Cell.Y >= 0 && Cell.Y < MazeSize.Y;
+            SingleIndices[i] = bInside ? GridToIndex(Cell) : INDEX_NONE;
+            SingleWalkable[i] = IsValidCell(Cell) ? 1 : 0;
+        }
+    }
+    const double SingleMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TArray<int32> BatchIndices;
+    TArray<uint8> BatchWalkable;
+    BatchIndices.SetNumUninitialized(NumPositions);
+    BatchWalkable.SetNumUninitialized(NumPositions);
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        WorldToGridBatch(Projection, WorldX, WorldY, BatchIndices, BatchWalkable);
+    }
+    const double BatchMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    // Float vs double rounding can split a position lying exactly on a cell edge
+    int32 NumMismatches = 0;
+    for (int32 i = 0; i < NumPositions; ++i)
+    {
+        if (SingleIndices[i] != BatchIndices[i] || SingleWalkable[i] != BatchWalkable[i])
+        {
+            ++NumMismatches;
+        }
+    }
+
+    const float Speedup = BatchMs > 0.0 ? static_cast<float>(SingleMs / BatchMs) : 0.0f;
+
+    UE_LOG(LogTemp, Log, TEXT("MazePathfinder: %d x %d world-to-grid conversions on %dx%d: %.3f ms one call each, %.3f ms batched (%.1fx), %d mismatches"),
+        NumPasses, NumPositions, MazeSize.X, MazeSize.Y, SingleMs, BatchMs, Speedup, NumMismatches);
+
+    return Speedup;
+}
+
+FMazeGridProjection FMazeGridProjection::Make(const FTransform& MazeTransform, float CellSize)
+{
+    // Sample the inverse transform at the origin and along each world axis
+    const FVector Origin = MazeTransform.InverseTransformPosition(FVector::ZeroVector);
+    const FVector AxisX = MazeTransform.InverseTransformPosition(FVector(1.0, 0.0, 0.0)) - Origin;
+    const FVector AxisY = MazeTransform.InverseTransformPosition(FVector(0.0, 1.0, 0.0)) - Origin;
+
+    const double InvCellSize = 1.0 / FMath::Max(CellSize, 1.0f);
+
+    FMazeGridProjection Projection;
+    Projection.XFromWorldX = static_cast<float>(AxisX.X * InvCellSize);
+    Projection.XFromWorldY = static_cast<float>(AxisY.X * InvCellSize);
+    Projection.XOffset = static_cast<float>(Origin.X * InvCellSize);
+    Projection.YFromWorldX = static_cast<float>(AxisX.Y * InvCellSize);
+    Projection.YFromWorldY = static_cast<float>(AxisY.Y * InvCellSize);
+    Projection.YOffset = static_cast<float>(Origin.Y * InvCellSize);
+    return Projection;
+}
+
+void UMazePathfinder::WorldToGridBatch(const FMazeGridProjection& Projection,
+    TArrayView<const float> WorldX, TArrayView<const float> WorldY,
+    TArrayView<int32> OutCellIndices, TArrayView<uint8> OutWalkable) const
+{
+    const int32 Num = FMath::Min(WorldX.Num(), WorldY.Num());
+    check(OutCellIndices.Num() >= Num && OutWalkable.Num() >= Num);
+
+    if (!bIsInitialized)
+    {
+        for (int32 i = 0; i < Num; ++i)
+        {
+            OutCellIndices[i] = INDEX_NONE;
+            OutWalkable[i] = 0;
+        }
+        return;
+    }
+
+    const float* RESTRICT InX = WorldX.GetData();
+    const float* RESTRICT InY = WorldY.GetData();
+    int32* RESTRICT OutIndex = OutCellIndices.GetData();
+    uint8* RESTRICT OutFloor = OutWalkable.GetData();
+    const uint8* RESTRICT WalkableData = Walkable.GetData();
+
+    //=========================================================================
+    // SIMD: 4 positions per iteration
+    //   grid = floor(M * world + offset)
+    //   index = inside ? Y * SizeX + X : -1
+    //=========================================================================
+
+    const VectorRegister4Float XFromX = VectorSetFloat1(Projection.XFromWorldX);
+    const VectorRegister4Float XFromY = VectorSetFloat1(Projection.XFromWorldY);
+    const VectorRegister4Float XOffset = VectorSetFloat1(Projection.XOffset);
+    const VectorRegister4Float YFromX = VectorSetFloat1(Projection.YFromWorldX);
+    const VectorRegister4Float YFromY = VectorSetFloat1(Projection.YFromWorldY);
+    const VectorRegister4Float YOffset = VectorSetFloat1(Projection.YOffset);
+
+    const VectorRegister4Int SizeX = VectorIntSet1(MazeSize.X);
+    const VectorRegister4Int SizeY = VectorIntSet1(MazeSize.Y);
+    const VectorRegister4Int Zero = GlobalVectorConstants::IntZero;
+    const VectorRegister4Int MinusOne = GlobalVectorConstants::IntMinusOne;
+
+    int32 i = 0;
+    for (; i + 4 <= Num; i += 4)
+    {
+        const VectorRegister4Float PX = VectorLoad(InX + i);
+        const VectorRegister4Float PY = VectorLoad(InY + i);
+
+        const VectorRegister4Float GX = VectorFloor(VectorMultiplyAdd(PX, XFromX, VectorMultiplyAdd(PY, XFromY, XOffset)));
+        const VectorRegister4Float GY = VectorFloor(VectorMultiplyAdd(PX, YFromX, VectorMultiplyAdd(PY, YFromY, YOffset)));
+
+        const VectorRegister4Int CellX = VectorFloatToInt(GX);
+        const VectorRegister4Int CellY = VectorFloatToInt(GY);
+
+        const VectorRegister4Int Inside = VectorIntAnd(
+            VectorIntAnd(VectorIntCompareGE(CellX, Zero), VectorIntCompareLT(CellX, SizeX)),
+            VectorIntAnd(VectorIntCompareGE(CellY, Zero), VectorIntCompareLT(CellY, SizeY)));
+
+        const VectorRegister4Int Index = VectorIntSelect(Inside,
+            VectorIntAdd(VectorIntMultiply(CellY, SizeX), CellX), MinusOne);
+
+        VectorIntStore(Index, OutIndex + i);
+
+        // Walkability is a gather: no SSE2 instruction for it, do it per lane
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            const int32 CellIndex = OutIndex[i + Lane];
+            OutFloor[i + Lane] = CellIndex >= 0 ? WalkableData[CellIndex] : 0;
+        }
+    }
+
+    // Scalar tail (same math)
+    for (; i < Num; ++i)
+    {
+        const int32 CellX = FMath::FloorToInt32(InX[i] * Projection.XFromWorldX + InY[i] * Projection.XFromWorldY + Projection.XOffset);
+        const int32 CellY = FMath::FloorToInt32(InX[i] * Projection.YFromWorldX + InY[i] * Projection.YFromWorldY + Projection.YOffset);
+        const bool bInside = CellX >= 0 && CellX < MazeSize.X && CellY >= 0 && CellY < MazeSize.Y;
+
+        OutIndex[i] = bInside ? CellY * MazeSize.X + CellX : INDEX_NONE;
+        OutFloor[i] = bInside ? WalkableData[OutIndex[i]] : 0;
+    }
+}
+
+FIntPoint UMazePathfinder::IndexToGrid(int32 Index) const
+{
+    return FIntPoint(Index % MazeSize.X, Index / MazeSize.X);
 }
 
 int32 UMazePathfinder::GridToIndex(FIntPoint GridPos) const
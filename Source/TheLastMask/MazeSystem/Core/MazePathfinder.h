@@ -10,19 +10,27 @@
 /*=============================================================================
     UNREAL ENGINE CONCEPTS EXPLAINED:
     
-    TQueue<T>:
-        - UE's FIFO queue implementation
-        - Used in BFS (Breadth-First Search) algorithm
-        - Enqueue() adds to back, Dequeue() removes from front
+    TArray::HeapPush / HeapPop:
+        - Turn a plain TArray into a binary min-heap (uses operator<)
+        - Used as the A* open list: cheapest cell first
     
-    TMap<K, V>:
-        - UE's hash map (like std::unordered_map)
-        - TMap<FIntPoint, FIntPoint> maps grid positions
-        - Used here to track "parent" cells for path reconstruction
+    ParallelFor(Num, Lambda):
+        - Runs Lambda(0..Num-1) across the task graph worker threads
+        - Used to compute the landmark distance fields side by side
     
     INDEX_NONE:
         - UE constant equal to -1
         - Convention for "invalid index" or "not found"
+    
+    VectorRegister4Float / VectorRegister4Int:
+        - UE's portable SIMD types (SSE on x64, NEON on ARM)
+        - VectorLoad / VectorMultiplyAdd / VectorIntStore work on 4 lanes at once
+    
+    ROOM LATTICE:
+        - Generated mazes put rooms on even cells (2X, 2Y) and carve one
+          connector cell between linked rooms
+        - Searching rooms and stepping over connectors visits a quarter of
+          the cells; connectors are filled back in when writing the path
 =============================================================================*/
 
 /**
@@ -58,10 +66,107 @@ struct FMazePathResult
 };
 
 /**
- * Handles pathfinding through the maze using BFS.
+ * Affine map from world XY straight to (fractional) grid coordinates.
+ * Folds the inverse actor transform and the division by CellSize into
+ * six floats, so bulk conversion is two multiply-adds per axis.
  * 
- * BFS (Breadth-First Search) guarantees the shortest path
- * in an unweighted grid, which is exactly what we need.
+ * Assumes the maze actor is only yawed (no pitch/roll), which is how
+ * mazes are placed: world Z never affects the cell.
+ */
+struct FMazeGridProjection
+{
+    float XFromWorldX = 1.0f;
+    float XFromWorldY = 0.0f;
+    float XOffset = 0.0f;
+    float YFromWorldX = 0.0f;
+    float YFromWorldY = 1.0f;
+    float YOffset = 0.0f;
+
+    /** Build from the maze actor transform and cell size */
+    static FMazeGridProjection Make(const FTransform& MazeTransform, float CellSize);
+};
+
+/**
+ * Pathfinding benchmark numbers (see UMazePathfinder::BenchmarkPathfinding).
+ */
+USTRUCT(BlueprintType)
+struct FMazePathBenchmarkResult
+{
+    GENERATED_BODY()
+
+    /** Random start/end pairs searched */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    int32 NumQueries = 0;
+
+    /** Landmarks in use */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    int32 NumLandmarks = 0;
+
+    /** Time spent in BuildLandmarks */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double LandmarkBuildMs = 0.0;
+
+    /** Heap memory of the landmark distance fields (0 when mapped from a sidecar) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    int32 LandmarkMemoryBytes = 0;
+
+    /** Average cells expanded per query, Manhattan heuristic */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double ManhattanNodesExpanded = 0.0;
+
+    /** Average cells expanded per query, landmark heuristic */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double LandmarkNodesExpanded = 0.0;
+
+    /** Total search time, Manhattan heuristic */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double ManhattanMs = 0.0;
+
+    /** Total search time, landmark heuristic */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double LandmarkMs = 0.0;
+
+    /** Was the room lattice usable for this grid? */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    bool bRoomLattice = false;
+
+    /** Average rooms expanded per query, room lattice search */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double LatticeNodesExpanded = 0.0;
+
+    /** Total search time, room lattice search */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double LatticeMs = 0.0;
+
+    /** Memory of the per-cell search buffers */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    int32 CellSearchMemoryBytes = 0;
+
+    /** Memory of the room links and per-room search buffers */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    int32 LatticeMemoryBytes = 0;
+
+    /** Average time of one uncached FindAlternativePaths with K = 3 */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double AlternativePathsMs = 0.0;
+
+    /** Average routes FindAlternativePaths returned (K = 3) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Pathfinding")
+    double AlternativePathsFound = 0.0;
+};
+
+class FMazeGridSidecar;
+
+/**
+ * Handles pathfinding through the maze using A*.
+ * 
+ * All steps cost the same, so A* with an admissible heuristic returns the
+ * same shortest paths BFS would, while expanding fewer cells. Call
+ * BuildLandmarks once after Initialize to switch the heuristic from
+ * Manhattan distance to ALT landmarks (much tighter on looped mazes).
+ * 
+ * When the grid has the generator's room layout, FindPath searches the
+ * room lattice instead of the cell grid (see SetRoomLatticeEnabled).
  */
 UCLASS(BlueprintType)
 class THELASTMASK_API UMazePathfinder : public UObject
@@ -82,9 +187,27 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
     void Initialize(const TArray<FMazeCell>& InCells, FIntPoint InMazeSize, float InCellSize);
 
+    /**
+     * Initialize from a mapped sidecar file (see FMazeGridSidecar).
+     * The walkable plane is copied (runtime edits write to it); the
+     * landmark plane is read in place, so no BuildLandmarks is needed.
+     * The pathfinder keeps the sidecar mapped until the next Initialize.
+     * 
+     * @param Sidecar - An open sidecar
+     * @param InCellSize - World size of each cell in centimeters
+     */
+    void InitializeFromSidecar(const TSharedRef<FMazeGridSidecar>& Sidecar, float InCellSize);
+
+    /**
+     * Write the current walkable grid and landmarks (if valid for it)
+     * to a sidecar file.
+     */
+    bool WriteSidecar(const FString& Filename, FString& OutError) const;
+
     /**
      * Find path between two grid coordinates.
-     * Uses BFS to guarantee shortest path.
+     * Uses A* (ALT heuristic if landmarks are built) for the shortest path,
+     * over the room lattice when it is usable, else over every cell.
      * 
      * @param Start - Starting grid position
      * @param End - Target grid position
@@ -93,6 +216,25 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
     FMazePathResult FindPath(FIntPoint Start, FIntPoint End);
 
+    /**
+     * Up to NumPaths different routes between two cells, shortest first.
+     * For flanking: send each enemy down a different one.
+     * 
+     * Penalty iterations: after each route is found, stepping onto one of
+     * its cells costs extra, so the next search takes a detour wherever
+     * the maze offers a cheap one (loops). Routes that still mostly
+     * overlap an earlier one are dropped. On a perfect maze (no loops)
+     * this returns a single route.
+     * 
+     * Searches the cell grid (not the room lattice) and reuses the A*
+     * buffers. Cached per (Start, End) until the grid hash changes.
+     * 
+     * @param NumPaths - K, at most 8
+     * @return 0..K routes; PathLength is the real cell count
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    TArray<FMazePathResult> FindAlternativePaths(FIntPoint Start, FIntPoint End, int32 NumPaths = 3);
+
     /**
      * Find path from a world position to a grid coordinate.
      * Converts world position to nearest walkable grid cell.
@@ -141,16 +283,299 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
     FIntPoint FindNearestWalkableCell(FIntPoint GridPosition) const;
 
-protected:
-    /** Get the 1D index into CachedCells from 2D grid position */
+    /**
+     * Visit every floor cell in line of sight of Origin, up to Radius cells away.
+     * 
+     * Casts one Bresenham ray to each cell on the square around Origin.
+     * Walls block, and so does a diagonal step between two walls (no peeking
+     * through the corner where they touch). Cells near Origin are visited
+     * by several rays. Read-only, so safe on worker threads.
+     * 
+     * @param Origin - Viewer cell (nothing is visited if it is a wall)
+     * @param Visit - Called per visible cell, Origin included
+     */
+    void ForEachVisibleCell(FIntPoint Origin, int32 Radius, TFunctionRef<void(FIntPoint)> Visit) const;
+
+    /**
+     * Can A see B along an unbroken row or column? O(1): two integer
+     * compares on the corridor run IDs. False for diagonal pairs.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Pathfinding")
+    bool HasStraightLineOfSight(FIntPoint A, FIntPoint B) const;
+
+    /**
+     * Can A see B? Same rules as ForEachVisibleCell.
+     * 
+     * Same row or column: answered by HasStraightLineOfSight. Otherwise
+     * (rooms, diagonals) one grid ray is traced.
+     * 
+     * @param MaxDistance - Cells; 0 = unlimited
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Pathfinding")
+    bool HasLineOfSight(FIntPoint A, FIntPoint B, int32 MaxDistance = 0) const;
+
+    /**
+     * Horizontal run ID of a cell: equal for floor cells in the same
+     * unbroken stretch of a row, INDEX_NONE for walls. Kept up to date by
+     * SetCellWalkable. (The ID is the index of the run's first cell.)
+     */
+    int32 GetRowRunId(FIntPoint Cell) const;
+
+    /** Vertical run ID, as GetRowRunId for columns */
+    int32 GetColumnRunId(FIntPoint Cell) const;
+
+    /**
+     * Compute the maze distance from the nearest source to every cell.
+     * Multi-source BFS: all sources start at distance 0.
+     * 
+     * Run this once when a target changes, then answer "how far is X?"
+     * with a single array read instead of a path search.
+     * 
+     * @param Sources - Walkable cells to measure from (invalid ones are skipped)
+     * @param OutDistances - One entry per cell (Index = Y * SizeX + X),
+     *                       INDEX_NONE for walls and unreachable cells
+     * @return True if at least one source was valid
+     */
+    bool BuildDistanceField(const TArray<FIntPoint>& Sources, TArray<int32>& OutDistances) const;
+
+    /**
+     * Visit every floor cell within MaxSteps walking steps of Origin, in
+     * BFS order. Only the reached area is touched (no per-grid arrays), so
+     * the cost follows MaxSteps, not the maze size.
+     * 
+     * @param Origin - Start cell (nothing is visited if it is a wall)
+     * @param Visit - Called with each cell and its step count, Origin first
+     */
+    void ForEachCellWithinSteps(FIntPoint Origin, int32 MaxSteps, TFunctionRef<void(FIntPoint, int32)> Visit) const;
+
+    /**
+     * One distance field per source (not nearest-source like BuildDistanceField).
+     * 
+     * Bit-parallel multi-source BFS: each source is one bit in a 64-bit
+     * word per cell, and all sources advance together. Up to 64 fields
+     * cost roughly one pass over the cells each lands on; more sources run
+     * in parallel batches of 64.
+     * 
+     * @param Sources - Cells to measure from (invalid ones get an all-INDEX_NONE field)
+     * @param OutFields - One field per source, layout as BuildDistanceField
+     * @return True if at least one source was valid
+     */
+    bool BuildDistanceFields(TArrayView<const FIntPoint> Sources, TArray<TArray<int32>>& OutFields) const;
+
+    /**
+     * Maze distance between every pair of points (keys, pickups, the player).
+     * 
+     * One bit-parallel BFS per 64 points (see BuildDistanceFields). It
+     * stops as soon as every point has been reached from every source, so
+     * close clusters cost far less than full distance fields.
+     * 
+     * @param Points - Cells to measure between
+     * @param OutMatrix - Num x Num, row-major: [From * Num + To].
+     *                    INDEX_NONE if either cell is a wall or they are not connected.
+     */
+    void BuildDistanceMatrix(TArrayView<const FIntPoint> Points, TArray<int32>& OutMatrix) const;
+
+    /**
+     * Convert many world positions to cells at once (crowds, AI agents).
+     * 
+     * Input is structure-of-arrays so four positions are processed per SIMD
+     * instruction; only the final walkable lookup is scalar (a gather).
+     * 
+     * @param Projection - World -> grid map (see AMazeManager::GetGridProjection)
+     * @param WorldX - World X of each position
+     * @param WorldY - World Y of each position (same length as WorldX)
+     * @param OutCellIndices - Y * SizeX + X per position, INDEX_NONE if outside the grid
+     * @param OutWalkable - 1 if the cell is floor, else 0
+     */
+    void WorldToGridBatch(const FMazeGridProjection& Projection,
+        TArrayView<const float> WorldX, TArrayView<const float> WorldY,
+        TArrayView<int32> OutCellIndices, TArrayView<uint8> OutWalkable) const;
+
+    /** Is the cell at this flat index walkable? (no bounds check) */
+    bool IsWalkableIndex(int32 Index) const { return Walkable[Index] != 0; }
+
+    /**
+     * Runtime edit: make one cell floor or wall. O(1), updates the grid hash.
+     * 
+     * Landmarks built for another layout stop being used until the grid
+     * hash matches again (undoing the edit) or BuildLandmarks runs.
+     * 
+     * @return True if the cell changed
+     */
+    bool SetCellWalkable(FIntPoint GridPosition, bool bWalkable);
+
+    /**
+     * Zobrist hash of the runtime grid (see FMazeGridHash).
+     * Equal to UMazeGridData::GetGridHash for the same layout.
+     */
+    uint64 GetGridHash() const { return GridHash; }
+
+    /** Walkability per cell, 1 = floor (Index = Y * SizeX + X) */
+    const TArray<uint8>& GetWalkableGrid() const { return Walkable; }
+
+    /**
+     * Precompute landmark distance fields for the ALT heuristic.
+     * 
+     * Landmarks are chosen by farthest-point selection; their BFS fields
+     * are computed in parallel and stored as uint16 (2 * K bytes per cell).
+     * Initialize clears them, so call this again after re-initializing
+     * (InitializeFromSidecar maps stored ones instead).
+     * 
+     * @param NumLandmarks - K; 4-8 is plenty for mazes, 0 disables ALT
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    void BuildLandmarks(int32 NumLandmarks);
+
+    /** Drop landmarks (A* falls back to Manhattan distance) */
+    void ClearLandmarks();
+
+    /** Landmark cells in use */
+    const TArray<FIntPoint>& GetLandmarks() const { return Landmarks; }
+
+    /** Are landmarks built for the current layout? (ALT is used only then) */
+    bool HasValidLandmarks() const { return Landmarks.Num() > 0 && LandmarkGridHash == GridHash; }
+
+    /** Cells (or rooms, for a lattice search) expanded by the most recent search */
+    int32 GetLastNodesExpanded() const { return LastNodesExpanded; }
+
+    /**
+     * Allow FindPath to search the room lattice. On by default.
+     * The lattice is still only used while CanUseRoomLattice is true.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    void SetRoomLatticeEnabled(bool bEnabled) { bRoomLatticeEnabled = bEnabled; }
+
+    /**
+     * Is the grid a room lattice FindPath can search?
+     * 
+     * True when every floor cell is either a room (both coordinates even)
+     * or a connector between two floor rooms. Generated and baked mazes
+     * are; painting or runtime edits can break it (and undoing them
+     * restores it), in which case searches run on the cell grid.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    bool CanUseRoomLattice() const { return bRoomLatticeEnabled && bIsInitialized && RoomLinks.Num() > 0 && LatticeViolations == 0; }
+
+    /** Rooms along X and Y ((SizeX + 1) / 2, (SizeY + 1) / 2) */
+    FIntPoint GetRoomGridSize() const { return RoomGridSize; }
+
+    /**
+     * EMazeDirection bits per room (Index = RoomY * RoomsX + RoomX): the
+     * connector on that side is floor. Same layout as the generator's
+     * direction grid.
+     */
+    const TArray<uint8>& GetRoomLinks() const { return RoomLinks; }
+
+    /**
+     * Time random queries with the Manhattan and the landmark heuristic,
+     * and log preprocessing cost, memory and expanded cells.
+     * 
+     * @param NumQueries - Random floor-to-floor searches per heuristic
+     * @param Seed - Seed for picking the pairs (same pairs for both runs)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    FMazePathBenchmarkResult BenchmarkPathfinding(int32 NumQueries = 1000, int32 Seed = 1);
+
+    /**
+     * Time BuildDistanceFields against one BuildDistanceField per source
+     * (same random floor cells) and log both.
+     * 
+     * @return How many times faster the bit-parallel BFS was
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    float BenchmarkDistanceFields(int32 NumSources = 64, int32 Seed = 1);
+
+    /**
+     * Time WorldToGridBatch against one WorldToGrid + IsValidCell per
+     * position (same random positions, some outside the grid), check both
+     * agree and log both.
+     * 
+     * @param NumPositions - Positions converted per pass
+     * @param NumPasses - Passes per side (short batches are too quick to time once)
+     * @return How many times faster the batch was
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pathfinding")
+    float BenchmarkWorldToGridBatch(int32 NumPositions = 10000, int32 NumPasses = 20, int32 Seed = 1);
+
+    /** Has Initialize been called with valid data? */
+    bool IsInitialized() const { return bIsInitialized; }
+
+    /** Get the grid dimensions */
+    FIntPoint GetMazeSize() const { return MazeSize; }
+
+    /** Get the 1D cell index from 2D grid position (no bounds check) */
     int32 GridToIndex(FIntPoint GridPos) const;
 
+    /** Get the 2D grid position of a 1D cell index */
+    FIntPoint IndexToGrid(int32 Index) const;
+
+protected:
+
     /** Get neighbors of a cell that are walkable */
     TArray<FIntPoint> GetWalkableNeighbors(FIntPoint GridPos) const;
 
+    /**
+     * A* between two walkable cell indices (no validation, no logging).
+     * 
+     * @param bUseLandmarks - ALT heuristic if true, else Manhattan
+     * @param OutPath - Start..End cells on success
+     * @param StepPenalty - Optional extra cost of entering each cell (one per cell)
+     * @return True if End was reached
+     */
+    bool SearchPath(int32 StartIndex, int32 EndIndex, bool bUseLandmarks, TArray<FIntPoint>& OutPath, const uint16* StepPenalty = nullptr);
+
+    /**
+     * A* over the room lattice between two walkable cell indices. Either
+     * end may be a connector. Only valid while CanUseRoomLattice is true.
+     * 
+     * @param bUseLandmarks - ALT heuristic if true, else Manhattan
+     * @param OutPath - Start..End cells on success, connectors included
+     * @return True if End was reached
+     */
+    bool SearchRoomLattice(int32 StartIndex, int32 EndIndex, bool bUseLandmarks, TArray<FIntPoint>& OutPath);
+
+    /** Derive room links and count lattice violations from Walkable */
+    void BuildRoomLattice();
+
+    /** Is this cell floor but neither a room nor a connector between two floor rooms? */
+    bool IsLatticeViolation(int32 X, int32 Y) const;
+
+    /** Recompute the link bits of one room from its four connectors */
+    void UpdateRoomLinks(int32 RoomX, int32 RoomY);
+
+    /**
+     * Bit-parallel BFS from up to 64 cell indices (lane i = SourceIndices[i],
+     * INDEX_NONE entries are skipped). Visit is called once per reached cell
+     * per distance, with the lanes that first got there at that distance.
+     * Return false from Visit to stop early. Read-only, safe on workers.
+     * Scratch comes from BFSScratchPool and only the cells reached are
+     * cleared afterwards, so an early stop costs what it visited.
+     */
+    void RunMultiSourceBFS(TArrayView<const int32> SourceIndices, TFunctionRef<bool(int32 /*Cell*/, uint64 /*Lanes*/, int32 /*Distance*/)> Visit) const;
+
+    /**
+     * Bresenham ray from Origin towards Target (see ForEachVisibleCell for
+     * the blocking rules). Visit is called for every cell after Origin.
+     * 
+     * @return True if Target was reached
+     */
+    bool TraceGridRay(FIntPoint Origin, FIntPoint Target, int32 RadiusSquared, TFunctionRef<void(FIntPoint)> Visit) const;
+
+    /** Label every floor cell with its row and column run */
+    void BuildCorridorRuns();
+
+    /** Relabel the row and column runs through one edited cell */
+    void UpdateCorridorRuns(int32 X, int32 Y);
+
+    /** max over landmarks of |d(L, Index) - d(L, Goal)| */
+    int32 GetLandmarkHeuristic(int32 Index, int32 GoalIndex) const;
+
 private:
-    /** Cached reference to maze cells */
-    TArray<FMazeCell> CachedCells;
+    /**
+     * Walkability per cell, 1 = floor (Index = Y * SizeX + X).
+     * One byte per cell instead of a full FMazeCell copy.
+     */
+    TArray<uint8> Walkable;
 
     /** Maze dimensions */
     FIntPoint MazeSize;
@@ -160,4 +585,139 @@ private:
 
     /** Is the pathfinder initialized with valid data? */
     bool bIsInitialized;
+
+    /** Zobrist hash of Walkable, kept in step by SetCellWalkable */
+    uint64 GridHash = 0;
+
+    //=========================================================================
+    // CORRIDOR RUNS (straight line of sight)
+    //=========================================================================
+
+    /** Per cell: index of the first cell of its horizontal run, INDEX_NONE on walls */
+    TArray<int32> RowRunIds;
+
+    /** Per cell: index of the first cell of its vertical run, INDEX_NONE on walls */
+    TArray<int32> ColumnRunIds;
+
+    //=========================================================================
+    // ALT LANDMARKS
+    //=========================================================================
+
+    /** Stored distance for "landmark can't reach this cell" */
+    static constexpr int32 UnreachableLandmarkDistance = MAX_uint16;
+
+    /** Landmark cells */
+    TArray<FIntPoint> Landmarks;
+
+    /** Distance from each landmark, cell-major: [Cell * K + Landmark] */
+    TArray<uint16> LandmarkDistances;
+
+    /** Distances the heuristic reads: LandmarkDistances or the mapped plane */
+    TArrayView<const uint16> LandmarkPlane;
+
+    /** Sidecar LandmarkPlane points into (null when built in memory) */
+    TSharedPtr<FMazeGridSidecar> MappedSidecar;
+
+    /** How long the last BuildLandmarks took */
+    double LandmarkBuildMs = 0.0;
+
+    /** Grid hash the landmark fields were computed on */
+    uint64 LandmarkGridHash = 0;
+
+    //=========================================================================
+    // SEARCH SCRATCH (reused between queries, never shrunk)
+    //=========================================================================
+
+    /** Open list entry. operator< orders the heap: lowest F first, deeper G on ties */
+    struct FOpenNode
+    {
+        int32 F;
+        int32 G;
+        int32 Index;
+
+        bool operator<(const FOpenNode& Other) const
+        {
+            return F < Other.F || (F == Other.F && G > Other.G);
+        }
+    };
+
+    TArray<FOpenNode> OpenHeap;
+
+    /** Best known cost from Start, valid when SearchStamps[i] == CurrentStamp */
+    TArray<int32> GScores;
+
+    /** Cell we came from, valid when SearchStamps[i] == CurrentStamp */
+    TArray<int32> Parents;
+
+    /** Search ID that last touched each cell (avoids clearing per query) */
+    TArray<uint32> SearchStamps;
+    uint32 CurrentStamp = 0;
+
+    /** Cells (or rooms) expanded by the last search */
+    int32 LastNodesExpanded = 0;
+
+    //=========================================================================
+    // ALTERNATIVE PATHS
+    //=========================================================================
+
+    /** Extra step cost per cell for the penalty iterations (zero between queries) */
+    TArray<uint16> StepPenalties;
+
+    /** Cells with a non-zero penalty, to reset only those */
+    TArray<int32> PenalizedCells;
+
+    struct FAlternativePathsEntry
+    {
+        /** K the routes were searched for (fewer routes = the maze has no more) */
+        int32 NumRequested = 0;
+        TArray<FMazePathResult> Paths;
+    };
+
+    /** Results per (Start << 32 | End), all for AlternativePathGridHash */
+    TMap<uint64, FAlternativePathsEntry> AlternativePathCache;
+    uint64 AlternativePathGridHash = 0;
+
+    //=========================================================================
+    // MULTI-SOURCE BFS SCRATCH (one per concurrent batch, pooled)
+    //=========================================================================
+
+    /** Per-cell lane words for RunMultiSourceBFS, all zero between calls */
+    struct FMultiSourceBFSScratch
+    {
+        TArray<uint64> Seen;
+        TArray<uint64> Frontier;
+        TArray<uint64> Next;
+
+        /** Every cell with a non-zero word, to zero only those afterwards */
+        TArray<int32> TouchedCells;
+
+        TArray<int32> FrontierCells;
+        TArray<int32> NextCells;
+    };
+
+    /** Idle scratch; ParallelFor batches each take one and put it back */
+    mutable TArray<TUniquePtr<FMultiSourceBFSScratch>> BFSScratchPool;
+    mutable FCriticalSection BFSScratchLock;
+
+    //=========================================================================
+    // ROOM LATTICE
+    //=========================================================================
+
+    /** Rooms along X and Y */
+    FIntPoint RoomGridSize = FIntPoint::ZeroValue;
+
+    /** EMazeDirection bits per room, kept in step by SetCellWalkable */
+    TArray<uint8> RoomLinks;
+
+    /** Floor cells that don't fit the lattice (usable only at 0) */
+    int32 LatticeViolations = 0;
+
+    /** May FindPath use the lattice? */
+    bool bRoomLatticeEnabled = true;
+
+    /** Per-room search scratch, same scheme as the per-cell buffers */
+    TArray<int32> RoomGScores;
+    TArray<int32> RoomParents;
+    TArray<uint32> RoomStamps;
+    uint32 CurrentRoomStamp = 0;
 };
@@ -0,0 +1,304 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazePlacement.h"
+#include "MazeGridData.h"
+#include "MazePathfinder.h"
+#include "Async/ParallelFor.h"
+#include "UObject/Package.h"
+
+namespace MazePlacement
+{
+    /** Best key for one exit candidate */
+    struct FCandidateResult
+    {
+        float Score = -1.0f;
+        int32 ExitIndex = INDEX_NONE;
+        int32 KeyIndex = INDEX_NONE;
+        int32 ExitDistance = 0;
+        float DetourRatio = 0.0f;
+        int32 KeyDistanceFromRoute = 0;
+    };
+
+    /** Index of the largest distance in a field (INDEX_NONE if all unreachable) */
+    int32 FindFarthest(const TArray<int32>& Distances)
+    {
+        int32 Best = INDEX_NONE;
+        for (int32 i = 0; i < Distances.Num(); ++i)
+        {
+            if (Distances[i] != INDEX_NONE && (Best == INDEX_NONE || Distances[i] > Distances[Best]))
+            {
+                Best = i;
+            }
+        }
+        return Best;
+    }
+
+    /**
+     * Cells walked from a dead end until the corridor opens into a junction
+     * or room. Corridors and corners have exactly two openings, so the walk
+     * never branches. Anything but a real dead end has depth 0.
+     *
+     * @param MaxSteps - Walk cap (cell count), so a corridor that loops back
+     *                   on itself can't walk forever
+     */
+    int32 MeasureDeadEndDepth(const FMazeDerivedData& Derived, FIntPoint DeadEnd, int32 MaxSteps)
+    {
+        if (Derived.GetTopology(DeadEnd) != EMazeCellTopology::DeadEnd)
+        {
+            return 0;
+        }
+
+        const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+        FIntPoint Previous(-1, -1);
+        FIntPoint Current = DeadEnd;
+        int32 Depth = 0;
+
+        while (Depth < MaxSteps)
+        {
+            FIntPoint Next(-1, -1);
+            for (const FIntPoint& Offset : Offsets)
+            {
+                const FIntPoint Neighbor = Current + Offset;
+                if (Neighbor != Previous && Derived.GetTopology(Neighbor) != EMazeCellTopology::Wall)
+                {
+                    Next = Neighbor;
+                    break;
+                }
+            }
+
+            if (Next.X < 0)
+            {
+                return Depth;
+            }
+
+            ++Depth;
+            const EMazeCellTopology NextTopology = Derived.GetTopology(Next);
+            if (NextTopology != EMazeCellTopology::Corridor && NextTopology != EMazeCellTopology::Corner)
+            {
+                return Depth;
+            }
+
+            Previous = Current;
+            Current = Next;
+        }
+
+        return Depth;
+    }
+}
+
+FMazePlacementResult FMazePlacementOptimizer::Optimize(const UMazeGridData& GridData, const FMazePlacementWeights& Weights)
+{
+    FMazePlacementResult Result;
+
+    if (!GridData.IsValid())
+    {
+        return Result;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const FIntPoint Size(GridData.SizeX, GridData.SizeY);
+    const int32 NumCells = Size.X * Size.Y;
+    const FMazeDerivedData& Derived = GridData.GetDerivedData();
+
+    // Transient pathfinder: its BFS is const and safe to run from workers
+    UMazePathfinder* Pathfinder = NewObject<UMazePathfinder>(GetTransientPackage());
+    Pathfinder->Initialize(GridData.Cells, Size, GridData.CellSize);
+
+    //=========================================================================
+    // DIAMETER (double BFS)
+    //=========================================================================
+
+    const int32 FirstFloor = GridData.Cells.IndexOfByPredicate([](const FMazeCell& Cell) { return Cell.bIsFloor; });
+    if (FirstFloor == INDEX_NONE)
+    {
+        return Result;
+    }
+
+    TArray<int32> SpawnField;
+    Pathfinder->BuildDistanceField({ Pathfinder->IndexToGrid(FirstFloor) }, SpawnField);
+    const int32 DiameterStart = MazePlacement::FindFarthest(SpawnField);
+
+    Pathfinder->BuildDistanceField({ Pathfinder->IndexToGrid(DiameterStart) }, SpawnField);
+    const int32 DiameterEnd = MazePlacement::FindFarthest(SpawnField);
+    Result.Diameter = SpawnField[DiameterEnd];
+
+    // Designer-placed spawn wins; otherwise start at one end of the diameter
+    int32 SpawnIndex = DiameterStart;
+    if (Pathfinder->IsValidCell(GridData.SpawnCell))
+    {
+        SpawnIndex = Pathfinder->GridToIndex(GridData.SpawnCell);
+        Pathfinder->BuildDistanceField({ GridData.SpawnCell }, SpawnField);
+    }
+
+    if (Result.Diameter < 2)
+    {
+        return Result;
+    }
+
+    //=========================================================================
+    // CANDIDATES
+    // Keys: every reachable dead end. Exits: the dead ends farthest from
+    // spawn. Open mazes without dead ends fall back to all floor cells
+    // (depth 0: they aren't tucked away at the end of anything).
+    //=========================================================================
+
+    TArray<int32> DeadEnds;
+    for (int32 i = 0; i < NumCells; ++i)
+    {
+        if (i != SpawnIndex && SpawnField[i] > 0 && Derived.GetTopology(Pathfinder->IndexToGrid(i)) == EMazeCellTopology::DeadEnd)
+        {
+            DeadEnds.Add(i);
+        }
+    }
+
+    if (DeadEnds.Num() < 2)
+    {
+        DeadEnds.Reset();
+        for (int32 i = 0; i < NumCells; ++i)
+        {
+            if (i != SpawnIndex && SpawnField[i] > 0)
+            {
+                DeadEnds.Add(i);
+            }
+        }
+    }
+
+    if (DeadEnds.Num() < 2)
+    {
+        return Result;
+    }
+
+    TArray<int32> DeadEndDepths;
+    DeadEndDepths.SetNumUninitialized(DeadEnds.Num());
+    int32 MaxDeadEndDepth = 1;
+    for (int32 i = 0; i < DeadEnds.Num(); ++i)
+    {
+        DeadEndDepths[i] = MazePlacement::MeasureDeadEndDepth(Derived, Pathfinder->IndexToGrid(DeadEnds[i]), NumCells);
+        MaxDeadEndDepth = FMath::Max(MaxDeadEndDepth, DeadEndDepths[i]);
+    }
+
+    TArray<int32> ExitCandidates = DeadEnds;
+    ExitCandidates.Sort([&SpawnField](int32 A, int32 B) { return SpawnField[A] > SpawnField[B]; });
+    ExitCandidates.SetNum(FMath::Min(ExitCandidates.Num(), FMath::Max(Weights.MaxExitCandidates, 1)));
+
+    //=========================================================================
+    // SCORING (one exit candidate per worker)
+    //=========================================================================
+
+    const float InvDiameter = 1.0f / Result.Diameter;
+    const float InvMaxDepth = 1.0f / MaxDeadEndDepth;
+    const float InvDetourRange = 1.0f / FMath::Max(Weights.TargetDetourRatio - 1.0f, 0.1f);
+
+    TArray<MazePlacement::FCandidateResult> CandidateResults;
+    CandidateResults.SetNum(ExitCandidates.Num());
+
+    ParallelFor(ExitCandidates.Num(), [&](int32 CandidateIdx)
+    {
+        const int32 ExitIndex = ExitCandidates[CandidateIdx];
+        const int32 ExitDistance = SpawnField[ExitIndex];
+
+        TArray<int32> ExitField;
+        Pathfinder->BuildDistanceField({ Pathfinder->IndexToGrid(ExitIndex) }, ExitField);
+
+        // Trace spawn -> exit by walking downhill in the exit field
+        TArray<FIntPoint> Route;
+        Route.Reserve(ExitDistance + 1);
+        FIntPoint Current = Pathfinder->IndexToGrid(SpawnIndex);
+        Route.Add(Current);
+        while (ExitField[Pathfinder->GridToIndex(Current)] > 0)
+        {
+            const int32 CurrentDistance = ExitField[Pathfinder->GridToIndex(Current)];
+            const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+            for (const FIntPoint& Offset : Offsets)
+            {
+                const FIntPoint Neighbor = Current + Offset;
+                if (Pathfinder->IsValidCell(Neighbor) && ExitField[Pathfinder->GridToIndex(Neighbor)] == CurrentDistance - 1)
+                {
+                    Current = Neighbor;
+                    break;
+                }
+            }
+            Route.Add(Current);
+        }
+
+        TArray<int32> RouteField;
+        Pathfinder->BuildDistanceField(Route, RouteField);
+
+        const float ExitTerm = Weights.PathLength * ExitDistance * InvDiameter;
+        MazePlacement::FCandidateResult& Best = CandidateResults[CandidateIdx];
+
+        for (int32 KeyIdx = 0; KeyIdx < DeadEnds.Num(); ++KeyIdx)
+        {
+            const int32 KeyIndex = DeadEnds[KeyIdx];
+            if (KeyIndex == ExitIndex)
+            {
+                continue;
+            }
+
+            const int32 KeyToExit = ExitField[KeyIndex];
+            const float DetourRatio = static_cast<float>(SpawnField[KeyIndex] + KeyToExit) / ExitDistance;
+
+            // Off-route keys keep the Hollow Mask in play; x-ray helps most
+            // when the key is near the exit through walls but far through the maze
+            float HollowTerm = 0.0f;
+            if (RouteField[KeyIndex] > 0)
+            {
+                const FIntPoint KeyCell = Pathfinder->IndexToGrid(KeyIndex);
+                const FIntPoint ExitCell = Pathfinder->IndexToGrid(ExitIndex);
+                const int32 Straight = FMath::Abs(KeyCell.X - ExitCell.X) + FMath::Abs(KeyCell.Y - ExitCell.Y);
+                HollowTerm = 1.0f - static_cast<float>(Straight) / KeyToExit;
+            }
+
+            const float Score = ExitTerm
+                + Weights.DeadEndDepth * DeadEndDepths[KeyIdx] * InvMaxDepth
+                + Weights.DetourRatio * FMath::Clamp((DetourRatio - 1.0f) * InvDetourRange, 0.0f, 1.0f)
+                + Weights.HollowMaskValue * HollowTerm;
+
+            if (Score > Best.Score)
+            {
+                Best.Score = Score;
+                Best.ExitIndex = ExitIndex;
+                Best.KeyIndex = KeyIndex;
+                Best.ExitDistance = ExitDistance;
+                Best.DetourRatio = DetourRatio;
+                Best.KeyDistanceFromRoute = RouteField[KeyIndex];
+            }
+        }
+    });
+
+    const MazePlacement::FCandidateResult* Best = nullptr;
+    for (const MazePlacement::FCandidateResult& Candidate : CandidateResults)
+    {
+        if (Candidate.KeyIndex != INDEX_NONE && (!Best || Candidate.Score > Best->Score))
+        {
+            Best = &Candidate;
+        }
+    }
+
+    if (!Best)
+    {
+        return Result;
+    }
+
+    const int32 BestKeyIdx = DeadEnds.IndexOfByKey(Best->KeyIndex);
+
+    Result.bSuccess = true;
+    Result.SpawnCell = Pathfinder->IndexToGrid(SpawnIndex);
+    Result.ExitCell = Pathfinder->IndexToGrid(Best->ExitIndex);
+    Result.KeyCell = Pathfinder->IndexToGrid(Best->KeyIndex);
+    Result.Score = Best->Score;
+    Result.ExitDistance = Best->ExitDistance;
+    Result.DetourRatio = Best->DetourRatio;
+    Result.KeyDeadEndDepth = DeadEndDepths[BestKeyIdx];
+    Result.KeyDistanceFromRoute = Best->KeyDistanceFromRoute;
+    Result.ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    UE_LOG(LogTemp, Log, TEXT("MazePlacement: Spawn (%d,%d) Exit (%d,%d) Key (%d,%d), score %.2f, "
+        "%d exit x %d key candidates in %.2f ms"),
+        Result.SpawnCell.X, Result.SpawnCell.Y, Result.ExitCell.X, Result.ExitCell.Y,
+        Result.KeyCell.X, Result.KeyCell.Y, Result.Score,
+        ExitCandidates.Num(), DeadEnds.Num(), Result.ElapsedMs);
+
+    return Result;
+}
@@ -0,0 +1,134 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MazeTypes.h"
+#include "MazePlacement.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    ParallelFor(Num, Lambda):
+        - Runs Lambda(Index) for Index in [0, Num) on the task graph workers
+        - Each exit candidate is scored on its own worker with its own
+          scratch arrays, then the best result is picked on the game thread
+
+    TREE DIAMETER (double BFS):
+        - BFS from any cell; the farthest cell A is one end of the longest path
+        - BFS again from A; the farthest cell B is the other end
+        - Exact for perfect mazes (trees), a good estimate for looped ones
+=============================================================================*/
+
+class UMazeGridData;
+
+/**
+ * How much each quality counts when scoring a key/exit layout.
+ * Every term is normalized to 0..1 before weighting.
+ */
+USTRUCT(BlueprintType)
+struct FMazePlacementWeights
+{
+    GENERATED_BODY()
+
+    /** Long spawn -> exit walk (relative to the maze diameter) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Placement", meta = (ClampMin = "0.0"))
+    float PathLength = 1.0f;
+
+    /** Key hidden at the end of a long dead-end corridor */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Placement", meta = (ClampMin = "0.0"))
+    float DeadEndDepth = 0.5f;
+
+    /** Spawn -> key -> exit is much longer than spawn -> exit */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Placement", meta = (ClampMin = "0.0"))
+    float DetourRatio = 0.75f;
+
+    /**
+     * Key is off the exit route (so the exit is usually found first and the
+     * Hollow Mask unlocks) and close to the exit through walls but far
+     * through the maze (so x-ray vision actually helps).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Placement", meta = (ClampMin = "0.0"))
+    float HollowMaskValue = 1.0f;
+
+    /** Detour ratio that earns the full DetourRatio score */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Placement", meta = (ClampMin = "1.1"))
+    float TargetDetourRatio = 2.5f;
+
+    /** How many of the farthest dead ends are tried as the exit */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Placement", meta = (ClampMin = "1", ClampMax = "256"))
+    int32 MaxExitCandidates = 32;
+};
+
+/**
+ * Best layout found by FMazePlacementOptimizer.
+ */
+USTRUCT(BlueprintType)
+struct FMazePlacementResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    bool bSuccess = false;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    FIntPoint SpawnCell = FIntPoint(-1, -1);
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    FIntPoint ExitCell = FIntPoint(-1, -1);
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    FIntPoint KeyCell = FIntPoint(-1, -1);
+
+    /** Weighted total */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    float Score = 0.0f;
+
+    /** Longest shortest path in the maze (cells) */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    int32 Diameter = 0;
+
+    /** Spawn -> exit distance (cells) */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    int32 ExitDistance = 0;
+
+    /** (spawn -> key -> exit) / (spawn -> exit) */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    float DetourRatio = 0.0f;
+
+    /** Corridor length from the key back to the nearest junction */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    int32 KeyDeadEndDepth = 0;
+
+    /** Distance from the key to the spawn -> exit route (0 = on the route) */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    int32 KeyDistanceFromRoute = 0;
+
+    /** Time the optimizer took */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Maze|Placement")
+    float ElapsedMs = 0.0f;
+};
+
+/**
+ * Picks spawn, exit and key cells for a baked maze.
+ *
+ * PIPELINE:
+ *   1. Spawn = the grid's SpawnCell if set, else one end of the diameter
+ *   2. Exit candidates = the dead ends farthest from spawn
+ *   3. For each exit candidate (in parallel): BFS from the exit, trace the
+ *      spawn -> exit route, BFS from the route, score every dead end as key
+ *   4. Keep the best exit/key pair
+ *
+ * Each candidate costs two BFS passes, so a 101x101 maze scores in a few ms.
+ */
+struct THELASTMASK_API FMazePlacementOptimizer
+{
+    /**
+     * Score layouts for a grid. Does not modify it.
+     *
+     * @param GridData - Baked grid (derived data is built if needed)
+     * @param Weights - Scoring weights
+     * @return Best layout (bSuccess = false if the grid has < 3 reachable floor cells)
+     */
+    static FMazePlacementResult Optimize(const UMazeGridData& GridData, const FMazePlacementWeights& Weights);
+};
@@ -0,0 +1,231 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazePropScatter.h"
+#include "MazeGridData.h"
+#include "Async/ParallelFor.h"
+
+namespace MazeScatter
+{
+    /** Candidate points tried per wanted prop before giving up */
+    constexpr int32 MaxAttemptsPerSample = 8;
+
+    /** Topology enum entries (Wall .. Room) */
+    constexpr int32 NumTopologies = static_cast<int32>(EMazeCellTopology::Room) + 1;
+}
+
+int32 FMazePropScatterer::Scatter(const UMazeGridData& GridData, const FMazeScatterRule& Rule, int32 Seed,
+    TArray<FTransform>& OutTransforms)
+{
+    OutTransforms.Reset();
+
+    if (!GridData.IsValid() || Rule.Density <= 0.0f)
+    {
+        return 0;
+    }
+
+    const FMazeDerivedData& Derived = GridData.GetDerivedData();
+    const FIntPoint Size(GridData.SizeX, GridData.SizeY);
+    const float CellSize = GridData.CellSize;
+    const float Spacing = FMath::Max(Rule.MinSpacing, 1.0f);
+    const float SpacingSq = Spacing * Spacing;
+
+    // Topology -> density lookup, so the hot loop never touches the TMap
+    float TopologyDensity[MazeScatter::NumTopologies];
+    for (int32 Topo = 0; Topo < MazeScatter::NumTopologies; ++Topo)
+    {
+        const bool bAllowed = (Rule.AllowedTopologies & (1 << Topo)) != 0 && Topo != static_cast<int32>(EMazeCellTopology::Wall);
+        const float* Multiplier = Rule.TopologyDensityMultipliers.Find(static_cast<EMazeCellTopology>(Topo));
+        TopologyDensity[Topo] = bAllowed ? Rule.Density * (Multiplier ? *Multiplier : 1.0f) : 0.0f;
+    }
+
+    //=========================================================================
+    // CHUNKS
+    // A chunk is at least 2.5 * Spacing wide, so every sample closer than
+    // Spacing to a chunk lies in that chunk or one of its 8 neighbours,
+    // and same-pass chunks never share a neighbour's samples in flight.
+    //=========================================================================
+
+    const int32 ChunkCells = FMath::Max(8, FMath::CeilToInt32(2.5f * Spacing / CellSize));
+    const int32 ChunksX = FMath::DivideAndRoundUp(Size.X, ChunkCells);
+    const int32 ChunksY = FMath::DivideAndRoundUp(Size.Y, ChunkCells);
+
+    TArray<TArray<FTransform>> ChunkResults;
+    ChunkResults.SetNum(ChunksX * ChunksY);
+
+    //=========================================================================
+    // BACKGROUND GRID (one sample max per cell)
+    // Local to each chunk plus a Spacing-wide border, so memory follows the
+    // chunk size, not the maze (a whole-maze grid is GBs at 8192^2)
+    //=========================================================================
+
+    const float BgCellSize = Spacing / UE_SQRT_2;
+    const float ChunkWorldSize = ChunkCells * CellSize;
+    const int32 BgSize = FMath::CeilToInt32((ChunkWorldSize + 2.0f * Spacing) / BgCellSize);
+
+    auto ScatterChunk = [&](int32 ChunkIndex)
+    {
+        const int32 ChunkX = ChunkIndex % ChunksX;
+        const int32 ChunkY = ChunkIndex / ChunksX;
+
+        FRandomStream Random(static_cast<int32>(HashCombineFast(GetTypeHash(Seed), GetTypeHash(ChunkIndex))));
+        TArray<FTransform>& Placements = ChunkResults[ChunkIndex];
+
+        const int32 MinY = ChunkY * ChunkCells;
+        const int32 MaxY = FMath::Min(MinY + ChunkCells, Size.Y);
+        const int32 MinX = ChunkX * ChunkCells;
+        const int32 MaxX = FMath::Min(MinX + ChunkCells, Size.X);
+
+        // Background cell (0, 0) starts one Spacing before the chunk
+        const FVector2f BgOrigin(MinX * CellSize - Spacing, MinY * CellSize - Spacing);
+
+        TArray<FVector2f> BgSamples;
+        BgSamples.SetNumUninitialized(BgSize * BgSize);
+        TArray<uint8> BgUsed;
+        BgUsed.SetNumZeroed(BgSize * BgSize);
+
+        auto ToBgCell = [&](const FVector2f& Point)
+        {
+            return FIntPoint(
+                FMath::FloorToInt32((Point.X - BgOrigin.X) / BgCellSize),
+                FMath::FloorToInt32((Point.Y - BgOrigin.Y) / BgCellSize));
+        };
+
+        // Neighbours from earlier passes are final; later ones are still empty
+        for (int32 NeighborY = FMath::Max(ChunkY - 1, 0); NeighborY <= FMath::Min(ChunkY + 1, ChunksY - 1); ++NeighborY)
+        {
+            for (int32 NeighborX = FMath::Max(ChunkX - 1, 0); NeighborX <= FMath::Min(ChunkX + 1, ChunksX - 1); ++NeighborX)
+            {
+                if (NeighborX == ChunkX && NeighborY == ChunkY)
+                {
+                    continue;
+                }
+
+                for (const FTransform& Placed : ChunkResults[NeighborY * ChunksX + NeighborX])
+                {
+                    const FVector2f Point(Placed.GetLocation().X, Placed.GetLocation().Y);
+                    const FIntPoint Bg = ToBgCell(Point);
+                    if (Bg.X >= 0 && Bg.X < BgSize && Bg.Y >= 0 && Bg.Y < BgSize)
+                    {
+                        BgUsed[Bg.Y * BgSize + Bg.X] = 1;
+                        BgSamples[Bg.Y * BgSize + Bg.X] = Point;
+                    }
+                }
+            }
+        }
+
+        for (int32 Y = MinY; Y < MaxY; ++Y)
+        {
+            for (int32 X = MinX; X < MaxX; ++X)
+            {
+                const int32 Index = Y * Size.X + X;
+                const float CellDensity = TopologyDensity[Derived.Topology[Index]];
+
+                if (CellDensity <= 0.0f || Derived.Clearance[Index] < Rule.MinClearance)
+                {
+                    continue;
+                }
+
+                // Fractional density: 0.3 = one prop in ~30% of cells
+                const int32 WantedCount = FMath::FloorToInt32(CellDensity)
+                    + (Random.FRand() < FMath::Frac(CellDensity) ? 1 : 0);
+
+                if (WantedCount == 0)
+                {
+                    continue;
+                }
+
+                // Cell area, pulled in on every side that touches a wall
+                const FIntPoint Cell(X, Y);
+                const float MinPX = X * CellSize + (Derived.GetTopology(Cell - FIntPoint(1, 0)) == EMazeCellTopology::Wall ? Rule.WallMargin : 0.0f);
+                const float MaxPX = (X + 1) * CellSize - (Derived.GetTopology(Cell + FIntPoint(1, 0)) == EMazeCellTopology::Wall ? Rule.WallMargin : 0.0f);
+                const float MinPY = Y * CellSize + (Derived.GetTopology(Cell - FIntPoint(0, 1)) == EMazeCellTopology::Wall ? Rule.WallMargin : 0.0f);
+                const float MaxPY = (Y + 1) * CellSize - (Derived.GetTopology(Cell + FIntPoint(0, 1)) == EMazeCellTopology::Wall ? Rule.WallMargin : 0.0f);
+
+                if (MinPX >= MaxPX || MinPY >= MaxPY)
+                {
+                    continue;
+                }
+
+                for (int32 Wanted = 0; Wanted < WantedCount; ++Wanted)
+                {
+                    for (int32 Attempt = 0; Attempt < MazeScatter::MaxAttemptsPerSample; ++Attempt)
+                    {
+                        const FVector2f Candidate(
+                            Random.FRandRange(MinPX, MaxPX),
+                            Random.FRandRange(MinPY, MaxPY));
+
+                        // Inside the chunk, so always inside the bordered grid
+                        const FIntPoint Bg = ToBgCell(Candidate);
+                        const int32 BgX = FMath::Clamp(Bg.X, 0, BgSize - 1);
+                        const int32 BgY = FMath::Clamp(Bg.Y, 0, BgSize - 1);
+
+                        bool bTooClose = false;
+                        for (int32 NY = FMath::Max(BgY - 2, 0); NY <= FMath::Min(BgY + 2, BgSize - 1) && !bTooClose; ++NY)
+                        {
+                            for (int32 NX = FMath::Max(BgX - 2, 0); NX <= FMath::Min(BgX + 2, BgSize - 1); ++NX)
+                            {
+                                const int32 BgIndex = NY * BgSize + NX;
+                                if (BgUsed[BgIndex] && FVector2f::DistSquared(BgSamples[BgIndex], Candidate) < SpacingSq)
+                                {
+                                    bTooClose = true;
+                                    break;
+                                }
+                            }
+                        }
+
+                        if (bTooClose)
+                        {
+                            continue;
+                        }
+
+                        const int32 BgIndex = BgY * BgSize + BgX;
+                        BgUsed[BgIndex] = 1;
+                        BgSamples[BgIndex] = Candidate;
+
+                        const float Yaw = Rule.bRandomYaw ? Random.FRandRange(0.0f, 360.0f) : 0.0f;
+                        const float Scale = Random.FRandRange(Rule.ScaleRange.X, Rule.ScaleRange.Y);
+
+                        Placements.Emplace(
+                            FRotator(0.0f, Yaw, 0.0f),
+                            FVector(Candidate.X, Candidate.Y, Rule.ZOffset),
+                            FVector(Scale));
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    // Four passes: chunks with the same (X parity, Y parity) never neighbour each other
+    TArray<int32> PassChunks;
+    PassChunks.Reserve(ChunkResults.Num() / 4 + 1);
+
+    for (int32 Pass = 0; Pass < 4; ++Pass)
+    {
+        PassChunks.Reset();
+        for (int32 ChunkY = Pass / 2; ChunkY < ChunksY; ChunkY += 2)
+        {
+            for (int32 ChunkX = Pass % 2; ChunkX < ChunksX; ChunkX += 2)
+            {
+                PassChunks.Add(ChunkY * ChunksX + ChunkX);
+            }
+        }
+
+        ParallelFor(PassChunks.Num(), [&](int32 i) { ScatterChunk(PassChunks[i]); });
+    }
+
+    // Gather in chunk order so the output order is deterministic too
+    int32 Total = 0;
+    for (const TArray<FTransform>& Placements : ChunkResults)
+    {
+        Total += Placements.Num();
+    }
+
+    OutTransforms.Reserve(Total);
+    for (const TArray<FTransform>& Placements : ChunkResults)
+    {
+        OutTransforms.Append(Placements);
+    }
+
+    return Total;
+}
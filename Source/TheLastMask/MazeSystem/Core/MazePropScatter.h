@@ -0,0 +1,117 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MazeTypes.h"
+#include "MazePropScatter.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    meta = (Bitmask, BitmaskEnum = "..."):
+        - Shows an int32 as a row of checkboxes, one per enum value
+        - Bit N is set when enum value N is ticked
+
+    ParallelFor(Num, Lambda):
+        - Runs Lambda(Index) for Index in [0, Num) on the task graph workers
+        - Blocks until every index is done
+        - The lambda must not write to data another index is using
+
+    POISSON-DISC SAMPLING:
+        - Random points that are never closer than a minimum spacing
+        - Looks natural (no clumps, no visible grid)
+        - A "background grid" with cells of Spacing/sqrt(2) holds at most
+          one sample each, so a spacing check only reads the 5x5 cells
+          around a candidate instead of every placed sample
+=============================================================================*/
+
+class UMazeGridData;
+class UStaticMesh;
+
+/**
+ * One kind of prop to scatter (debris, bodies, candles...).
+ * Density and filters are evaluated per floor cell.
+ */
+USTRUCT(BlueprintType)
+struct FMazeScatterRule
+{
+    GENERATED_BODY()
+
+    /** Mesh to place */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    TObjectPtr<UStaticMesh> Mesh;
+
+    /** Average props per eligible floor cell (before topology multipliers) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter",
+        meta = (ClampMin = "0.0", ClampMax = "16.0"))
+    float Density = 0.3f;
+
+    /** Minimum distance between two props of this rule (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter",
+        meta = (ClampMin = "5.0"))
+    float MinSpacing = 80.0f;
+
+    /** Keep props this far (cm) from cell edges that touch a wall */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter",
+        meta = (ClampMin = "0.0"))
+    float WallMargin = 20.0f;
+
+    /** Which cell shapes may receive this prop */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter",
+        meta = (Bitmask, BitmaskEnum = "/Script/TheLastMask.EMazeCellTopology"))
+    int32 AllowedTopologies = 0x7E; // Everything except Wall
+
+    /** Per-shape density multiplier (e.g. DeadEnd = 3 piles bodies in dead ends) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    TMap<EMazeCellTopology, float> TopologyDensityMultipliers;
+
+    /** Minimum distance (cells) to the nearest wall. 1 = anywhere, 2 = open areas only. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter",
+        meta = (ClampMin = "1", ClampMax = "15"))
+    int32 MinClearance = 1;
+
+    /** Uniform scale range (X = min, Y = max) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    FVector2D ScaleRange = FVector2D(0.8, 1.2);
+
+    /** Random rotation around Z */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    bool bRandomYaw = true;
+
+    /** Height above the floor origin (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    float ZOffset = 0.0f;
+
+    /** Give the instances collision (off = purely visual) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    bool bEnableCollision = false;
+};
+
+/**
+ * Poisson-disc prop scattering over the floor cells of a maze.
+ *
+ * The grid is split into square chunks processed in four passes
+ * (checkerboard by chunk X/Y parity). Chunks in the same pass are at least
+ * one whole chunk apart, and a chunk is wider than the spacing check reach,
+ * so chunks of one pass run in parallel without touching each other's
+ * samples. The spacing background grid is allocated per chunk with a
+ * Spacing-wide border seeded from neighbouring chunks' placements, so
+ * memory does not grow with the maze. Each chunk has its own seeded random
+ * stream, so the result is identical for a given seed regardless of thread
+ * scheduling.
+ */
+struct THELASTMASK_API FMazePropScatterer
+{
+    /**
+     * Scatter one rule over a maze.
+     *
+     * @param GridData - Maze to scatter on (uses its derived topology/clearance)
+     * @param Rule - What to place and where
+     * @param Seed - Same seed = same placements
+     * @param OutTransforms - Instance transforms in maze-local space
+     * @return Number of placements
+     */
+    static int32 Scatter(const UMazeGridData& GridData, const FMazeScatterRule& Rule, int32 Seed,
+        TArray<FTransform>& OutTransforms);
+};
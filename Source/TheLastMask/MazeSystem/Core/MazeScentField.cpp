@@ -0,0 +1,89 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeScentField.h"
+
+void FMazeScentField::Reset(FIntPoint InSize, double Epoch)
+{
+    Size = InSize.X > 0 && InSize.Y > 0 ? InSize : FIntPoint::ZeroValue;
+    EpochTime = Epoch;
+    FreshestCell = FIntPoint(-1, -1);
+    Cells.Reset();
+    Cells.SetNum(Size.X * Size.Y);
+}
+
+void FMazeScentField::SetDecay(float InHalfLife, float InMinStrength)
+{
+    InvHalfLife = 1.0f / FMath::Max(InHalfLife, 0.01f);
+    MinStrength = FMath::Max(InMinStrength, 0.0f);
+}
+
+float FMazeScentField::Evaluate(const FCell& Entry, double Now) const
+{
+    if (Entry.Strength <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    const float Age = FMath::Max(static_cast<float>(Now - EpochTime) - Entry.Time, 0.0f);
+    const float Strength = Entry.Strength * FMath::Exp2(-Age * InvHalfLife);
+    return Strength >= MinStrength ? Strength : 0.0f;
+}
+
+void FMazeScentField::Deposit(FIntPoint Cell, double Now, float Amount, float MaxStrength)
+{
+    if (Cell.X < 0 || Cell.X >= Size.X || Cell.Y < 0 || Cell.Y >= Size.Y || Amount <= 0.0f)
+    {
+        return;
+    }
+
+    // Fold what is left of the old scent into a fresh time stamp
+    FCell& Entry = Cells[Cell.Y * Size.X + Cell.X];
+    Entry.Strength = FMath::Min(Evaluate(Entry, Now) + Amount, MaxStrength);
+    Entry.Time = static_cast<float>(Now - EpochTime);
+
+    FreshestCell = Cell;
+}
+
+float FMazeScentField::GetStrength(FIntPoint Cell, double Now) const
+{
+    if (Cell.X < 0 || Cell.X >= Size.X || Cell.Y < 0 || Cell.Y >= Size.Y)
+    {
+        return 0.0f;
+    }
+
+    return Evaluate(Cells[Cell.Y * Size.X + Cell.X], Now);
+}
+
+bool FMazeScentField::FindStrongestNeighbor(FIntPoint Cell, double Now, TArrayView<const uint8> Walkable, FIntPoint& OutCell, float& OutStrength) const
+{
+    static const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+    const bool bCheckWalls = Walkable.Num() == Cells.Num();
+
+    OutCell = FIntPoint(-1, -1);
+    OutStrength = 0.0f;
+
+    for (const FIntPoint& Offset : Offsets)
+    {
+        const FIntPoint Neighbor = Cell + Offset;
+        if (Neighbor.X < 0 || Neighbor.X >= Size.X || Neighbor.Y < 0 || Neighbor.Y >= Size.Y)
+        {
+            continue;
+        }
+
+        const int32 Index = Neighbor.Y * Size.X + Neighbor.X;
+        if (bCheckWalls && !Walkable[Index])
+        {
+            continue;
+        }
+
+        const float Strength = Evaluate(Cells[Index], Now);
+        if (Strength > OutStrength)
+        {
+            OutStrength = Strength;
+            OutCell = Neighbor;
+        }
+    }
+
+    return OutCell.X >= 0;
+}
@@ -0,0 +1,84 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    LAZY DECAY:
+        - Scent fades exponentially: after one HalfLife only half is left
+        - Instead of fading every cell every frame, each cell remembers how
+          strong it was and WHEN that was; reads apply the fade on the spot
+        - Nothing is done for cells nobody looks at, so the per-frame cost
+          does not grow with the maze
+
+    Why exponential:
+        - Strength(t) = S * 2^(-(t - T) / HalfLife)
+        - Adding scent to a fading cell just folds the old value in at the
+          new time stamp; no history is needed
+=============================================================================*/
+
+/**
+ * Decaying scent left by the player, one value per grid cell.
+ *
+ * Every operation touches one cell (or a cell and its four neighbours);
+ * only Reset walks the grid, once per maze.
+ */
+class THELASTMASK_API FMazeScentField
+{
+public:
+    /** Size the grid and clear all scent. Times are seconds from Epoch. */
+    void Reset(FIntPoint InSize, double Epoch);
+
+    /** Fade settings. HalfLife in seconds; reads below MinStrength count as no scent. */
+    void SetDecay(float InHalfLife, float InMinStrength);
+
+    /**
+     * Add scent to a cell (capped at MaxStrength).
+     *
+     * @param Now - Current time (same clock as Reset's Epoch)
+     */
+    void Deposit(FIntPoint Cell, double Now, float Amount, float MaxStrength);
+
+    /** Strength of a cell right now (0 if none / out of bounds) */
+    float GetStrength(FIntPoint Cell, double Now) const;
+
+    /**
+     * Neighbour (4-way) with the strongest scent.
+     *
+     * @param Walkable - Optional row-major walkability; walls are skipped
+     * @return false if no neighbour has scent above MinStrength
+     */
+    bool FindStrongestNeighbor(FIntPoint Cell, double Now, TArrayView<const uint8> Walkable, FIntPoint& OutCell, float& OutStrength) const;
+
+    /** Most recently scented cell (-1,-1 if none) */
+    FIntPoint GetFreshestCell() const { return FreshestCell; }
+
+    FIntPoint GetSize() const { return Size; }
+    bool IsValid() const { return Cells.Num() > 0; }
+
+private:
+    struct FCell
+    {
+        /** Strength at Time */
+        float Strength = 0.0f;
+
+        /** Seconds since Epoch of the last deposit */
+        float Time = 0.0f;
+    };
+
+    /** Strength of a stored cell at Now */
+    float Evaluate(const FCell& Entry, double Now) const;
+
+    TArray<FCell> Cells;
+    FIntPoint Size = FIntPoint::ZeroValue;
+    FIntPoint FreshestCell = FIntPoint(-1, -1);
+
+    /** Cell times are stored relative to this, so floats keep sub-ms precision */
+    double EpochTime = 0.0;
+
+    float InvHalfLife = 1.0f / 20.0f;
+    float MinStrength = 0.05f;
+};
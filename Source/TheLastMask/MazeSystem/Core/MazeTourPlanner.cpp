@@ -0,0 +1,200 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeTourPlanner.h"
+#include "Algo/Reverse.h"
+
+bool FMazeTourPlanner::Solve(TArrayView<const int32> Matrix, int32 Num, int32 Start, int32 End, FMazeTour& OutTour)
+{
+    OutTour = FMazeTour();
+
+    if (Num <= 0 || Matrix.Num() != Num * Num || Start < 0 || Start >= Num || End >= Num || End == Start)
+    {
+        return false;
+    }
+
+    // Every node that is neither the start nor the fixed end
+    TArray<int32> Stops;
+    Stops.Reserve(Num);
+    for (int32 Node = 0; Node < Num; ++Node)
+    {
+        if (Node != Start && Node != End)
+        {
+            Stops.Add(Node);
+        }
+    }
+
+    if (Stops.Num() <= MaxExactStops)
+    {
+        SolveExact(Matrix, Num, Start, End, Stops, OutTour);
+        OutTour.bOptimal = true;
+    }
+    else
+    {
+        SolveApproximate(Matrix, Num, Start, End, Stops, OutTour);
+    }
+
+    for (int32 i = 1; i < OutTour.Order.Num(); ++i)
+    {
+        OutTour.Length += Matrix[OutTour.Order[i - 1] * Num + OutTour.Order[i]];
+    }
+    return true;
+}
+
+//=============================================================================
+// HELD-KARP
+//=============================================================================
+
+void FMazeTourPlanner::SolveExact(TArrayView<const int32> Matrix, int32 Num, int32 Start, int32 End, const TArray<int32>& Stops, FMazeTour& OutTour)
+{
+    const int32 N = Stops.Num();
+    OutTour.Order.Add(Start);
+
+    if (N > 0)
+    {
+        const int32 NumMasks = 1 << N;
+        const uint8 NoPrevious = MAX_uint8;
+
+        Best.SetNumUninitialized(NumMasks * N, EAllowShrinking::No);
+        Previous.SetNumUninitialized(NumMasks * N, EAllowShrinking::No);
+        for (int32& Value : Best)
+        {
+            Value = MAX_int32;
+        }
+
+        for (int32 i = 0; i < N; ++i)
+        {
+            Best[(1 << i) * N + i] = Matrix[Start * Num + Stops[i]];
+            Previous[(1 << i) * N + i] = NoPrevious;
+        }
+
+        // Masks only grow, so increasing order finishes every entry before it is read
+        for (int32 Mask = 1; Mask < NumMasks; ++Mask)
+        {
+            for (int32 Last = 0; Last < N; ++Last)
+            {
+                const int32 Cost = Best[Mask * N + Last];
+                if (Cost == MAX_int32)
+                {
+                    continue;
+                }
+
+                const int32* FromLast = &Matrix[Stops[Last] * Num];
+                for (int32 Next = 0; Next < N; ++Next)
+                {
+                    const int32 NextBit = 1 << Next;
+                    if (Mask & NextBit)
+                    {
+                        continue;
+                    }
+
+                    const int32 Entry = (Mask | NextBit) * N + Next;
+                    const int32 NewCost = Cost + FromLast[Stops[Next]];
+                    if (NewCost < Best[Entry])
+                    {
+                        Best[Entry] = NewCost;
+                        Previous[Entry] = static_cast<uint8>(Last);
+                    }
+                }
+            }
+        }
+
+        // Best final stop, counting the leg to End if there is one
+        const int32 Full = NumMasks - 1;
+        int32 BestLast = 0;
+        int32 BestCost = MAX_int32;
+        for (int32 Last = 0; Last < N; ++Last)
+        {
+            const int32 Cost = Best[Full * N + Last] + (End != INDEX_NONE ? Matrix[Stops[Last] * Num + End] : 0);
+            if (Cost < BestCost)
+            {
+                BestCost = Cost;
+                BestLast = Last;
+            }
+        }
+
+        // Walk the Previous links back from the full mask
+        TArray<int32, TInlineAllocator<MaxExactStops>> Reversed;
+        int32 Mask = Full;
+        int32 Last = BestLast;
+        while (Last != NoPrevious)
+        {
+            Reversed.Add(Stops[Last]);
+            const int32 Prior = Previous[Mask * N + Last];
+            Mask &= ~(1 << Last);
+            Last = Prior;
+        }
+
+        for (int32 i = Reversed.Num() - 1; i >= 0; --i)
+        {
+            OutTour.Order.Add(Reversed[i]);
+        }
+    }
+
+    if (End != INDEX_NONE)
+    {
+        OutTour.Order.Add(End);
+    }
+}
+
+//=============================================================================
+// NEAREST NEIGHBOUR + 2-OPT
+//=============================================================================
+
+void FMazeTourPlanner::SolveApproximate(TArrayView<const int32> Matrix, int32 Num, int32 Start, int32 End, const TArray<int32>& Stops, FMazeTour& OutTour)
+{
+    TArray<int32>& Route = OutTour.Order;
+    Route.Reserve(Stops.Num() + 2);
+    Route.Add(Start);
+
+    TArray<int32> Remaining = Stops;
+    while (Remaining.Num() > 0)
+    {
+        const int32* FromCurrent = &Matrix[Route.Last() * Num];
+        int32 Nearest = 0;
+        for (int32 i = 1; i < Remaining.Num(); ++i)
+        {
+            if (FromCurrent[Remaining[i]] < FromCurrent[Remaining[Nearest]])
+            {
+                Nearest = i;
+            }
+        }
+        Route.Add(Remaining[Nearest]);
+        Remaining.RemoveAtSwap(Nearest, EAllowShrinking::No);
+    }
+
+    if (End != INDEX_NONE)
+    {
+        Route.Add(End);
+    }
+
+    auto Distance = [&Matrix, Num](int32 A, int32 B) { return Matrix[A * Num + B]; };
+
+    // Route[0] (start) and a fixed end never move
+    const int32 Len = Route.Num();
+    const int32 LastMovable = End != INDEX_NONE ? Len - 2 : Len - 1;
+
+    // Each pass is O(N^2); the cap only matters on adversarial inputs
+    const int32 MaxPasses = 64;
+    bool bImproved = true;
+    for (int32 Pass = 0; Pass < MaxPasses && bImproved; ++Pass)
+    {
+        bImproved = false;
+
+        for (int32 i = 1; i < LastMovable; ++i)
+        {
+            for (int32 j = i + 1; j <= LastMovable; ++j)
+            {
+                // Reversing Route[i..j] swaps edges (i-1, i) + (j, j+1) for (i-1, j) + (i, j+1)
+                const bool bHasAfter = j + 1 < Len;
+                const int32 Before = Distance(Route[i - 1], Route[i]) + (bHasAfter ? Distance(Route[j], Route[j + 1]) : 0);
+                const int32 After = Distance(Route[i - 1], Route[j]) + (bHasAfter ? Distance(Route[i], Route[j + 1]) : 0);
+
+                if (After < Before)
+                {
+                    Algo::Reverse(Route.GetData() + i, j - i + 1);
+                    bImproved = true;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    HELD-KARP (bitmask dynamic programming):
+        - Best[Visited][Last] = shortest walk from the start that collects
+          exactly the stops in the bitmask Visited and ends at Last
+        - Every entry is built from entries with one stop fewer, so the
+          table gives the exact best order in 2^N * N^2 steps
+        - 16 stops: ~16 million steps and 5 MB of table. Beyond that the
+          table doubles per stop, so we switch to...
+
+    2-OPT:
+        - Start from "always go to the nearest stop next"
+        - Repeatedly reverse any stretch of the route that makes it shorter
+        - Not guaranteed optimal, but usually within a few percent
+=============================================================================*/
+
+/**
+ * Order to visit stops in, from a solve.
+ */
+struct FMazeTour
+{
+    /** Node indices in visiting order, Start first (and End last if one was given) */
+    TArray<int32> Order;
+
+    /** Total maze distance along Order */
+    int32 Length = 0;
+
+    /** True if Held-Karp solved it exactly, false if 2-opt approximated it */
+    bool bOptimal = false;
+};
+
+/**
+ * Shortest route through all points of interest ("travelling salesman",
+ * open path: the route does not return to the start).
+ *
+ * Works on a distance matrix (see UMazePathfinder::BuildDistanceMatrix),
+ * so it knows nothing about the grid. Keep one planner around: its DP
+ * tables are reused between solves.
+ */
+class THELASTMASK_API FMazeTourPlanner
+{
+public:
+    /** Most stops (excluding Start and End) solved exactly */
+    static constexpr int32 MaxExactStops = 16;
+
+    /**
+     * Visit every node of the matrix once.
+     *
+     * @param Matrix - Num x Num distances, row-major. Must be symmetric and
+     *                 fully connected (drop unreachable nodes first).
+     * @param Start - Node the route starts at (the player)
+     * @param End - Node the route must end at (the exit), INDEX_NONE = anywhere
+     * @return False if the inputs are invalid
+     */
+    bool Solve(TArrayView<const int32> Matrix, int32 Num, int32 Start, int32 End, FMazeTour& OutTour);
+
+private:
+    /** Held-Karp over Stops; fills OutTour.Order */
+    void SolveExact(TArrayView<const int32> Matrix, int32 Num, int32 Start, int32 End, const TArray<int32>& Stops, FMazeTour& OutTour);
+
+    /** Nearest neighbour + 2-opt over Stops; fills OutTour.Order */
+    void SolveApproximate(TArrayView<const int32> Matrix, int32 Num, int32 Start, int32 End, const TArray<int32>& Stops, FMazeTour& OutTour);
+
+    /** DP table: [Visited * NumStops + Last] */
+    TArray<int32> Best;
+
+    /** Previous stop on the best walk for each table entry */
+    TArray<uint8> Previous;
+};
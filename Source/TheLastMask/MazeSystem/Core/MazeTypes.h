@@ -93,6 +93,36 @@ enum class EMazePathTarget : uint8
     None UMETA(DisplayName = "None")
 };
 
+/**
+ * Shape of a floor cell, derived from its walkable neighbours.
+ * Used by scattering, placement and AI to reason about the layout.
+ * Values are bit indices so rules can store an allowed-topology mask.
+ */
+UENUM(BlueprintType)
+enum class EMazeCellTopology : uint8
+{
+    /** Not walkable */
+    Wall UMETA(DisplayName = "Wall"),
+
+    /** Floor with no walkable neighbours */
+    Isolated UMETA(DisplayName = "Isolated"),
+
+    /** One way in, no way out */
+    DeadEnd UMETA(DisplayName = "Dead End"),
+
+    /** Two opposite openings (straight hallway) */
+    Corridor UMETA(DisplayName = "Corridor"),
+
+    /** Two adjacent openings (bend) */
+    Corner UMETA(DisplayName = "Corner"),
+
+    /** Three or four openings (decision point) */
+    Junction UMETA(DisplayName = "Junction"),
+
+    /** All eight surrounding cells are floor (open area) */
+    Room UMETA(DisplayName = "Room")
+};
+
 /**
  * Configuration for maze generation.
  * Exposed to editor as a grouped set of parameters.
@@ -0,0 +1,216 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeBeliefComponent.h"
+#include "MazeBeliefSubsystem.h"
+#include "MazeManager.h"
+#include "MazeWorldSubsystem.h"
+#include "Core/MazePathfinder.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+UMazeBeliefComponent::UMazeBeliefComponent()
+{
+    // Updated in batches by UMazeBeliefSubsystem
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMazeBeliefComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (UMazeBeliefSubsystem* Subsystem = GetWorld()->GetSubsystem<UMazeBeliefSubsystem>())
+    {
+        Subsystem->RegisterBelief(this);
+    }
+}
+
+void UMazeBeliefComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UMazeBeliefSubsystem* Subsystem = GetWorld()->GetSubsystem<UMazeBeliefSubsystem>())
+    {
+        Subsystem->UnregisterBelief(this);
+    }
+
+    Topology.Reset();
+    CurrentMaze.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+//=============================================================================
+// QUERIES / ACTIONS
+//=============================================================================
+
+FVector UMazeBeliefComponent::GetMostLikelyPlayerLocation() const
+{
+    const AMazeManager* Maze = CurrentMaze.Get();
+    const FIntPoint Cell = Belief.GetMostLikelyCell();
+    return Maze && Cell.X >= 0 ? Maze->MazeCellToWorld(Cell) : FVector::ZeroVector;
+}
+
+float UMazeBeliefComponent::GetPlayerProbabilityAtCell(FIntPoint Cell) const
+{
+    return Topology ? Belief.GetProbability(*Topology, Cell) : 0.0f;
+}
+
+void UMazeBeliefComponent::NotifyPlayerHeardAt(FIntPoint Cell)
+{
+    if (!Topology || !Belief.Matches(*Topology))
+    {
+        return;
+    }
+
+    const FIntPoint Size = Topology->GetSize();
+    if (Cell.X >= 0 && Cell.X < Size.X && Cell.Y >= 0 && Cell.Y < Size.Y &&
+        Topology->IsFloor(Topology->ToPadded(Cell)))
+    {
+        Belief.Collapse(*Topology, Cell);
+    }
+}
+
+void UMazeBeliefComponent::ResetBelief()
+{
+    if (Topology)
+    {
+        Belief.Reset(*Topology);
+        Belief.Settle(*Topology, {});
+    }
+}
+
+//=============================================================================
+// BATCHED UPDATE
+//=============================================================================
+
+bool UMazeBeliefComponent::PrepareUpdate(UMazeBeliefSubsystem& Subsystem, const APawn* Player)
+{
+    PendingPathfinder = nullptr;
+
+    const AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return false;
+    }
+
+    // Same lookup order as the difficulty director: current maze first
+    const FVector OwnerLocation = Owner->GetActorLocation();
+    FIntPoint EnemyCell(-1, -1);
+    AMazeManager* Maze = CurrentMaze.Get();
+    if (!Maze || !Maze->WorldToMazeCell(OwnerLocation, EnemyCell))
+    {
+        const UMazeWorldSubsystem* MazeWorld = GetWorld()->GetSubsystem<UMazeWorldSubsystem>();
+        Maze = MazeWorld ? MazeWorld->FindMazeAtLocation(OwnerLocation, EnemyCell) : nullptr;
+    }
+
+    TSharedPtr<const FMazeBeliefTopology> NewTopology = Maze ? Subsystem.GetTopology(*Maze) : nullptr;
+    if (!NewTopology || !Maze->GetPathfinder())
+    {
+        return false;
+    }
+
+    // New maze: start from "anywhere". Edited maze: drop belief on new walls.
+    if (Maze != CurrentMaze.Get() || !Belief.Matches(*NewTopology))
+    {
+        Belief.Reset(*NewTopology);
+        bPlayerVisible = false;
+        LastSeenCell = FIntPoint(-1, -1);
+    }
+    else if (BeliefGridHash != NewTopology->GetGridHash())
+    {
+        Belief.Conform(*NewTopology);
+    }
+
+    CurrentMaze = Maze;
+    Topology = NewTopology;
+    BeliefGridHash = NewTopology->GetGridHash();
+
+    // Facing in grid axes (the grid is the maze actor's local XY)
+    const FVector LocalForward = Maze->GetActorTransform().InverseTransformVectorNoScale(Owner->GetActorForwardVector());
+    PendingFacing = FVector2D(LocalForward.X, LocalForward.Y).GetSafeNormal();
+
+    PendingPlayerCell = FIntPoint(-1, -1);
+    if (Player)
+    {
+        Maze->WorldToMazeCell(Player->GetActorLocation(), PendingPlayerCell);
+    }
+
+    PendingEnemyCell = EnemyCell;
+    PendingPathfinder = Maze->GetPathfinder();
+    return true;
+}
+
+void UMazeBeliefComponent::RunUpdate()
+{
+    if (!PendingPathfinder || !Topology)
+    {
+        return;
+    }
+
+    const FMazeBeliefTopology& Layout = *Topology;
+    Belief.Diffuse(Layout, DiffusionStepsPerUpdate);
+
+    //=========================================================================
+    // LOOK: line of sight within the view cone (neighbours always count)
+    //=========================================================================
+
+    const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(ViewHalfAngle));
+    const FIntPoint Origin = PendingEnemyCell;
+    bool bSeen = false;
+
+    VisibleScratch.Reset();
+    PendingPathfinder->ForEachVisibleCell(Origin, ViewRadius, [&](FIntPoint Cell)
+    {
+        const FVector2D ToCell(Cell - Origin);
+        const double DistanceSquared = ToCell.SizeSquared();
+        if (DistanceSquared > 2.0 && FVector2D::DotProduct(ToCell, PendingFacing) < FMath::Sqrt(DistanceSquared) * CosHalfAngle)
+        {
+            return;
+        }
+
+        bSeen |= Cell == PendingPlayerCell;
+        VisibleScratch.Add(Layout.ToPadded(Cell));
+    });
+
+    //=========================================================================
+    // OBSERVE
+    //=========================================================================
+
+    if (bSeen)
+    {
+        Belief.Collapse(Layout, PendingPlayerCell);
+    }
+    else
+    {
+        for (const int32 Index : VisibleScratch)
+        {
+            Belief.ClearCell(Index);
+        }
+        Belief.Settle(Layout, VisibleScratch);
+    }
+
+    bPendingPlayerVisible = bSeen;
+}
+
+void UMazeBeliefComponent::FinishUpdate()
+{
+    if (!PendingPathfinder)
+    {
+        return;
+    }
+    PendingPathfinder = nullptr;
+
+    const bool bWasVisible = bPlayerVisible;
+    bPlayerVisible = bPendingPlayerVisible;
+
+    if (bPlayerVisible)
+    {
+        LastSeenCell = PendingPlayerCell;
+        if (!bWasVisible)
+        {
+            OnPlayerSpotted.Broadcast(LastSeenCell);
+        }
+    }
+    else if (bWasVisible)
+    {
+        OnPlayerLost.Broadcast(LastSeenCell);
+    }
+}
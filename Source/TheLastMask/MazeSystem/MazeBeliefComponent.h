@@ -0,0 +1,176 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Core/MazeBeliefMap.h"
+#include "MazeBeliefComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    Batched update:
+        - This component does not tick on its own
+        - UMazeBeliefSubsystem updates every belief map in one ParallelFor,
+          so ten enemies cost about as much wall time as one or two
+
+    Game thread vs worker thread:
+        - PrepareUpdate / FinishUpdate run on the game thread (they touch
+          actors and fire Blueprint events)
+        - RunUpdate runs on a worker and only touches this component's own
+          map plus read-only grid data
+=============================================================================*/
+
+class AMazeManager;
+class APawn;
+class UMazePathfinder;
+class UMazeBeliefSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMazeBeliefPlayerEvent, FIntPoint, Cell);
+
+/**
+ * Where does this enemy think the player is?
+ *
+ * Add to a stalker enemy. The enemy keeps a probability for every floor
+ * cell. Each update:
+ *   1. Belief diffuses along the corridors (the player keeps moving)
+ *   2. Cells the enemy can see are cleared (the player is not there)...
+ *   3. ...unless the player IS in one of them: belief collapses onto it
+ *
+ * The player position is only read to test it against the enemy's own
+ * view, so the hunt never cheats. Steer the AI towards
+ * GetMostLikelyPlayerCell, or sample cells by GetPlayerProbabilityAtCell.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazeBeliefComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazeBeliefComponent();
+
+    //=========================================================================
+    // TUNING
+    //=========================================================================
+
+    /** How far the enemy sees along open corridors (cells) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Belief", meta = (ClampMin = "1", ClampMax = "64"))
+    int32 ViewRadius = 10;
+
+    /** Half the view cone, degrees (adjacent cells are always noticed) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Belief", meta = (ClampMin = "1.0", ClampMax = "180.0"))
+    float ViewHalfAngle = 60.0f;
+
+    /** Diffusion steps per update: how fast belief spreads out */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Belief", meta = (ClampMin = "0", ClampMax = "8"))
+    int32 DiffusionStepsPerUpdate = 1;
+
+    //=========================================================================
+    // EVENTS
+    //=========================================================================
+
+    /** The player came into view */
+    UPROPERTY(BlueprintAssignable, Category = "Maze|Belief")
+    FOnMazeBeliefPlayerEvent OnPlayerSpotted;
+
+    /** The player left view (Cell = where they were last seen) */
+    UPROPERTY(BlueprintAssignable, Category = "Maze|Belief")
+    FOnMazeBeliefPlayerEvent OnPlayerLost;
+
+    //=========================================================================
+    // QUERIES
+    //=========================================================================
+
+    /** Cell with the highest belief (-1,-1 before the first update) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    FIntPoint GetMostLikelyPlayerCell() const { return Belief.GetMostLikelyCell(); }
+
+    /** World position of GetMostLikelyPlayerCell (zero if unknown) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    FVector GetMostLikelyPlayerLocation() const;
+
+    /** Probability (0..1) that the player is in this cell */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    float GetPlayerProbabilityAtCell(FIntPoint Cell) const;
+
+    /** Could the enemy see the player at the last update? */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    bool IsPlayerVisible() const { return bPlayerVisible; }
+
+    /** Where the player was last seen (-1,-1 if never) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    FIntPoint GetLastSeenCell() const { return LastSeenCell; }
+
+    /** The maze the belief is about */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    AMazeManager* GetCurrentMaze() const { return CurrentMaze.Get(); }
+
+    //=========================================================================
+    // ACTIONS
+    //=========================================================================
+
+    /** A noise gave the player away: all belief on this cell */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Belief")
+    void NotifyPlayerHeardAt(FIntPoint Cell);
+
+    /** Forget everything: the player could be anywhere */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Belief")
+    void ResetBelief();
+
+    //=========================================================================
+    // NATIVE ACCESS (debug views, other AI code)
+    //=========================================================================
+
+    const FMazeBeliefMap& GetBeliefMap() const { return Belief; }
+
+    /** Layout the map is stored in (null before the first update) */
+    const FMazeBeliefTopology* GetTopology() const { return Topology.Get(); }
+
+    //=========================================================================
+    // BATCHED UPDATE (called by UMazeBeliefSubsystem)
+    //=========================================================================
+
+    /** Game thread: find the maze, the enemy's cell and facing. False = skip this round. */
+    bool PrepareUpdate(UMazeBeliefSubsystem& Subsystem, const APawn* Player);
+
+    /** Worker thread: diffuse, look, observe */
+    void RunUpdate();
+
+    /** Game thread: fire spotted / lost events */
+    void FinishUpdate();
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    FMazeBeliefMap Belief;
+
+    /** Layout shared with every other belief on the same maze */
+    TSharedPtr<const FMazeBeliefTopology> Topology;
+
+    TWeakObjectPtr<AMazeManager> CurrentMaze;
+
+    /** Grid hash Belief was last conformed to */
+    uint64 BeliefGridHash = 0;
+
+    bool bPlayerVisible = false;
+    FIntPoint LastSeenCell = FIntPoint(-1, -1);
+
+    //=========================================================================
+    // UPDATE INPUTS / OUTPUTS (valid between Prepare and Finish)
+    //=========================================================================
+
+    const UMazePathfinder* PendingPathfinder = nullptr;
+    FIntPoint PendingEnemyCell = FIntPoint(-1, -1);
+    FVector2D PendingFacing = FVector2D(1.0, 0.0);
+
+    /** Player cell, only compared against what the enemy sees */
+    FIntPoint PendingPlayerCell = FIntPoint(-1, -1);
+
+    bool bPendingPlayerVisible = false;
+
+    /** Visible cells of this update (padded indices), reused */
+    TArray<int32> VisibleScratch;
+};
@@ -0,0 +1,253 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeBeliefSubsystem.h"
+#include "MazeBeliefComponent.h"
+#include "MazeDebugVisualizer.h"
+#include "MazeManager.h"
+#include "Core/MazePathfinder.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+void UMazeBeliefSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // maze.debug belief: every enemy's belief summed (no subsystem in shipping builds)
+    if (UMazeDebugVisualizerSubsystem* DebugView = InWorld.GetSubsystem<UMazeDebugVisualizerSubsystem>())
+    {
+        TWeakObjectPtr<UMazeBeliefSubsystem> WeakThis(this);
+
+        DebugView->RegisterLayer(TEXT("belief"), [WeakThis](const AMazeManager& Maze, FMazeDebugSample& Sample)
+        {
+            const UMazeBeliefSubsystem* Self = WeakThis.Get();
+            if (!Self)
+            {
+                return false;
+            }
+
+            const FIntPoint Size = Maze.GetMazeSize();
+            bool bAny = false;
+
+            for (const TWeakObjectPtr<UMazeBeliefComponent>& WeakBelief : Self->Beliefs)
+            {
+                const UMazeBeliefComponent* Belief = WeakBelief.Get();
+                const FMazeBeliefTopology* Topology = Belief ? Belief->GetTopology() : nullptr;
+                if (!Topology || Belief->GetCurrentMaze() != &Maze || Topology->GetSize() != Size)
+                {
+                    continue;
+                }
+
+                // Shown cells only: the visualizer asks for a window, not the grid
+                for (int32 Y = Sample.Rect.Min.Y; Y < Sample.Rect.Max.Y; ++Y)
+                {
+                    for (int32 X = Sample.Rect.Min.X; X < Sample.Rect.Max.X; ++X)
+                    {
+                        const float Probability = Belief->GetPlayerProbabilityAtCell(FIntPoint(X, Y));
+                        if (Probability > 0.0f)
+                        {
+                            float& Value = Sample.At(X, Y);
+                            Value = FMath::Max(Value, 0.0f) + Probability;
+                        }
+                    }
+                }
+                bAny = true;
+            }
+            return bAny;
+        });
+    }
+}
+
+void UMazeBeliefSubsystem::Deinitialize()
+{
+    if (UMazeDebugVisualizerSubsystem* DebugView = GetWorld()->GetSubsystem<UMazeDebugVisualizerSubsystem>())
+    {
+        DebugView->UnregisterLayer(TEXT("belief"));
+    }
+
+    Beliefs.Reset();
+    Topologies.Reset();
+    UpdateScratch.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UMazeBeliefSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMazeBeliefSubsystem, STATGROUP_Tickables);
+}
+
+void UMazeBeliefSubsystem::Tick(float DeltaTime)
+{
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate < UpdateInterval || Beliefs.Num() == 0)
+    {
+        return;
+    }
+
+    TimeSinceUpdate = 0.0f;
+    UpdateBeliefs();
+}
+
+//=============================================================================
+// REGISTRATION
+//=============================================================================
+
+void UMazeBeliefSubsystem::RegisterBelief(UMazeBeliefComponent* Belief)
+{
+    if (Belief)
+    {
+        Beliefs.AddUnique(Belief);
+    }
+}
+
+void UMazeBeliefSubsystem::UnregisterBelief(UMazeBeliefComponent* Belief)
+{
+    Beliefs.Remove(Belief);
+}
+
+TSharedPtr<const FMazeBeliefTopology> UMazeBeliefSubsystem::GetTopology(const AMazeManager& Maze)
+{
+    const UMazePathfinder* Pathfinder = Maze.GetPathfinder();
+    if (!Pathfinder || !Pathfinder->IsInitialized())
+    {
+        return nullptr;
+    }
+
+    // Drop mazes that were destroyed (streamed out)
+    Topologies.RemoveAllSwap([](const FTopologyEntry& Entry) { return !Entry.Maze.IsValid(); });
+
+    FTopologyEntry* Entry = Topologies.FindByPredicate([&Maze](const FTopologyEntry& Candidate)
+    {
+        return Candidate.Maze.Get() == &Maze;
+    });
+
+    if (!Entry)
+    {
+        Entry = &Topologies.AddDefaulted_GetRef();
+        Entry->Maze = &Maze;
+    }
+
+    const FMazeBeliefTopology* Existing = Entry->Topology.Get();
+    if (!Existing ||
+        Existing->GetGridHash() != Pathfinder->GetGridHash() ||
+        Existing->GetSize() != Pathfinder->GetMazeSize() ||
+        Existing->GetDiffusionRate() != FMath::Clamp(DiffusionRate, 0.0f, 0.25f))
+    {
+        // New object rather than rebuilding in place: a worker may still be
+        // reading the old one through a component's pointer
+        TSharedPtr<FMazeBeliefTopology> Rebuilt = MakeShared<FMazeBeliefTopology>();
+        Rebuilt->Build(Pathfinder->GetWalkableGrid(), Pathfinder->GetMazeSize(), DiffusionRate, Pathfinder->GetGridHash());
+        Entry->Topology = Rebuilt;
+    }
+
+    return Entry->Topology->IsValid() ? Entry->Topology : nullptr;
+}
+
+//=============================================================================
+// UPDATE
+//=============================================================================
+
+void UMazeBeliefSubsystem::UpdateBeliefs()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Beliefs.RemoveAllSwap([](const TWeakObjectPtr<UMazeBeliefComponent>& Belief) { return !Belief.IsValid(); });
+
+    const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    const APawn* Player = PC ? PC->GetPawn() : nullptr;
+
+    // 1. Game thread: gather positions
+    UpdateScratch.Reset();
+    for (const TWeakObjectPtr<UMazeBeliefComponent>& WeakBelief : Beliefs)
+    {
+        UMazeBeliefComponent* Belief = WeakBelief.Get();
+        if (Belief && Belief->IsActive() && Belief->PrepareUpdate(*this, Player))
+        {
+            UpdateScratch.Add(Belief);
+        }
+    }
+
+    // 2. Workers: each map only touches its own arrays
+    ParallelFor(UpdateScratch.Num(), [this](int32 Index)
+    {
+        UpdateScratch[Index]->RunUpdate();
+    });
+
+    // 3. Game thread: events
+    for (UMazeBeliefComponent* Belief : UpdateScratch)
+    {
+        Belief->FinishUpdate();
+    }
+    UpdateScratch.Reset();
+
+    LastUpdateMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+float UMazeBeliefSubsystem::BenchmarkBeliefUpdate(AMazeManager* Maze, int32 NumMaps, int32 Iterations, int32 ViewRadius)
+{
+    const UMazePathfinder* Pathfinder = Maze ? Maze->GetPathfinder() : nullptr;
+    const TSharedPtr<const FMazeBeliefTopology> Topology = Maze ? GetTopology(*Maze) : nullptr;
+    if (!Pathfinder || !Topology || NumMaps <= 0 || Iterations <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeBelief: Benchmark needs a loaded maze"));
+        return 0.0f;
+    }
+
+    const FMazeBeliefTopology& Layout = *Topology;
+    const FIntPoint Size = Layout.GetSize();
+
+    // Enemies stand on random floor cells
+    TArray<FIntPoint> FloorCells;
+    const TArray<uint8>& Walkable = Pathfinder->GetWalkableGrid();
+    for (int32 i = 0; i < Walkable.Num(); ++i)
+    {
+        if (Walkable[i])
+        {
+            FloorCells.Add(FIntPoint(i % Size.X, i / Size.X));
+        }
+    }
+
+    FRandomStream Random(12345);
+    TArray<FMazeBeliefMap> Maps;
+    TArray<FIntPoint> EnemyCells;
+    TArray<TArray<int32>> Visible;
+    Maps.SetNum(NumMaps);
+    Visible.SetNum(NumMaps);
+    for (int32 m = 0; m < NumMaps; ++m)
+    {
+        Maps[m].Reset(Layout);
+        EnemyCells.Add(FloorCells[Random.RandRange(0, FloorCells.Num() - 1)]);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        ParallelFor(NumMaps, [&](int32 m)
+        {
+            FMazeBeliefMap& Map = Maps[m];
+            Map.Diffuse(Layout, 1);
+
+            Visible[m].Reset();
+            Pathfinder->ForEachVisibleCell(EnemyCells[m], ViewRadius, [&](FIntPoint Cell)
+            {
+                Visible[m].Add(Layout.ToPadded(Cell));
+            });
+
+            for (const int32 Index : Visible[m])
+            {
+                Map.ClearCell(Index);
+            }
+            Map.Settle(Layout, Visible[m]);
+        });
+    }
+
+    const float AverageMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations);
+
+    UE_LOG(LogTemp, Log, TEXT("MazeBelief: %dx%d maze (%d floor cells), %d maps: %.3f ms per update (%.3f ms per map)"),
+        Size.X, Size.Y, Layout.GetNumFloor(), NumMaps, AverageMs, AverageMs / NumMaps);
+
+    return AverageMs;
+}
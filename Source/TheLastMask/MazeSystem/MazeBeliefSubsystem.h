@@ -0,0 +1,106 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/MazeBeliefMap.h"
+#include "MazeBeliefSubsystem.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    ParallelFor(Num, Lambda):
+        - Runs Lambda(0..Num-1) across the task graph worker threads and
+          waits for all of them
+        - One belief map per index: maps share nothing writable, so no locks
+
+    TSharedPtr<const T>:
+        - Reference-counted pointer for plain C++ objects
+        - A rebuilt topology replaces the pointer; components still holding
+          the old one keep it alive until their next update
+=============================================================================*/
+
+class AMazeManager;
+class UMazeBeliefComponent;
+
+/**
+ * Updates every UMazeBeliefComponent in the world together.
+ *
+ * Every UpdateInterval seconds:
+ *   1. Game thread: each component finds its maze, cell and facing
+ *   2. Workers: diffusion + view clearing for all maps in parallel
+ *   3. Game thread: spotted / lost events
+ *
+ * Diffusion weights depend only on the maze layout, so they are built once
+ * per maze (and again when its grid hash changes) and shared by every
+ * enemy in it.
+ */
+UCLASS()
+class THELASTMASK_API UMazeBeliefSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Seconds between belief updates */
+    float UpdateInterval = 0.1f;
+
+    /** Share of a cell's belief passed to each floor neighbour per step (max 0.25) */
+    float DiffusionRate = 0.2f;
+
+    //=========================================================================
+    // REGISTRATION (called by UMazeBeliefComponent)
+    //=========================================================================
+
+    void RegisterBelief(UMazeBeliefComponent* Belief);
+    void UnregisterBelief(UMazeBeliefComponent* Belief);
+
+    /**
+     * Shared diffusion layout for a maze, rebuilt when its grid hash or
+     * DiffusionRate changed. Null if the maze has no pathfinding data.
+     */
+    TSharedPtr<const FMazeBeliefTopology> GetTopology(const AMazeManager& Maze);
+
+    //=========================================================================
+    // UPDATE
+    //=========================================================================
+
+    /** Update every registered belief now (Tick does this on its interval) */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Belief")
+    void UpdateBeliefs();
+
+    /** Wall time of the last UpdateBeliefs, all enemies */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Belief")
+    float GetLastUpdateMs() const { return LastUpdateMs; }
+
+    /**
+     * Time NumMaps belief updates (one diffusion step + view clearing
+     * from a random cell each) on a maze, run the same way as in game.
+     *
+     * @return Average milliseconds per update of all NumMaps maps
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Belief")
+    float BenchmarkBeliefUpdate(AMazeManager* Maze, int32 NumMaps = 10, int32 Iterations = 200, int32 ViewRadius = 10);
+
+private:
+    struct FTopologyEntry
+    {
+        TWeakObjectPtr<const AMazeManager> Maze;
+        TSharedPtr<const FMazeBeliefTopology> Topology;
+    };
+
+    TArray<FTopologyEntry> Topologies;
+
+    TArray<TWeakObjectPtr<UMazeBeliefComponent>> Beliefs;
+
+    /** Components taking part in the current update (reused) */
+    TArray<UMazeBeliefComponent*> UpdateScratch;
+
+    float TimeSinceUpdate = 0.0f;
+    float LastUpdateMs = 0.0f;
+};
@@ -0,0 +1,162 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeChunkPrefetchComponent.h"
+#include "MazeDifficultyDirector.h"
+#include "MazeManager.h"
+#include "MazeRuntimeGeometryComponent.h"
+#include "Core/MazePathfinder.h"
+#include "GameFramework/Actor.h"
+
+UMazeChunkPrefetchComponent::UMazeChunkPrefetchComponent()
+{
+    // Ranking is event driven; the tick only spends the load budget
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickInterval = 0.1f;
+}
+
+void UMazeChunkPrefetchComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    UMazeDifficultyDirectorComponent* DirectorPtr = Director.Get();
+    if (!DirectorPtr && GetOwner())
+    {
+        DirectorPtr = GetOwner()->FindComponentByClass<UMazeDifficultyDirectorComponent>();
+    }
+
+    if (!DirectorPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeChunkPrefetch: No difficulty director on %s, no chunks will be prefetched"),
+            *GetNameSafe(GetOwner()));
+        SetComponentTickEnabled(false);
+        return;
+    }
+
+    BoundDirector = DirectorPtr;
+    CellChangedHandle = DirectorPtr->OnPlayerCellChangedNative.AddUObject(this, &UMazeChunkPrefetchComponent::HandlePlayerCellChanged);
+}
+
+void UMazeChunkPrefetchComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get())
+    {
+        DirectorPtr->OnPlayerCellChangedNative.Remove(CellChangedHandle);
+    }
+    CellChangedHandle.Reset();
+    BoundDirector.Reset();
+    BindMaze(nullptr);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UMazeChunkPrefetchComponent::HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics)
+{
+    bPrioritiesDirty = true;
+}
+
+void UMazeChunkPrefetchComponent::HandlePathChanged(TArrayView<const FIntPoint> PathCells, const FMazePathDelta& Delta)
+{
+    bPrioritiesDirty = true;
+}
+
+void UMazeChunkPrefetchComponent::BindMaze(AMazeManager* Maze)
+{
+    if (AMazeManager* OldMaze = BoundMaze.Get())
+    {
+        OldMaze->OnPathChangedNative.Remove(PathChangedHandle);
+    }
+    PathChangedHandle.Reset();
+    BoundMaze = Maze;
+
+    if (Maze)
+    {
+        PathChangedHandle = Maze->OnPathChangedNative.AddUObject(this, &UMazeChunkPrefetchComponent::HandlePathChanged);
+    }
+    bPrioritiesDirty = true;
+}
+
+void UMazeChunkPrefetchComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    AMazeManager* Maze = DirectorPtr ? DirectorPtr->GetCurrentMaze() : nullptr;
+    if (Maze != BoundMaze.Get())
+    {
+        BindMaze(Maze);
+    }
+
+    const UMazeRuntimeGeometryComponent* Geometry = Maze ? Maze->GetRuntimeGeometry() : nullptr;
+    const UMazePathfinder* Pathfinder = Maze ? Maze->GetPathfinder() : nullptr;
+    if (!Geometry || !Geometry->bStreamChunks || !Geometry->HasGeometry() || !Pathfinder || !Pathfinder->IsInitialized())
+    {
+        // Baked level actors are shown, or nothing is streamed
+        WantedChunks.Reset();
+        PendingChunks = 0;
+        return;
+    }
+
+    // Edits change what is reachable; rebuilds empty the chunks even when
+    // the layout (and so the hash, cell and path) stayed the same
+    if (Pathfinder->GetGridHash() != PrioritizedGridHash || Geometry->GetBuildSerial() != PrioritizedBuildSerial)
+    {
+        bPrioritiesDirty = true;
+    }
+
+    if (!bPrioritiesDirty && PendingChunks == 0)
+    {
+        return;
+    }
+
+    if (bPrioritiesDirty)
+    {
+        UpdatePriorities(*Maze);
+    }
+
+    PendingChunks = Maze->StreamGeometryChunks(WantedChunks, MaxChunkLoadsPerTick);
+}
+
+void UMazeChunkPrefetchComponent::UpdatePriorities(const AMazeManager& Maze)
+{
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    const UMazeRuntimeGeometryComponent* Geometry = Maze.GetRuntimeGeometry();
+    const UMazePathfinder* Pathfinder = Maze.GetPathfinder();
+    const FIntPoint PlayerCell = DirectorPtr->GetPlayerCell();
+    const FIntPoint MazeSize = Maze.GetMazeSize();
+
+    ChunkSteps.Reset();
+    auto Want = [this, Geometry](FIntPoint Cell, int32 Steps)
+    {
+        int32& Best = ChunkSteps.FindOrAdd(Geometry->GetChunkOfCell(Cell), MAX_int32);
+        Best = FMath::Min(Best, Steps);
+    };
+
+    // The player's own chunk, even while standing on a wall edge
+    if (PlayerCell.X >= 0 && PlayerCell.X < MazeSize.X && PlayerCell.Y >= 0 && PlayerCell.Y < MazeSize.Y)
+    {
+        Want(PlayerCell, 0);
+    }
+
+    // Corridors the player can reach soon
+    Pathfinder->ForEachCellWithinSteps(PlayerCell, PrefetchSteps, Want);
+
+    // Further along the route, counting steps from where the player is on it
+    const TArrayView<const FIntPoint> Path = Maze.GetCurrentPathCells();
+    if (PathLookaheadCells > 0 && Path.Num() > 0)
+    {
+        const int32 OnPath = Path.Find(PlayerCell);
+        const int32 First = OnPath != INDEX_NONE ? OnPath : 0;
+        const int32 Last = FMath::Min(Path.Num() - 1, First + PathLookaheadCells);
+        for (int32 i = First; i <= Last; ++i)
+        {
+            Want(Path[i], i - First);
+        }
+    }
+
+    ChunkSteps.ValueSort(TLess<int32>());
+    ChunkSteps.GenerateKeyArray(WantedChunks);
+
+    PrioritizedGridHash = Pathfinder->GetGridHash();
+    PrioritizedBuildSerial = Geometry->GetBuildSerial();
+    bPrioritiesDirty = false;
+}
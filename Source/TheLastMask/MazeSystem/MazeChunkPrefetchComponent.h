@@ -0,0 +1,108 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MazeChunkPrefetchComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    Graph distance instead of radius:
+        - A chunk 3 cells away behind a wall can be 200 steps away on foot;
+          a chunk 30 cells down a straight corridor is only 30
+        - A bounded BFS from the player ranks chunks by how soon the player
+          can actually stand in them
+        - The current target path adds the chunks further along the route,
+          ranked by their step count along it (same units as the BFS)
+
+    Load budget:
+        - Filling a chunk rebuilds its instance buffers, so only a couple
+          are filled per tick, nearest first; the rest wait their turn
+=============================================================================*/
+
+class AMazeManager;
+class UMazeDifficultyDirectorComponent;
+struct FMazeLostnessMetrics;
+struct FMazePathDelta;
+
+/**
+ * Streaming source for UMazeRuntimeGeometryComponent chunks.
+ *
+ * Add next to a UMazeDifficultyDirectorComponent (player pawn) and tick
+ * bStreamChunks on the maze's runtime geometry. Chunks reachable within
+ * PrefetchSteps and chunks along the current path are filled first;
+ * chunks nobody wants are emptied once MaxResidentChunks is reached.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazeChunkPrefetchComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazeChunkPrefetchComponent();
+
+    /** Optional: director to follow. Empty = the one on the owning actor. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Streaming")
+    TObjectPtr<UMazeDifficultyDirectorComponent> Director;
+
+    /** Walking steps from the player whose chunks are prefetched */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Streaming", meta = (ClampMin = "0"))
+    int32 PrefetchSteps = 40;
+
+    /** Cells of the current path ahead of the player whose chunks are prefetched (0 = ignore the path) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Streaming", meta = (ClampMin = "0"))
+    int32 PathLookaheadCells = 96;
+
+    /** Chunks filled per tick at most */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Streaming", meta = (ClampMin = "1"))
+    int32 MaxChunkLoadsPerTick = 2;
+
+    /** Chunks wanted right now, most wanted first */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Streaming")
+    TArray<FIntPoint> GetWantedChunks() const { return WantedChunks; }
+
+    /** Wanted chunks still waiting for the load budget */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Streaming")
+    int32 GetPendingChunkCount() const { return PendingChunks; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /** Director callback: priorities are stale */
+    void HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics);
+
+    /** Maze callback: the route ahead changed */
+    void HandlePathChanged(TArrayView<const FIntPoint> PathCells, const FMazePathDelta& Delta);
+
+    /** Follow the director's maze for path changes */
+    void BindMaze(AMazeManager* Maze);
+
+    /** Rank chunks by steps from the player (BFS + current path) */
+    void UpdatePriorities(const AMazeManager& Maze);
+
+private:
+    TWeakObjectPtr<UMazeDifficultyDirectorComponent> BoundDirector;
+    FDelegateHandle CellChangedHandle;
+
+    TWeakObjectPtr<AMazeManager> BoundMaze;
+    FDelegateHandle PathChangedHandle;
+
+    bool bPrioritiesDirty = true;
+
+    /** Grid the priorities were ranked on */
+    uint64 PrioritizedGridHash = 0;
+
+    /** Geometry build the priorities were streamed into */
+    uint32 PrioritizedBuildSerial = 0;
+
+    /** Chunks in priority order */
+    TArray<FIntPoint> WantedChunks;
+    int32 PendingChunks = 0;
+
+    /** Fewest steps to each chunk (scratch, kept between updates) */
+    TMap<FIntPoint, int32> ChunkSteps;
+};
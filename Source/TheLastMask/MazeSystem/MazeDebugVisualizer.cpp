@@ -0,0 +1,781 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeDebugVisualizer.h"
+#include "MazeManager.h"
+#include "MazeWorldSubsystem.h"
+#include "Core/MazePathfinder.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "CanvasItem.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "HAL/IConsoleManager.h"
+
+namespace MazeDebug
+{
+    /** Distance field towards the current target, shared by "distance" and "flow" */
+    struct FTargetFieldCache
+    {
+        TWeakObjectPtr<const AMazeManager> Maze;
+        uint64 GridHash = 0;
+        FIntPoint Target = FIntPoint(-1, -1);
+        TArray<int32> Distances;
+        bool bValid = false;
+    };
+
+    /** Connected component label per floor cell, shared by "components" */
+    struct FComponentCache
+    {
+        TWeakObjectPtr<const AMazeManager> Maze;
+        uint64 GridHash = 0;
+        TArray<int32> Labels;
+    };
+
+    /** Rebuild the target field only when the maze, its layout or the target changed */
+    const TArray<int32>* GetTargetField(FTargetFieldCache& Cache, const AMazeManager& Maze)
+    {
+        const UMazePathfinder* Pathfinder = Maze.GetPathfinder();
+        if (!Pathfinder || !Pathfinder->IsInitialized())
+        {
+            return nullptr;
+        }
+
+        const FIntPoint Target = Maze.GetCurrentTargetGridPosition();
+        if (Cache.Maze.Get() != &Maze || Cache.GridHash != Pathfinder->GetGridHash() || Cache.Target != Target)
+        {
+            Cache.Maze = &Maze;
+            Cache.GridHash = Pathfinder->GetGridHash();
+            Cache.Target = Target;
+            Cache.bValid = Pathfinder->BuildDistanceField({ Target }, Cache.Distances);
+        }
+
+        return Cache.bValid ? &Cache.Distances : nullptr;
+    }
+
+#if !UE_BUILD_SHIPPING
+    void HandleCommand(const TArray<FString>& Args, UWorld* World)
+    {
+        if (UMazeDebugVisualizerSubsystem* Visualizer = World ? World->GetSubsystem<UMazeDebugVisualizerSubsystem>() : nullptr)
+        {
+            Visualizer->ExecuteCommand(Args);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("maze.debug: No visualizer in this world (game and PIE worlds only)"));
+        }
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs DebugCommand(
+        TEXT("maze.debug"),
+        TEXT("Maze heatmap viewer. maze.debug <layer> | off | list | mode overlay|world | window <cells> | interval <seconds> | budget <cells>"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&HandleCommand));
+#endif
+}
+
+//=============================================================================
+// SUBSYSTEM
+//=============================================================================
+
+bool UMazeDebugVisualizerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+bool UMazeDebugVisualizerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMazeDebugVisualizerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Blue -> cyan -> green -> yellow -> red
+    const FLinearColor Stops[] = {
+        FLinearColor(0.0f, 0.0f, 1.0f), FLinearColor(0.0f, 1.0f, 1.0f), FLinearColor(0.0f, 1.0f, 0.0f),
+        FLinearColor(1.0f, 1.0f, 0.0f), FLinearColor(1.0f, 0.0f, 0.0f) };
+
+    HeatPalette.SetNumUninitialized(256);
+    for (int32 i = 0; i < 256; ++i)
+    {
+        const float T = i / 255.0f * (UE_ARRAY_COUNT(Stops) - 1);
+        const int32 Stop = FMath::Min(FMath::FloorToInt(T), static_cast<int32>(UE_ARRAY_COUNT(Stops)) - 2);
+        FColor Color = FMath::Lerp(Stops[Stop], Stops[Stop + 1], T - Stop).ToFColor(true);
+        Color.A = 200;
+        HeatPalette[i] = Color;
+    }
+
+    RegisterBuiltInLayers();
+
+    DrawHandle = UDebugDrawService::Register(TEXT("Game"),
+        FDebugDrawDelegate::CreateUObject(this, &UMazeDebugVisualizerSubsystem::DrawOverlay));
+}
+
+void UMazeDebugVisualizerSubsystem::Deinitialize()
+{
+    UDebugDrawService::Unregister(DrawHandle);
+    DrawHandle.Reset();
+
+    Layers.Reset();
+    ActiveLayer = NAME_None;
+    Values.Empty();
+    PassValues.Empty();
+    OverlayTexture = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UMazeDebugVisualizerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMazeDebugVisualizerSubsystem, STATGROUP_Tickables);
+}
+
+void UMazeDebugVisualizerSubsystem::Tick(float DeltaTime)
+{
+    if (ActiveLayer.IsNone())
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    float ViewFOV = 90.0f;
+    const AMazeManager* Maze = nullptr;
+    FIntPoint Cell;
+    if (!ResolveViewer(ViewLocation, ViewRotation, ViewFOV, Maze, Cell))
+    {
+        return;
+    }
+
+    ViewerCell = Cell;
+
+    // A pass over another maze (or a resized one) is stale before it ends
+    if (bSampling && (SamplingMaze.Get() != Maze || SamplingGridSize != Maze->GetMazeSize()))
+    {
+        bSampling = false;
+        LastSampleTime = -1.0;
+    }
+
+    // Resample on a timer or when the window moved; a pass in progress
+    // finishes first so windows over the budget still complete
+    const FIntRect WantedWindow = ComputeWantedWindow(Cell, Maze->GetMazeSize());
+    const double Now = GetWorld()->GetRealTimeSeconds();
+    if (!bSampling && (SampledMaze.Get() != Maze || LastSampleTime < 0.0 ||
+        Now - LastSampleTime >= SampleInterval || WantedWindow != ShownWindow))
+    {
+        BeginSamplePass(*Maze, WantedWindow);
+        LastSampleTime = Now;
+    }
+
+    if (bSampling)
+    {
+        ContinueSamplePass(*Maze);
+    }
+
+    if (!bHasValues || SampledMaze.Get() != Maze)
+    {
+        return;
+    }
+
+    if (DrawMode == EMazeDebugDrawMode::Overlay)
+    {
+        if (bOverlayDirty)
+        {
+            UploadOverlay();
+        }
+    }
+    else
+    {
+        DrawWorldCells(*Maze, ViewLocation, ViewRotation, ViewFOV);
+    }
+}
+
+//=============================================================================
+// LAYERS
+//=============================================================================
+
+void UMazeDebugVisualizerSubsystem::RegisterLayer(FName Name, FMazeDebugLayerSampler Sampler)
+{
+    if (Name.IsNone() || !Sampler)
+    {
+        return;
+    }
+
+    Layers.Add(Name, MoveTemp(Sampler));
+
+    // Replacing the shown layer: pick up the new sampler right away
+    if (Name == ActiveLayer)
+    {
+        LastSampleTime = -1.0;
+    }
+}
+
+void UMazeDebugVisualizerSubsystem::UnregisterLayer(FName Name)
+{
+    Layers.Remove(Name);
+
+    if (Name == ActiveLayer)
+    {
+        HideLayer();
+    }
+}
+
+TArray<FName> UMazeDebugVisualizerSubsystem::GetLayerNames() const
+{
+    TArray<FName> Names;
+    Layers.GetKeys(Names);
+    Names.Sort(FNameLexicalLess());
+    return Names;
+}
+
+void UMazeDebugVisualizerSubsystem::RegisterBuiltInLayers()
+{
+    // Floor 1, wall 0
+    RegisterLayer(TEXT("walkable"), [](const AMazeManager& Maze, FMazeDebugSample& Sample)
+    {
+        const UMazePathfinder* Pathfinder = Maze.GetPathfinder();
+        const FIntPoint Size = Maze.GetMazeSize();
+        if (!Pathfinder || Pathfinder->GetWalkableGrid().Num() != Size.X * Size.Y)
+        {
+            return false;
+        }
+
+        const TArray<uint8>& Walkable = Pathfinder->GetWalkableGrid();
+        for (int32 Y = Sample.Rect.Min.Y; Y < Sample.Rect.Max.Y; ++Y)
+        {
+            for (int32 X = Sample.Rect.Min.X; X < Sample.Rect.Max.X; ++X)
+            {
+                Sample.At(X, Y) = Walkable[Y * Size.X + X];
+            }
+        }
+        return true;
+    });
+
+    TSharedRef<MazeDebug::FTargetFieldCache> TargetCache = MakeShared<MazeDebug::FTargetFieldCache>();
+
+    // Maze distance to the current target (exit or key)
+    RegisterLayer(TEXT("distance"), [TargetCache](const AMazeManager& Maze, FMazeDebugSample& Sample)
+    {
+        const TArray<int32>* Field = MazeDebug::GetTargetField(*TargetCache, Maze);
+        const FIntPoint Size = Maze.GetMazeSize();
+        if (!Field || Field->Num() != Size.X * Size.Y)
+        {
+            return false;
+        }
+
+        for (int32 Y = Sample.Rect.Min.Y; Y < Sample.Rect.Max.Y; ++Y)
+        {
+            for (int32 X = Sample.Rect.Min.X; X < Sample.Rect.Max.X; ++X)
+            {
+                Sample.At(X, Y) = static_cast<float>((*Field)[Y * Size.X + X]);
+            }
+        }
+        return true;
+    });
+
+    // Step towards the target: 0 East, 1 West, 2 South, 3 North, 4 at the target
+    RegisterLayer(TEXT("flow"), [TargetCache](const AMazeManager& Maze, FMazeDebugSample& Sample)
+    {
+        const TArray<int32>* Field = MazeDebug::GetTargetField(*TargetCache, Maze);
+        const FIntPoint Size = Maze.GetMazeSize();
+        if (!Field || Field->Num() != Size.X * Size.Y)
+        {
+            return false;
+        }
+
+        const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+        for (int32 Y = Sample.Rect.Min.Y; Y < Sample.Rect.Max.Y; ++Y)
+        {
+            for (int32 X = Sample.Rect.Min.X; X < Sample.Rect.Max.X; ++X)
+            {
+                const int32 Distance = (*Field)[Y * Size.X + X];
+                if (Distance <= 0)
+                {
+                    Sample.At(X, Y) = Distance == 0 ? 4.0f : -1.0f;
+                    continue;
+                }
+
+                for (int32 Dir = 0; Dir < 4; ++Dir)
+                {
+                    const FIntPoint Next(X + Offsets[Dir].X, Y + Offsets[Dir].Y);
+                    if (Next.X >= 0 && Next.X < Size.X && Next.Y >= 0 && Next.Y < Size.Y &&
+                        (*Field)[Next.Y * Size.X + Next.X] == Distance - 1)
+                    {
+                        Sample.At(X, Y) = static_cast<float>(Dir);
+                        break;
+                    }
+                }
+            }
+        }
+        return true;
+    });
+
+    // Connected floor regions, one label each (relabelled only when the layout changes)
+    TSharedRef<MazeDebug::FComponentCache> ComponentCache = MakeShared<MazeDebug::FComponentCache>();
+    RegisterLayer(TEXT("components"), [ComponentCache](const AMazeManager& Maze, FMazeDebugSample& Sample)
+    {
+        const UMazePathfinder* Pathfinder = Maze.GetPathfinder();
+        const FIntPoint Size = Maze.GetMazeSize();
+        if (!Pathfinder || Pathfinder->GetWalkableGrid().Num() != Size.X * Size.Y)
+        {
+            return false;
+        }
+
+        if (ComponentCache->Maze.Get() != &Maze || ComponentCache->GridHash != Pathfinder->GetGridHash())
+        {
+            ComponentCache->Maze = &Maze;
+            ComponentCache->GridHash = Pathfinder->GetGridHash();
+
+            const TArray<uint8>& Walkable = Pathfinder->GetWalkableGrid();
+            TArray<int32>& Labels = ComponentCache->Labels;
+            Labels.Init(INDEX_NONE, Walkable.Num());
+
+            TArray<int32> Queue;
+            int32 NextLabel = 0;
+            for (int32 Seed = 0; Seed < Walkable.Num(); ++Seed)
+            {
+                if (!Walkable[Seed] || Labels[Seed] != INDEX_NONE)
+                {
+                    continue;
+                }
+
+                Queue.Reset();
+                Queue.Add(Seed);
+                Labels[Seed] = NextLabel;
+                for (int32 Head = 0; Head < Queue.Num(); ++Head)
+                {
+                    const int32 Index = Queue[Head];
+                    const int32 X = Index % Size.X;
+                    const int32 Neighbors[] = {
+                        X + 1 < Size.X ? Index + 1 : INDEX_NONE,
+                        X > 0 ? Index - 1 : INDEX_NONE,
+                        Index + Size.X < Walkable.Num() ? Index + Size.X : INDEX_NONE,
+                        Index - Size.X };
+
+                    for (const int32 Neighbor : Neighbors)
+                    {
+                        if (Neighbor >= 0 && Walkable[Neighbor] && Labels[Neighbor] == INDEX_NONE)
+                        {
+                            Labels[Neighbor] = NextLabel;
+                            Queue.Add(Neighbor);
+                        }
+                    }
+                }
+                ++NextLabel;
+            }
+        }
+
+        for (int32 Y = Sample.Rect.Min.Y; Y < Sample.Rect.Max.Y; ++Y)
+        {
+            for (int32 X = Sample.Rect.Min.X; X < Sample.Rect.Max.X; ++X)
+            {
+                Sample.At(X, Y) = static_cast<float>(ComponentCache->Labels[Y * Size.X + X]);
+            }
+        }
+        return true;
+    });
+
+    // Current guidance path, colored by step (start cold, end hot)
+    RegisterLayer(TEXT("path"), [](const AMazeManager& Maze, FMazeDebugSample& Sample)
+    {
+        const TArrayView<const FIntPoint> Path = Maze.GetCurrentPathCells();
+        if (Path.Num() == 0)
+        {
+            return false;
+        }
+
+        for (int32 Step = 0; Step < Path.Num(); ++Step)
+        {
+            if (Sample.Rect.Contains(Path[Step]))
+            {
+                Sample.At(Path[Step].X, Path[Step].Y) = static_cast<float>(Step);
+            }
+        }
+        return true;
+    });
+}
+
+//=============================================================================
+// DISPLAY
+//=============================================================================
+
+bool UMazeDebugVisualizerSubsystem::ShowLayer(FName Name)
+{
+    if (!Layers.Contains(Name))
+    {
+        return false;
+    }
+
+    ActiveLayer = Name;
+    LastSampleTime = -1.0;
+    bHasValues = false;
+    bSampling = false;
+    bOverlayDirty = true;
+    return true;
+}
+
+void UMazeDebugVisualizerSubsystem::HideLayer()
+{
+    ActiveLayer = NAME_None;
+    bHasValues = false;
+    bSampling = false;
+    SampledMaze.Reset();
+    SamplingMaze.Reset();
+}
+
+void UMazeDebugVisualizerSubsystem::SetDrawMode(EMazeDebugDrawMode NewMode)
+{
+    DrawMode = NewMode;
+    bOverlayDirty = true;
+}
+
+void UMazeDebugVisualizerSubsystem::ExecuteCommand(const TArray<FString>& Args)
+{
+    if (Args.Num() == 0 || Args[0] == TEXT("list"))
+    {
+        FString Names;
+        for (const FName& Name : GetLayerNames())
+        {
+            Names += Names.IsEmpty() ? Name.ToString() : TEXT(", ") + Name.ToString();
+        }
+        UE_LOG(LogTemp, Display, TEXT("maze.debug layers: %s"), *Names);
+        UE_LOG(LogTemp, Display, TEXT("maze.debug <layer> | off | mode overlay|world | window <cells> | interval <seconds> | budget <cells>"));
+        return;
+    }
+
+    if (Args[0] == TEXT("off"))
+    {
+        HideLayer();
+    }
+    else if (Args[0] == TEXT("mode") && Args.Num() > 1)
+    {
+        SetDrawMode(Args[1] == TEXT("world") ? EMazeDebugDrawMode::World : EMazeDebugDrawMode::Overlay);
+    }
+    else if (Args[0] == TEXT("window") && Args.Num() > 1)
+    {
+        WindowCells = FMath::Max(0, FCString::Atoi(*Args[1]));
+        bOverlayDirty = true;
+    }
+    else if (Args[0] == TEXT("interval") && Args.Num() > 1)
+    {
+        SampleInterval = FMath::Max(0.0f, FCString::Atof(*Args[1]));
+    }
+    else if (Args[0] == TEXT("budget") && Args.Num() > 1)
+    {
+        SampleBudgetCells = FMath::Max(1, FCString::Atoi(*Args[1]));
+    }
+    else if (!ShowLayer(FName(*Args[0])))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("maze.debug: Unknown layer '%s' (maze.debug list)"), *Args[0]);
+    }
+}
+
+bool UMazeDebugVisualizerSubsystem::ResolveViewer(FVector& OutLocation, FRotator& OutRotation, float& OutFOV,
+    const AMazeManager*& OutMaze, FIntPoint& OutCell) const
+{
+    UWorld* World = GetWorld();
+    APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    if (!PlayerController)
+    {
+        return false;
+    }
+
+    PlayerController->GetPlayerViewPoint(OutLocation, OutRotation);
+    OutFOV = PlayerController->PlayerCameraManager ? PlayerController->PlayerCameraManager->GetFOVAngle() : 90.0f;
+
+    const UMazeWorldSubsystem* MazeWorld = World->GetSubsystem<UMazeWorldSubsystem>();
+    if (!MazeWorld)
+    {
+        return false;
+    }
+
+    // The pawn's cell, not the camera's (a spring arm can put it over a wall)
+    const APawn* Pawn = PlayerController->GetPawn();
+    OutCell = FIntPoint(-1, -1);
+    OutMaze = MazeWorld->FindMazeAtLocation(Pawn ? Pawn->GetActorLocation() : OutLocation, OutCell);
+
+    if (!OutMaze)
+    {
+        const TArray<AMazeManager*> Mazes = MazeWorld->GetAllMazes();
+        OutMaze = Mazes.Num() > 0 ? Mazes[0] : nullptr;
+        OutCell = FIntPoint(-1, -1);
+    }
+
+    return OutMaze && OutMaze->GetMazeSize().X > 0 && OutMaze->GetMazeSize().Y > 0;
+}
+
+FIntRect UMazeDebugVisualizerSubsystem::ComputeWantedWindow(FIntPoint Center, FIntPoint GridSize) const
+{
+    if (DrawMode == EMazeDebugDrawMode::Overlay)
+    {
+        return ComputeWindow(Center, GridSize, WindowCells);
+    }
+
+    return ComputeWindow(Center, GridSize, FMath::Clamp(WindowCells <= 0 ? MaxWorldWindow : WindowCells, 1, MaxWorldWindow));
+}
+
+void UMazeDebugVisualizerSubsystem::BeginSamplePass(const AMazeManager& Maze, const FIntRect& Window)
+{
+    bSampling = Window.Area() > 0;
+    SamplingMaze = &Maze;
+    SamplingGridSize = Maze.GetMazeSize();
+    SamplingWindow = Window;
+    NextSampleRow = Window.Min.Y;
+    PassValues.SetNumUninitialized(Window.Area(), EAllowShrinking::No);
+    PassMinValue = MAX_flt;
+    PassMaxValue = -MAX_flt;
+    bPassHasValues = false;
+}
+
+void UMazeDebugVisualizerSubsystem::ContinueSamplePass(const AMazeManager& Maze)
+{
+    const FMazeDebugLayerSampler* Sampler = Layers.Find(ActiveLayer);
+    if (!Sampler)
+    {
+        HideLayer();
+        return;
+    }
+
+    // Whole rows up to the budget; the band is contiguous in PassValues
+    const int32 Width = SamplingWindow.Width();
+    const int32 NumRows = FMath::Clamp(SampleBudgetCells / Width, 1, SamplingWindow.Max.Y - NextSampleRow);
+
+    FMazeDebugSample Sample;
+    Sample.Rect = FIntRect(SamplingWindow.Min.X, NextSampleRow, SamplingWindow.Max.X, NextSampleRow + NumRows);
+    Sample.Values = TArrayView<float>(PassValues).Slice((NextSampleRow - SamplingWindow.Min.Y) * Width, NumRows * Width);
+    for (float& Value : Sample.Values)
+    {
+        Value = -1.0f;
+    }
+
+    if ((*Sampler)(Maze, Sample))
+    {
+        bPassHasValues = true;
+        for (const float Value : Sample.Values)
+        {
+            if (Value >= 0.0f)
+            {
+                PassMinValue = FMath::Min(PassMinValue, Value);
+                PassMaxValue = FMath::Max(PassMaxValue, Value);
+            }
+        }
+    }
+
+    NextSampleRow += NumRows;
+    if (NextSampleRow < SamplingWindow.Max.Y)
+    {
+        return;
+    }
+
+    // Window done: show it
+    bSampling = false;
+    Swap(Values, PassValues);
+    ShownWindow = SamplingWindow;
+    ValuesSize = SamplingGridSize;
+    SampledMaze = SamplingMaze;
+    bHasValues = bPassHasValues;
+    bOverlayDirty = true;
+
+    if (PassMinValue > PassMaxValue)
+    {
+        // Nothing but "no data"
+        MinValue = 0.0f;
+        MaxValue = 1.0f;
+    }
+    else
+    {
+        MinValue = PassMinValue;
+        MaxValue = PassMaxValue;
+    }
+}
+
+FIntRect UMazeDebugVisualizerSubsystem::ComputeWindow(FIntPoint Center, FIntPoint GridSize, int32 EdgeCells) const
+{
+    if (EdgeCells <= 0 || (EdgeCells >= GridSize.X && EdgeCells >= GridSize.Y))
+    {
+        return FIntRect(FIntPoint::ZeroValue, GridSize);
+    }
+
+    if (Center.X < 0 || Center.Y < 0)
+    {
+        Center = GridSize / 2;
+    }
+
+    const FIntPoint Edge(FMath::Min(EdgeCells, GridSize.X), FMath::Min(EdgeCells, GridSize.Y));
+    const FIntPoint Min(
+        FMath::Clamp(Center.X - Edge.X / 2, 0, GridSize.X - Edge.X),
+        FMath::Clamp(Center.Y - Edge.Y / 2, 0, GridSize.Y - Edge.Y));
+
+    return FIntRect(Min, Min + Edge);
+}
+
+FColor UMazeDebugVisualizerSubsystem::ValueToColor(float Value) const
+{
+    if (Value < 0.0f)
+    {
+        return FColor(0, 0, 0, 96);
+    }
+
+    const float Range = MaxValue - MinValue;
+    const float T = Range > 0.0f ? (Value - MinValue) / Range : 1.0f;
+    return HeatPalette[FMath::Clamp(FMath::RoundToInt(T * 255.0f), 0, 255)];
+}
+
+void UMazeDebugVisualizerSubsystem::UploadOverlay()
+{
+    constexpr int32 Resolution = OverlayResolution;
+
+    if (!OverlayTexture)
+    {
+        OverlayTexture = UTexture2D::CreateTransient(Resolution, Resolution, PF_B8G8R8A8);
+        if (!OverlayTexture)
+        {
+            return;
+        }
+        OverlayTexture->Filter = TF_Nearest;
+        OverlayTexture->SRGB = true;
+        OverlayTexture->UpdateResource();
+    }
+
+    const FIntPoint WindowSize = ShownWindow.Size();
+    if (WindowSize.X <= 0 || WindowSize.Y <= 0)
+    {
+        return;
+    }
+
+    // Nearest cell per texel: the cost is fixed, whatever the window covers.
+    // The render thread owns the buffer until the cleanup callback runs.
+    FColor* Pixels = new FColor[Resolution * Resolution];
+    for (int32 TexelY = 0; TexelY < Resolution; ++TexelY)
+    {
+        const float* Row = &Values[(TexelY * WindowSize.Y / Resolution) * WindowSize.X];
+        FColor* OutRow = &Pixels[TexelY * Resolution];
+
+        for (int32 TexelX = 0; TexelX < Resolution; ++TexelX)
+        {
+            OutRow[TexelX] = ValueToColor(Row[TexelX * WindowSize.X / Resolution]);
+        }
+    }
+
+    FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Resolution, Resolution);
+    OverlayTexture->UpdateTextureRegions(0, 1, Region, Resolution * sizeof(FColor), sizeof(FColor),
+        reinterpret_cast<uint8*>(Pixels),
+        [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+        {
+            delete[] reinterpret_cast<FColor*>(SrcData);
+            delete Regions;
+        });
+
+    bOverlayDirty = false;
+}
+
+void UMazeDebugVisualizerSubsystem::DrawWorldCells(const AMazeManager& Maze, const FVector& ViewLocation,
+    const FRotator& ViewRotation, float ViewFOV)
+{
+    ULineBatchComponent* LineBatcher = GetWorld()->GetLineBatcher(UWorld::ELineBatcherType::World);
+    if (!LineBatcher)
+    {
+        return;
+    }
+
+    // Draw what was sampled; right after switching from the overlay that can
+    // still be the overlay's (bigger) window until the next pass lands
+    const FIntRect& Window = ShownWindow;
+    const int32 WindowWidth = Window.Width();
+    if (WindowWidth > MaxWorldWindow || Window.Height() > MaxWorldWindow)
+    {
+        return;
+    }
+
+    // Cell (X, Y) center = Origin + X * StepX + Y * StepY (handles yawed mazes)
+    const FVector Origin = Maze.MazeCellToWorld(FIntPoint(0, 0)) + FVector(0.0, 0.0, 5.0);
+    const FVector StepX = Maze.MazeCellToWorld(FIntPoint(1, 0)) - Maze.MazeCellToWorld(FIntPoint(0, 0));
+    const FVector StepY = Maze.MazeCellToWorld(FIntPoint(0, 1)) - Maze.MazeCellToWorld(FIntPoint(0, 0));
+    const float CellSize = Maze.GetCellSize();
+
+    // Cone a bit wider than the FOV so cells at the screen corners survive
+    const FVector Forward = ViewRotation.Vector();
+    const double CosLimit = FMath::Cos(FMath::DegreesToRadians(FMath::Min(ViewFOV * 0.75f, 89.0f)));
+
+    LineScratch.Reset();
+
+    for (int32 Y = Window.Min.Y; Y < Window.Max.Y; ++Y)
+    {
+        for (int32 X = Window.Min.X; X < Window.Max.X; ++X)
+        {
+            const float Value = Values[(Y - Window.Min.Y) * WindowWidth + (X - Window.Min.X)];
+            if (Value < 0.0f)
+            {
+                continue;
+            }
+
+            const FVector Center = Origin + StepX * X + StepY * Y;
+            const FVector ToCell = Center - ViewLocation;
+            const double Distance = ToCell.Size();
+            if (Distance > CellSize && FVector::DotProduct(ToCell, Forward) < Distance * CosLimit)
+            {
+                continue;
+            }
+
+            // One thick line across the cell = one filled quad
+            LineScratch.Emplace(Center - StepX * 0.45, Center + StepX * 0.45, FLinearColor(ValueToColor(Value)),
+                0.0f, CellSize * 0.9f, SDPG_World);
+        }
+    }
+
+    if (LineScratch.Num() > 0)
+    {
+        LineBatcher->DrawLines(LineScratch);
+    }
+}
+
+void UMazeDebugVisualizerSubsystem::DrawOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+{
+    if (!Canvas || ActiveLayer.IsNone() || DrawMode != EMazeDebugDrawMode::Overlay || !bHasValues || !OverlayTexture)
+    {
+        return;
+    }
+
+    // The service draws every viewport; only ours
+    if (PlayerController && PlayerController->GetWorld() != GetWorld())
+    {
+        return;
+    }
+
+    const FIntPoint WindowSize = ShownWindow.Size();
+    if (WindowSize.X <= 0 || WindowSize.Y <= 0)
+    {
+        return;
+    }
+
+    // Keep the window's aspect ratio, top-right corner
+    const float Scale = OverlayScreenSize / FMath::Max(WindowSize.X, WindowSize.Y);
+    const FVector2D Size(WindowSize.X * Scale, WindowSize.Y * Scale);
+    const FVector2D Position(Canvas->ClipX - Size.X - 16.0f, 16.0f);
+
+    FCanvasTileItem Tile(Position, OverlayTexture->GetResource(), Size, FLinearColor::White);
+    Tile.BlendMode = SE_BLEND_Translucent;
+    Canvas->DrawItem(Tile);
+
+    if (ShownWindow.Contains(ViewerCell))
+    {
+        const FVector2D Marker = Position + FVector2D(ViewerCell - ShownWindow.Min) * Scale;
+        const float MarkerSize = FMath::Max(Scale, 4.0f);
+        FCanvasBoxItem Box(Marker - FVector2D(MarkerSize * 0.5f - Scale * 0.5f), FVector2D(MarkerSize));
+        Box.SetColor(FLinearColor::White);
+        Canvas->DrawItem(Box);
+    }
+
+    const FString Label = FString::Printf(TEXT("maze.debug %s  [%g .. %g]  %dx%d of %dx%d cells"),
+        *ActiveLayer.ToString(), MinValue, MaxValue, WindowSize.X, WindowSize.Y, ValuesSize.X, ValuesSize.Y);
+    Canvas->SetDrawColor(FColor::White);
+    Canvas->DrawText(GEngine->GetSmallFont(), Label, Position.X, Position.Y + Size.Y + 4.0f);
+}
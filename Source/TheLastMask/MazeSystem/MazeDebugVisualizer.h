@@ -0,0 +1,262 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/LineBatchComponent.h"
+#include "MazeDebugVisualizer.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    UTickableWorldSubsystem:
+        - A world subsystem that also gets a Tick every frame
+        - Used here to resample the shown layer and draw it
+
+    FAutoConsoleCommandWithWorldAndArgs:
+        - Registers a console command at startup ("maze.debug ...")
+        - The handler receives the world the command was typed in
+
+    UDebugDrawService:
+        - Lets code draw onto the viewport canvas every frame
+        - The overlay heatmap is ONE textured quad drawn through it
+
+    UTexture2D::UpdateTextureRegions:
+        - Streams new pixels to a texture on the render thread
+        - The source buffer must stay alive until the cleanup callback runs
+
+    ULineBatchComponent::DrawLines:
+        - Adds many lines to the world's line batcher in one call
+        - A thick line is a flat quad, so one line per cell paints a heatmap
+=============================================================================*/
+
+class AMazeManager;
+class UCanvas;
+class APlayerController;
+class UTexture2D;
+
+/**
+ * The cells a layer is asked for: a rectangle of the grid (never the whole
+ * grid unless it is shown whole), one value per cell, row by row.
+ * Values arrive filled with -1 (no data, drawn transparent).
+ */
+struct FMazeDebugSample
+{
+    /** Grid cells to fill, Max exclusive */
+    FIntRect Rect;
+
+    /** Rect.Area() values, (Y - Rect.Min.Y) * Rect.Width() + (X - Rect.Min.X) */
+    TArrayView<float> Values;
+
+    /** Value of a cell inside Rect */
+    float& At(int32 X, int32 Y) { return Values[(Y - Rect.Min.Y) * Rect.Width() + (X - Rect.Min.X)]; }
+};
+
+/**
+ * Fills the requested cells of a maze. Only touch cells inside Sample.Rect:
+ * the cost must follow the window shown, not the grid.
+ * Return false if the layer has nothing to show.
+ */
+using FMazeDebugLayerSampler = TFunction<bool(const AMazeManager& Maze, FMazeDebugSample& Sample)>;
+
+/** How the active layer is drawn */
+UENUM(BlueprintType)
+enum class EMazeDebugDrawMode : uint8
+{
+    /** Screen-space map: one texture quad in the corner */
+    Overlay,
+
+    /** Colored quads on the maze floor around the camera */
+    World
+};
+
+/**
+ * Runtime heatmap viewer for any per-cell maze data.
+ *
+ * CONSOLE:
+ *   maze.debug <layer>            show a layer (see "maze.debug list")
+ *   maze.debug off                hide
+ *   maze.debug mode overlay|world switch drawing
+ *   maze.debug window <cells>     edge of the square shown around the viewer (0 = whole grid)
+ *   maze.debug interval <sec>     how often the layer is resampled
+ *   maze.debug budget <cells>     cells sampled per frame at most
+ *
+ * COST (independent of the grid size where it matters):
+ *   - Layers are only asked for the cells in the shown window, at most
+ *     every SampleInterval seconds (or when the window moves)
+ *   - At most SampleBudgetCells are sampled per frame: a bigger window
+ *     (e.g. window 0 on a large maze) is resampled in row bands over
+ *     several frames, and the previous sample is shown until it is done
+ *   - Overlay: the window is resampled into a fixed 256x256 texture, and
+ *     uploaded only when the data or the window changed
+ *   - World: only window cells in front of the camera are drawn, all in one
+ *     DrawLines call, and the window is capped at MaxWorldWindow cells
+ *
+ * Systems add their own layers with RegisterLayer (the scare placement
+ * component registers its view set and candidates).
+ */
+UCLASS()
+class THELASTMASK_API UMazeDebugVisualizerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //=========================================================================
+    // SUBSYSTEM
+    //=========================================================================
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    //=========================================================================
+    // LAYERS
+    //=========================================================================
+
+    /** Add (or replace) a layer. Names are case-insensitive. */
+    void RegisterLayer(FName Name, FMazeDebugLayerSampler Sampler);
+
+    /** Remove a layer (hides it if it is showing) */
+    void UnregisterLayer(FName Name);
+
+    /** Names of every registered layer */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Debug")
+    TArray<FName> GetLayerNames() const;
+
+    //=========================================================================
+    // DISPLAY
+    //=========================================================================
+
+    /** Show a layer. Returns false if no layer has that name. */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Debug")
+    bool ShowLayer(FName Name);
+
+    /** Stop drawing */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Debug")
+    void HideLayer();
+
+    /** Layer being shown (None if hidden) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Debug")
+    FName GetActiveLayer() const { return ActiveLayer; }
+
+    /** Screen overlay or world-space quads */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Debug")
+    void SetDrawMode(EMazeDebugDrawMode NewMode);
+
+    /** Handle "maze.debug" arguments */
+    void ExecuteCommand(const TArray<FString>& Args);
+
+    /** Seconds between samples of the active layer */
+    float SampleInterval = 0.25f;
+
+    /** Cells sampled per frame at most (the 128-cell default window fits in one) */
+    int32 SampleBudgetCells = 64 * 1024;
+
+    /** Edge of the square of cells shown around the viewer (0 = whole grid, overlay only) */
+    int32 WindowCells = 128;
+
+    /** World mode draws at most this many cells along each axis */
+    int32 MaxWorldWindow = 96;
+
+    /** Overlay texture edge in texels (fixed cost per upload) */
+    static constexpr int32 OverlayResolution = 256;
+
+    /** Overlay edge on screen, in pixels */
+    float OverlayScreenSize = 384.0f;
+
+protected:
+    /** Game and PIE worlds only (no editor preview worlds) */
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Add walkable, distance, flow, components and path */
+    void RegisterBuiltInLayers();
+
+    /**
+     * Local player's camera, and the maze and cell of its pawn (falls back
+     * to the first maze, cell (-1,-1)). False if there is no player or maze.
+     */
+    bool ResolveViewer(FVector& OutLocation, FRotator& OutRotation, float& OutFOV,
+        const AMazeManager*& OutMaze, FIntPoint& OutCell) const;
+
+    /** Window the current draw mode shows around a cell */
+    FIntRect ComputeWantedWindow(FIntPoint Center, FIntPoint GridSize) const;
+
+    /** Start resampling the active layer over Window */
+    void BeginSamplePass(const AMazeManager& Maze, const FIntRect& Window);
+
+    /** Sample the next band of rows (SampleBudgetCells); publish when the window is done */
+    void ContinueSamplePass(const AMazeManager& Maze);
+
+    /** Square of cells to show around Center, clamped to the grid */
+    FIntRect ComputeWindow(FIntPoint Center, FIntPoint GridSize, int32 EdgeCells) const;
+
+    /** Heat color for a raw value (dim background if < 0) */
+    FColor ValueToColor(float Value) const;
+
+    /** Resample the window into the overlay texture and upload it */
+    void UploadOverlay();
+
+    /** Push the shown window's cells in view to the line batcher */
+    void DrawWorldCells(const AMazeManager& Maze, const FVector& ViewLocation, const FRotator& ViewRotation, float ViewFOV);
+
+    /** UDebugDrawService callback */
+    void DrawOverlay(UCanvas* Canvas, APlayerController* PlayerController);
+
+    /** Registered layers by name */
+    TMap<FName, FMazeDebugLayerSampler> Layers;
+
+    /** Shown layer (None = off) */
+    FName ActiveLayer;
+
+    EMazeDebugDrawMode DrawMode = EMazeDebugDrawMode::Overlay;
+
+    /** Maze the shown values were sampled from */
+    TWeakObjectPtr<const AMazeManager> SampledMaze;
+
+    /** Last complete sample of the active layer, one value per ShownWindow cell */
+    TArray<float> Values;
+    FIntRect ShownWindow;
+
+    /** Grid size of the maze ShownWindow belongs to */
+    FIntPoint ValuesSize = FIntPoint::ZeroValue;
+    bool bHasValues = false;
+
+    /** Value range of the last sample (negative values ignored) */
+    float MinValue = 0.0f;
+    float MaxValue = 1.0f;
+
+    double LastSampleTime = -1.0;
+
+    //=========================================================================
+    // SAMPLE PASS IN PROGRESS (Values stays shown until it completes)
+    //=========================================================================
+
+    bool bSampling = false;
+    TWeakObjectPtr<const AMazeManager> SamplingMaze;
+    FIntPoint SamplingGridSize = FIntPoint::ZeroValue;
+    FIntRect SamplingWindow;
+    int32 NextSampleRow = 0;
+    TArray<float> PassValues;
+    float PassMinValue = 0.0f;
+    float PassMaxValue = 0.0f;
+    bool bPassHasValues = false;
+
+    /** Viewer cell (marked on the overlay) */
+    FIntPoint ViewerCell = FIntPoint(-1, -1);
+    bool bOverlayDirty = true;
+
+    /** 256 colors from cold to hot */
+    TArray<FColor> HeatPalette;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UTexture2D> OverlayTexture;
+
+    FDelegateHandle DrawHandle;
+
+    /** Reused by DrawWorldCells */
+    TArray<FBatchedLine> LineScratch;
+};
@@ -0,0 +1,259 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeDifficultyDirector.h"
+#include "MazeManager.h"
+#include "MazeWorldSubsystem.h"
+#include "Core/MazeGridData.h"
+#include "Core/MazePathfinder.h"
+#include "Engine/World.h"
+
+UMazeDifficultyDirectorComponent::UMazeDifficultyDirectorComponent()
+{
+    // Tick only has to spot cell changes; ten checks a second is plenty
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickInterval = 0.1f;
+}
+
+void UMazeDifficultyDirectorComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    LastProgressTime = GetWorld()->GetTimeSeconds();
+}
+
+void UMazeDifficultyDirectorComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return;
+    }
+
+    const FVector OwnerLocation = Owner->GetActorLocation();
+    FIntPoint NewCell(-1, -1);
+    AMazeManager* NewMaze = nullptr;
+
+    if (Maze)
+    {
+        // Explicit override: always measure against this maze
+        if (Maze->WorldToMazeCell(OwnerLocation, NewCell))
+        {
+            NewMaze = Maze;
+        }
+    }
+    else if (CurrentMaze.IsValid() && CurrentMaze->WorldToMazeCell(OwnerLocation, NewCell))
+    {
+        // Still inside the same maze: skip the registry lookup
+        NewMaze = CurrentMaze.Get();
+    }
+    else if (const UMazeWorldSubsystem* MazeWorld = GetWorld()->GetSubsystem<UMazeWorldSubsystem>())
+    {
+        NewMaze = MazeWorld->FindMazeAtLocation(OwnerLocation, NewCell);
+    }
+
+    if (NewMaze != CurrentMaze.Get())
+    {
+        CurrentMaze = NewMaze;
+        InvalidateFields();
+    }
+
+    if (!NewMaze || NewCell == PlayerCell)
+    {
+        return;
+    }
+
+    PlayerCell = NewCell;
+    HandleCellChanged();
+}
+
+void UMazeDifficultyDirectorComponent::HandleCellChanged()
+{
+    AMazeManager* MazePtr = CurrentMaze.Get();
+    if (!MazePtr || !MazePtr->GetPathfinder())
+    {
+        return;
+    }
+
+    // Target switches (Exit <-> Key) are rare: one BFS each, then O(1) reads
+    const FIntPoint TargetCell = MazePtr->GetCurrentTargetGridPosition();
+    const int32 NumCells = MazePtr->GetMazeSize().X * MazePtr->GetMazeSize().Y;
+
+    // The solution path starts where the run (or the leg toward this target)
+    // started, and stays there across wall edits: re-anchoring it under the
+    // player would read "on the path" exactly when they have wandered off
+    const bool bNewRun = MazePtr->GetRunSerial() != FieldRunSerial || TargetDistanceField.Num() != NumCells;
+    if (bNewRun)
+    {
+        const UMazeGridData* GridData = MazePtr->MazeGridData;
+        const bool bHasSpawn = GridData && GridData->SpawnCell.X >= 0 && GridData->SpawnCell.Y >= 0;
+        SolutionAnchorCell = bHasSpawn ? GridData->SpawnCell : PlayerCell;
+    }
+    else if (TargetCell != FieldTargetCell)
+    {
+        // Exit <-> Key: the new leg starts where the player switched
+        SolutionAnchorCell = PlayerCell;
+    }
+
+    // Restart / maze swap / runtime wall edits: same target cell can mean a different maze
+    if (bNewRun || TargetCell != FieldTargetCell || MazePtr->GetGridHash() != FieldGridHash)
+    {
+        RebuildFields(TargetCell);
+    }
+
+    Metrics.DistanceToTarget = ReadField(TargetDistanceField, PlayerCell);
+    Metrics.DistanceToSolutionPath = ReadField(SolutionDistanceField, PlayerCell);
+
+    // Progress = getting closer to the target than ever before
+    if (Metrics.DistanceToTarget != INDEX_NONE &&
+        (Metrics.BestDistanceToTarget == INDEX_NONE || Metrics.DistanceToTarget < Metrics.BestDistanceToTarget))
+    {
+        Metrics.BestDistanceToTarget = Metrics.DistanceToTarget;
+        LastProgressTime = GetWorld()->GetTimeSeconds();
+    }
+
+    const FMazeLostnessMetrics CurrentMetrics = GetMetrics();
+    OnPlayerCellChangedNative.Broadcast(PlayerCell, CurrentMetrics);
+    OnPlayerCellChanged.Broadcast(PlayerCell, CurrentMetrics);
+}
+
+void UMazeDifficultyDirectorComponent::RebuildFields(FIntPoint NewTargetCell)
+{
+    FieldTargetCell = NewTargetCell;
+    FieldRunSerial = CurrentMaze.IsValid() ? CurrentMaze->GetRunSerial() : 0;
+    FieldGridHash = CurrentMaze.IsValid() ? CurrentMaze->GetGridHash() : 0;
+    Metrics = FMazeLostnessMetrics();
+    LastProgressTime = GetWorld()->GetTimeSeconds();
+
+    const UMazePathfinder* Pathfinder = CurrentMaze.IsValid() ? CurrentMaze->GetPathfinder() : nullptr;
+    if (!Pathfinder || !Pathfinder->BuildDistanceField({ NewTargetCell }, TargetDistanceField))
+    {
+        TargetDistanceField.Reset();
+        SolutionDistanceField.Reset();
+        return;
+    }
+
+    /*
+        Solution path = shortest route from the anchor (spawn, or where the
+        player switched targets) to the target, on the current layout.
+        No search needed: walk downhill on the target field.
+    */
+    const FIntPoint MazeSize = Pathfinder->GetMazeSize();
+    TArray<FIntPoint> SolutionCells;
+
+    FIntPoint Current = SolutionAnchorCell;
+    int32 CurrentDistance = ReadField(TargetDistanceField, Current);
+
+    if (CurrentDistance != INDEX_NONE)
+    {
+        const FIntPoint Offsets[] = {
+            FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)
+        };
+
+        SolutionCells.Reserve(CurrentDistance + 1);
+        SolutionCells.Add(Current);
+
+        while (CurrentDistance > 0)
+        {
+            for (const FIntPoint& Offset : Offsets)
+            {
+                const FIntPoint Next = Current + Offset;
+                if (ReadField(TargetDistanceField, Next) == CurrentDistance - 1)
+                {
+                    Current = Next;
+                    break;
+                }
+            }
+
+            --CurrentDistance;
+            SolutionCells.Add(Current);
+        }
+    }
+    else
+    {
+        // Anchor walled off by an edit: the target alone is the "path"
+        SolutionCells.Add(NewTargetCell);
+    }
+
+    Metrics.SolutionPathLength = SolutionCells.Num();
+    Pathfinder->BuildDistanceField(SolutionCells, SolutionDistanceField);
+
+    UE_LOG(LogTemp, Verbose, TEXT("MazeDirector: Rebuilt fields for target (%d,%d), solution %d cells, grid %dx%d"),
+        NewTargetCell.X, NewTargetCell.Y, SolutionCells.Num(), MazeSize.X, MazeSize.Y);
+}
+
+void UMazeDifficultyDirectorComponent::InvalidateFields()
+{
+    FieldTargetCell = FIntPoint(-1, -1);
+    SolutionAnchorCell = FIntPoint(-1, -1);
+    PlayerCell = FIntPoint(-1, -1);
+    TargetDistanceField.Reset();
+    SolutionDistanceField.Reset();
+    Metrics = FMazeLostnessMetrics();
+}
+
+FMazeLostnessMetrics UMazeDifficultyDirectorComponent::GetMetrics() const
+{
+    FMazeLostnessMetrics Result = Metrics;
+
+    if (const UWorld* World = GetWorld())
+    {
+        Result.TimeSinceProgress = static_cast<float>(World->GetTimeSeconds() - LastProgressTime);
+    }
+
+    Result.Lostness = ComputeLostness(Result);
+    return Result;
+}
+
+float UMazeDifficultyDirectorComponent::GetLostness() const
+{
+    return GetMetrics().Lostness;
+}
+
+int32 UMazeDifficultyDirectorComponent::GetDistanceToTargetFromCell(FIntPoint Cell) const
+{
+    return ReadField(TargetDistanceField, Cell);
+}
+
+float UMazeDifficultyDirectorComponent::ComputeLostness(const FMazeLostnessMetrics& InMetrics) const
+{
+    const float TotalWeight = OffPathWeight + StallWeight + RegressionWeight;
+    if (TotalWeight <= KINDA_SMALL_NUMBER || InMetrics.DistanceToTarget == INDEX_NONE)
+    {
+        return 0.0f;
+    }
+
+    const float OffPath = FMath::Clamp(
+        static_cast<float>(FMath::Max(InMetrics.DistanceToSolutionPath, 0)) / OffPathDistanceForFullLostness,
+        0.0f, 1.0f);
+
+    const float Stall = FMath::Clamp(InMetrics.TimeSinceProgress / StallSecondsForFullLostness, 0.0f, 1.0f);
+
+    // How far the player has walked back from their best, relative to that best
+    const int32 Regressed = InMetrics.DistanceToTarget - InMetrics.BestDistanceToTarget;
+    const float Regression = FMath::Clamp(
+        static_cast<float>(Regressed) / FMath::Max(InMetrics.BestDistanceToTarget, 1),
+        0.0f, 1.0f);
+
+    return (OffPath * OffPathWeight + Stall * StallWeight + Regression * RegressionWeight) / TotalWeight;
+}
+
+int32 UMazeDifficultyDirectorComponent::ReadField(const TArray<int32>& Field, FIntPoint Cell) const
+{
+    const AMazeManager* MazePtr = CurrentMaze.Get();
+    if (!MazePtr)
+    {
+        return INDEX_NONE;
+    }
+
+    const FIntPoint MazeSize = MazePtr->GetMazeSize();
+    if (Cell.X < 0 || Cell.X >= MazeSize.X || Cell.Y < 0 || Cell.Y >= MazeSize.Y)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Index = Cell.Y * MazeSize.X + Cell.X;
+    return Field.IsValidIndex(Index) ? Field[Index] : INDEX_NONE;
+}
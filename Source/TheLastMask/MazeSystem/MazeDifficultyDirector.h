@@ -0,0 +1,227 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Core/MazeTypes.h"
+#include "MazeDifficultyDirector.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    UActorComponent:
+        - Reusable behaviour that is attached to an actor
+        - Has no transform (that would be USceneComponent)
+        - Added in the Blueprint editor with "Add Component"
+
+    PrimaryComponentTick.TickInterval:
+        - How often TickComponent runs, in seconds
+        - 0 = every frame. We only need to notice cell changes, so a
+          small interval is plenty and keeps the per-frame cost at zero
+
+    BlueprintPure:
+        - Node without execution pins (green "getter" node)
+        - Should be cheap and have no side effects
+=============================================================================*/
+
+class AMazeManager;
+
+/**
+ * Snapshot of how "lost" the player currently is.
+ * Every value is a constant-time lookup into precomputed distance fields.
+ */
+USTRUCT(BlueprintType)
+struct FMazeLostnessMetrics
+{
+    GENERATED_BODY()
+
+    /** Maze distance (cells) from the player to the current target. -1 if unknown. */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Director")
+    int32 DistanceToTarget = INDEX_NONE;
+
+    /** Closest the player has been to the current target since it was set */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Director")
+    int32 BestDistanceToTarget = INDEX_NONE;
+
+    /** Maze distance (cells) from the player to the solution path. 0 = on the path. */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Director")
+    int32 DistanceToSolutionPath = INDEX_NONE;
+
+    /** Length of the solution path from the run's spawn (or the last target switch) to the target */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Director")
+    int32 SolutionPathLength = 0;
+
+    /** Seconds since the player last got closer to the target than ever before */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Director")
+    float TimeSinceProgress = 0.0f;
+
+    /** Weighted 0..1 blend of the values above (see director tuning) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Director")
+    float Lostness = 0.0f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPlayerMazeCellChanged, FIntPoint, NewCell, const FMazeLostnessMetrics&, Metrics);
+
+/**
+ * Native (C++ only) cell change event. Fires before the Blueprint event, so
+ * anything that reacts natively (scare placement) is up to date by the time
+ * Blueprints hear about the move.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPlayerMazeCellChangedNative, FIntPoint /*NewCell*/, const FMazeLostnessMetrics& /*Metrics*/);
+
+/**
+ * Dynamic difficulty director — measures how lost the player is.
+ *
+ * Add this component to the player pawn. It finds the maze the player is in
+ * through UMazeWorldSubsystem (or uses the Maze override) and tracks:
+ *   - Distance to the current target (Exit or Key)
+ *   - Distance to the solution path
+ *   - Time since the player last made progress
+ *
+ * PERFORMANCE:
+ *   - Tick only converts the pawn position to a cell and compares it
+ *   - Metrics update ONLY when the player enters a new cell
+ *   - Each update is a few array reads (no path searches)
+ *   - Distance fields are rebuilt only when the target cell changes
+ *
+ * Designers: read GetMetrics() / GetLostness(), or bind OnPlayerCellChanged,
+ * to drive scare frequency and hint availability.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazeDifficultyDirectorComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazeDifficultyDirectorComponent();
+
+    //=========================================================================
+    // SETUP
+    //=========================================================================
+
+    /**
+     * Optional: force a specific maze.
+     * Leave empty to use whichever maze the owner is standing in.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Director")
+    TObjectPtr<AMazeManager> Maze;
+
+    //=========================================================================
+    // TUNING (how the Lostness score is blended)
+    //=========================================================================
+
+    /** Cells off the solution path that count as "fully lost" */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Director|Tuning",
+        meta = (ClampMin = "1"))
+    int32 OffPathDistanceForFullLostness = 12;
+
+    /** Seconds without progress that count as "fully lost" */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Director|Tuning",
+        meta = (ClampMin = "1.0"))
+    float StallSecondsForFullLostness = 60.0f;
+
+    /** Weight of distance-to-solution-path in the Lostness score */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Director|Tuning",
+        meta = (ClampMin = "0.0"))
+    float OffPathWeight = 0.5f;
+
+    /** Weight of time-since-progress in the Lostness score */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Director|Tuning",
+        meta = (ClampMin = "0.0"))
+    float StallWeight = 0.35f;
+
+    /** Weight of "further than your best" (backtracking) in the Lostness score */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Director|Tuning",
+        meta = (ClampMin = "0.0"))
+    float RegressionWeight = 0.15f;
+
+    //=========================================================================
+    // EVENTS
+    //=========================================================================
+
+    /** Fired when the player enters a new cell (after metrics are updated) */
+    UPROPERTY(BlueprintAssignable, Category = "Maze|Director")
+    FOnPlayerMazeCellChanged OnPlayerCellChanged;
+
+    /** Same as OnPlayerCellChanged, for C++ listeners (no reflection overhead) */
+    FOnPlayerMazeCellChangedNative OnPlayerCellChangedNative;
+
+    //=========================================================================
+    // QUERIES (all O(1))
+    //=========================================================================
+
+    /** Current metrics. TimeSinceProgress and Lostness are fresh on every call. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Director")
+    FMazeLostnessMetrics GetMetrics() const;
+
+    /** 0 = on track, 1 = hopelessly lost */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Director")
+    float GetLostness() const;
+
+    /** Maze distance from any cell to the current target (-1 if unknown) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Director")
+    int32 GetDistanceToTargetFromCell(FIntPoint Cell) const;
+
+    /** The cell the player currently occupies */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Director")
+    FIntPoint GetPlayerCell() const { return PlayerCell; }
+
+    /** The maze the player is currently in */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Director")
+    AMazeManager* GetCurrentMaze() const { return CurrentMaze.Get(); }
+
+    /** Precomputed distance-to-target field (Index = Y * SizeX + X) */
+    const TArray<int32>& GetTargetDistanceField() const { return TargetDistanceField; }
+
+    /** Force the distance fields to rebuild on the next cell change */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Director")
+    void InvalidateFields();
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /** Called once per cell change: refresh fields if needed, then metrics */
+    void HandleCellChanged();
+
+    /** Rebuild target and solution-path distance fields for a new target */
+    void RebuildFields(FIntPoint NewTargetCell);
+
+    /** Blend the raw metrics into the Lostness score */
+    float ComputeLostness(const FMazeLostnessMetrics& InMetrics) const;
+
+    /** Read a field value, -1 if out of range */
+    int32 ReadField(const TArray<int32>& Field, FIntPoint Cell) const;
+
+private:
+    /** Maze the player is currently inside */
+    TWeakObjectPtr<AMazeManager> CurrentMaze;
+
+    /** Cell the player occupies */
+    FIntPoint PlayerCell = FIntPoint(-1, -1);
+
+    /** Target cell the fields were built for */
+    FIntPoint FieldTargetCell = FIntPoint(-1, -1);
+
+    /** Where the solution path starts: run spawn, or the cell of the last target switch */
+    FIntPoint SolutionAnchorCell = FIntPoint(-1, -1);
+
+    /** Maze run the fields were built for (AMazeManager::GetRunSerial) */
+    uint32 FieldRunSerial = 0;
+
+    /** Grid layout the fields were built for (AMazeManager::GetGridHash) */
+    uint64 FieldGridHash = 0;
+
+    /** Maze distance to the current target, per cell */
+    TArray<int32> TargetDistanceField;
+
+    /** Maze distance to the solution path, per cell */
+    TArray<int32> SolutionDistanceField;
+
+    /** Raw metrics as of the last cell change */
+    FMazeLostnessMetrics Metrics;
+
+    /** World time of the last new-best distance */
+    double LastProgressTime = 0.0;
+};
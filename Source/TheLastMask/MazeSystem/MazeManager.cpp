@@ -1,9 +1,13 @@
 // Copyright The Last Mask Team. All Rights Reserved.
 
 #include "MazeManager.h"
+#include "MazeWorldSubsystem.h"
+#include "MazeRuntimeGeometryComponent.h"
 #include "Core/MazeGenerator.h"
 #include "Core/MazePathfinder.h"
 #include "Core/MazeGridData.h"
+#include "Core/MazeGridHash.h"
+#include "Core/MazeGridSidecar.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
@@ -14,6 +18,7 @@
 
 #if WITH_EDITOR
 #include "UObject/SavePackage.h"
+#include "HAL/FileManager.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Misc/PackageName.h"
 #endif
@@ -45,6 +50,10 @@ AMazeManager::AMazeManager()
     PathMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     PathMeshComponent->SetVisibility(false);
 
+    // Empty until SwapMaze loads a maze that isn't baked into the level
+    RuntimeGeometry = CreateDefaultSubobject<UMazeRuntimeGeometryComponent>(TEXT("RuntimeGeometry"));
+    RuntimeGeometry->SetupAttachment(RootComponent);
+
     // Set reasonable defaults for bake config
     GenerationConfig.Seed = 12345;
     GenerationConfig.SizeX = 21;
@@ -70,6 +79,9 @@ void AMazeManager::BeginPlay()
     // Create pathfinder
     Pathfinder = NewObject<UMazePathfinder>(this, TEXT("MazePathfinder"));
 
+    // Remember which maze the level geometry belongs to
+    LevelGridData = MazeGridData;
+
     // Load maze data from Data Asset
     LoadMazeData();
 
@@ -78,6 +90,40 @@ void AMazeManager::BeginPlay()
     {
         UpdatePathfindingTarget();
     }
+
+    // Keep the batch world -> grid projection in sync if the maze is moved
+    if (RootComponent)
+    {
+        RootTransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &AMazeManager::HandleRootTransformUpdated);
+    }
+
+    // Make this maze discoverable by position
+    if (UMazeWorldSubsystem* MazeWorld = GetWorld()->GetSubsystem<UMazeWorldSubsystem>())
+    {
+        MazeWorld->RegisterMaze(this);
+    }
+}
+
+void AMazeManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (RootComponent)
+    {
+        RootComponent->TransformUpdated.Remove(RootTransformUpdatedHandle);
+    }
+    RootTransformUpdatedHandle.Reset();
+
+    // Readers still holding snapshots keep them alive
+    GridVersions.Reset();
+
+    if (UWorld* World = GetWorld())
+    {
+        if (UMazeWorldSubsystem* MazeWorld = World->GetSubsystem<UMazeWorldSubsystem>())
+        {
+            MazeWorld->UnregisterMaze(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AMazeManager::LoadMazeData()
@@ -97,15 +143,23 @@ void AMazeManager::LoadMazeData()
         return;
     }
 
-    // Load cell data
+    // Load cell data (runtime edits of the previous grid no longer apply)
+    EditJournal.Reset();
     CachedCells = MazeGridData->Cells;
     LoadedMazeSize = FIntPoint(MazeGridData->SizeX, MazeGridData->SizeY);
     LoadedCellSize = MazeGridData->CellSize;
+    RefreshGridProjection();
 
     // Initialize pathfinder with loaded data
     if (Pathfinder)
     {
-        Pathfinder->Initialize(CachedCells, LoadedMazeSize, LoadedCellSize);
+        Pathfinder->SetRoomLatticeEnabled(bRoomLatticePathfinding);
+        if (!bUseGridSidecar || !InitializePathfinderFromSidecar())
+        {
+            Pathfinder->Initialize(CachedCells, LoadedMazeSize, LoadedCellSize);
+            Pathfinder->BuildLandmarks(PathfindingLandmarks);
+        }
+        GridVersions.Initialize(Pathfinder->GetWalkableGrid(), LoadedMazeSize, Pathfinder->GetGridHash());
     }
 
     // Setup path overlay mesh
@@ -120,13 +174,54 @@ void AMazeManager::LoadMazeData()
 
     // Reset game state
     GameState = FMazeGameState();
+    ++RunSerial;
 
     // Fire ready event
     OnMazeReady.Broadcast();
 
-    UE_LOG(LogTemp, Log, TEXT("MazeManager: Loaded maze data - %dx%d, %d floors, %d walls"),
+    UE_LOG(LogTemp, Log, TEXT("MazeManager: Loaded maze data - %dx%d, %d floors, %d walls, hash %s, %s search"),
         LoadedMazeSize.X, LoadedMazeSize.Y,
-        MazeGridData->GetFloorCount(), MazeGridData->GetWallCount());
+        MazeGridData->GetFloorCount(), MazeGridData->GetWallCount(), *GetGridHashString(),
+        Pathfinder && Pathfinder->CanUseRoomLattice() ? TEXT("room lattice") : TEXT("cell"));
+}
+
+int32 AMazeManager::StreamGeometryChunks(TArrayView<const FIntPoint> WantedChunks, int32 MaxLoads)
+{
+    return RuntimeGeometry ? RuntimeGeometry->StreamChunks(CachedCells, WantedChunks, MaxLoads) : 0;
+}
+
+bool AMazeManager::InitializePathfinderFromSidecar()
+{
+    const FString Filename = FMazeGridSidecar::GetPathFor(*MazeGridData);
+    const TSharedRef<FMazeGridSidecar> Sidecar = MakeShared<FMazeGridSidecar>();
+
+    FString Error;
+    if (!Sidecar->Open(Filename, Error))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeManager: %s, building pathfinding data instead"), *Error);
+        return false;
+    }
+
+    // A sidecar written before the last bake or paint describes another maze
+    if (Sidecar->GetSize() != LoadedMazeSize || Sidecar->GetGridHash() != MazeGridData->GetGridHash())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeManager: %s is stale (hash %s), building pathfinding data instead. "
+            "Run Write Grid Sidecar."), *Filename, *FMazeGridHash::ToString(Sidecar->GetGridHash()));
+        return false;
+    }
+
+    // Small mazes can hold fewer landmarks than asked for, so only note it
+    if (Sidecar->GetNumLandmarks() != PathfindingLandmarks)
+    {
+        UE_LOG(LogTemp, Log, TEXT("MazeManager: %s has %d landmarks (PathfindingLandmarks = %d)"),
+            *Filename, Sidecar->GetNumLandmarks(), PathfindingLandmarks);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    Pathfinder->InitializeFromSidecar(Sidecar, LoadedCellSize);
+
+    UE_LOG(LogTemp, Log, TEXT("MazeManager: Mapped %s in %.2f ms"), *Filename, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return Pathfinder->IsInitialized();
 }
 
 //=============================================================================
@@ -160,25 +255,10 @@ void AMazeManager::BakeMazeToLevel()
     UMazeGenerator* TempGenerator = NewObject<UMazeGenerator>(this);
     TArray<FMazeCell> Cells = TempGenerator->GenerateMaze(GenerationConfig);
 
-    // Step 2: Calculate mesh scales (same logic as old RebuildMeshInstances)
-    const FVector FloorMeshSize = FloorMesh->GetBoundingBox().GetSize();
-    const FVector WallMeshSize = WallMesh->GetBoundingBox().GetSize();
-
+    // Step 2: Mesh scales (shared with cell painting)
     const float CellSize = GenerationConfig.CellSize;
     const float WallHeight = GenerationConfig.WallHeight;
-
-    const FVector FloorScale(
-        CellSize / FMath::Max(FloorMeshSize.X, 1.0f),
-        CellSize / FMath::Max(FloorMeshSize.Y, 1.0f),
-        1.0f
-    );
-
-    const FVector WallScale(
-        CellSize / FMath::Max(WallMeshSize.X, 1.0f),
-        CellSize / FMath::Max(WallMeshSize.Y, 1.0f),
-        WallHeight / FMath::Max(WallMeshSize.Z, 1.0f)
-    );
-
+    const FVector WallScale = GetBakedMeshScale(false, CellSize, WallHeight);
     const float WallCenterZ = WallHeight * 0.5f;
     const FVector ActorOrigin = GetActorLocation();
 
@@ -186,71 +266,13 @@ void AMazeManager::BakeMazeToLevel()
     int32 WallCount = 0;
 
     // Step 3: Spawn static mesh actors for each cell
+    BakedActorsByCell.Reset();
     for (int32 i = 0; i < Cells.Num(); ++i)
     {
         const FMazeCell& Cell = Cells[i];
-        
-        // Calculate world position (relative to MazeManager + actor origin)
-        FVector WorldPos = ActorOrigin + Cell.WorldPosition;
-
-        FActorSpawnParameters SpawnParams;
-
-        AStaticMeshActor* MeshActor = nullptr;
-
-        if (Cell.bIsFloor)
-        {
-            SpawnParams.Name = *FString::Printf(TEXT("BakedFloor_%d_%d"), 
-                Cell.GridPosition.X, Cell.GridPosition.Y);
-            
-            MeshActor = World->SpawnActor<AStaticMeshActor>(
-                AStaticMeshActor::StaticClass(),
-                FVector(WorldPos.X, WorldPos.Y, 0.0f),
-                FRotator::ZeroRotator,
-                SpawnParams
-            );
-
-            if (MeshActor)
-            {
-                UStaticMeshComponent* MeshComp = MeshActor->GetStaticMeshComponent();
-                MeshComp->SetStaticMesh(FloorMesh);
-                MeshComp->SetWorldScale3D(FloorScale);
-                if (DefaultFloorMaterial)
-                {
-                    MeshComp->SetMaterial(0, DefaultFloorMaterial);
-                }
-                FloorCount++;
-            }
-        }
-        else
-        {
-            SpawnParams.Name = *FString::Printf(TEXT("BakedWall_%d_%d"), 
-                Cell.GridPosition.X, Cell.GridPosition.Y);
-            
-            MeshActor = World->SpawnActor<AStaticMeshActor>(
-                AStaticMeshActor::StaticClass(),
-                FVector(WorldPos.X, WorldPos.Y, WallCenterZ),
-                FRotator::ZeroRotator,
-                SpawnParams
-            );
-
-            if (MeshActor)
-            {
-                UStaticMeshComponent* MeshComp = MeshActor->GetStaticMeshComponent();
-                MeshComp->SetStaticMesh(WallMesh);
-                MeshComp->SetWorldScale3D(WallScale);
-                if (DefaultWallMaterial)
-                {
-                    MeshComp->SetMaterial(0, DefaultWallMaterial);
-                }
-                WallCount++;
-            }
-        }
-
-        // Tag and organize
-        if (MeshActor)
+        if (SpawnBakedCellActor(Cell.GridPosition, Cell.bIsFloor, CellSize, WallHeight))
         {
-            MeshActor->Tags.Add(BakedMazeTag);
-            MeshActor->SetFolderPath(TEXT("BakedMaze"));
+            Cell.bIsFloor ? FloorCount++ : WallCount++;
         }
     }
 
@@ -324,6 +346,14 @@ void AMazeManager::BakeMazeToLevel()
     NewGridData->Seed = GenerationConfig.Seed;
     NewGridData->Algorithm = GenerationConfig.Algorithm;
     NewGridData->Cells = Cells;
+    NewGridData->RebuildDerivedData();
+    NewGridData->BakedGridHash = NewGridData->GetGridHash();
+
+    // Step 5: Pick spawn / exit / key cells
+    if (bOptimizePlacementOnBake)
+    {
+        ApplyOptimizedPlacement(NewGridData);
+    }
 
     // Mark dirty and save
     NewGridData->MarkPackageDirty();
@@ -392,6 +422,290 @@ void AMazeManager::ClearBakedMaze()
 #endif
 }
 
+FVector AMazeManager::GetBakedMeshScale(bool bFloor, float CellSize, float WallHeight) const
+{
+    // Stretch the mesh's bounds to exactly one cell (and wall height for walls)
+    const UStaticMesh* Mesh = bFloor ? FloorMesh.Get() : WallMesh.Get();
+    const FVector MeshSize = Mesh ? Mesh->GetBoundingBox().GetSize() : FVector::OneVector;
+
+    return FVector(
+        CellSize / FMath::Max(MeshSize.X, 1.0f),
+        CellSize / FMath::Max(MeshSize.Y, 1.0f),
+        bFloor ? 1.0f : WallHeight / FMath::Max(MeshSize.Z, 1.0f)
+    );
+}
+
+#if WITH_EDITOR
+AStaticMeshActor* AMazeManager::SpawnBakedCellActor(FIntPoint Cell, bool bFloor, float CellSize, float WallHeight)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // Calculate world position (relative to MazeManager + actor origin)
+    const FVector WorldPos = GetActorLocation() + FVector(
+        Cell.X * CellSize + CellSize * 0.5f,
+        Cell.Y * CellSize + CellSize * 0.5f,
+        0.0f);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Name = *FString::Printf(bFloor ? TEXT("BakedFloor_%d_%d") : TEXT("BakedWall_%d_%d"), Cell.X, Cell.Y);
+    // A repainted cell may still have its old (destroyed) actor holding the name
+    SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+
+    AStaticMeshActor* MeshActor = World->SpawnActor<AStaticMeshActor>(
+        AStaticMeshActor::StaticClass(),
+        FVector(WorldPos.X, WorldPos.Y, bFloor ? 0.0f : WallHeight * 0.5f),
+        FRotator::ZeroRotator,
+        SpawnParams
+    );
+
+    if (!MeshActor)
+    {
+        return nullptr;
+    }
+
+    UStaticMeshComponent* MeshComp = MeshActor->GetStaticMeshComponent();
+    MeshComp->SetStaticMesh(bFloor ? FloorMesh : WallMesh);
+    MeshComp->SetWorldScale3D(GetBakedMeshScale(bFloor, CellSize, WallHeight));
+    if (UMaterialInterface* Material = bFloor ? DefaultFloorMaterial : DefaultWallMaterial)
+    {
+        MeshComp->SetMaterial(0, Material);
+    }
+
+    // Tag and organize
+    MeshActor->Tags.Add(BakedMazeTag);
+    MeshActor->SetFolderPath(TEXT("BakedMaze"));
+
+    BakedActorsByCell.Add(Cell, MeshActor);
+    return MeshActor;
+}
+
+void AMazeManager::CacheBakedActorsByCell()
+{
+    BakedActorsByCell.Reset();
+
+    UWorld* World = GetWorld();
+    if (!World || !MazeGridData)
+    {
+        return;
+    }
+
+    // Cells come from actor positions, so renamed or re-spawned actors still map
+    const float CellSize = MazeGridData->CellSize;
+    const FVector Origin = GetActorLocation();
+
+    for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+    {
+        if (!It->ActorHasTag(BakedMazeTag))
+        {
+            continue;
+        }
+
+        const FVector Local = It->GetActorLocation() - Origin;
+        const FIntPoint Cell(FMath::FloorToInt(Local.X / CellSize), FMath::FloorToInt(Local.Y / CellSize));
+
+        // Border walls sit outside the grid and are never painted
+        if (Cell.X >= 0 && Cell.X < MazeGridData->SizeX && Cell.Y >= 0 && Cell.Y < MazeGridData->SizeY)
+        {
+            BakedActorsByCell.Add(Cell, *It);
+        }
+    }
+}
+#endif
+
+void AMazeManager::PaintCellsAtWorld(FVector WorldLocation, int32 BrushRadius, bool bFloor)
+{
+#if WITH_EDITOR
+    if (!MazeGridData || !MazeGridData->IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PaintCells: Assign a valid MazeGridData first"));
+        return;
+    }
+
+    const float CellSize = MazeGridData->CellSize;
+    const FVector Local = WorldLocation - GetActorLocation();
+    const FIntPoint Center(FMath::FloorToInt(Local.X / CellSize), FMath::FloorToInt(Local.Y / CellSize));
+
+    TArray<FIntPoint> Brush;
+    const int32 Radius = FMath::Max(BrushRadius, 0);
+    for (int32 DY = -Radius; DY <= Radius; ++DY)
+    {
+        for (int32 DX = -Radius; DX <= Radius; ++DX)
+        {
+            Brush.Add(Center + FIntPoint(DX, DY));
+        }
+    }
+
+    PaintCells(Brush, bFloor);
+#endif
+}
+
+void AMazeManager::PaintCells(const TArray<FIntPoint>& Cells, bool bFloor)
+{
+#if WITH_EDITOR
+    if (!MazeGridData || !MazeGridData->IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PaintCells: Assign a valid MazeGridData first"));
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Step 1: Asset + derived data (only the area the stroke can affect)
+    TArray<FIntPoint> Changed;
+    if (MazeGridData->PaintCells(Cells, bFloor, &Changed) == 0)
+    {
+        return;
+    }
+    MazeGridData->MarkPackageDirty();
+
+    // Step 2: Baked geometry, one actor per changed cell
+    if (BakedActorsByCell.Num() == 0)
+    {
+        CacheBakedActorsByCell();
+    }
+
+    if (FloorMesh && WallMesh)
+    {
+        for (const FIntPoint& Cell : Changed)
+        {
+            if (TWeakObjectPtr<AActor>* Existing = BakedActorsByCell.Find(Cell))
+            {
+                if (AActor* OldActor = Existing->Get())
+                {
+                    OldActor->Destroy();
+                }
+                BakedActorsByCell.Remove(Cell);
+            }
+
+            SpawnBakedCellActor(Cell, bFloor, MazeGridData->CellSize, MazeGridData->WallHeight);
+        }
+
+        // Level geometry follows the asset again
+        MazeGridData->BakedGridHash = MazeGridData->GetGridHash();
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PaintCells: FloorMesh/WallMesh not set, only the data asset was updated"));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("PaintCells: %d cells -> %s in %.2f ms (%d regions)"),
+        Changed.Num(), bFloor ? TEXT("floor") : TEXT("wall"),
+        (FPlatformTime::Seconds() - StartTime) * 1000.0, MazeGridData->GetComponentCount());
+#else
+    UE_LOG(LogTemp, Warning, TEXT("PaintCells is editor-only."));
+#endif
+}
+
+float AMazeManager::GetPaintCellSize() const
+{
+    return MazeGridData ? MazeGridData->CellSize : GenerationConfig.CellSize;
+}
+
+void AMazeManager::PaintBrushFloor()
+{
+    PaintCellsAtWorld(GetActorLocation() + FVector(
+        (PaintBrushCell.X + 0.5f) * GetPaintCellSize(), (PaintBrushCell.Y + 0.5f) * GetPaintCellSize(), 0.0f),
+        PaintBrushRadius, true);
+}
+
+void AMazeManager::PaintBrushWall()
+{
+    PaintCellsAtWorld(GetActorLocation() + FVector(
+        (PaintBrushCell.X + 0.5f) * GetPaintCellSize(), (PaintBrushCell.Y + 0.5f) * GetPaintCellSize(), 0.0f),
+        PaintBrushRadius, false);
+}
+
+void AMazeManager::OptimizeTargetPlacement()
+{
+#if WITH_EDITOR
+    if (!MazeGridData || !MazeGridData->IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("OptimizeTargetPlacement: Assign a valid MazeGridData first (bake the maze)"));
+        return;
+    }
+
+    MazeGridData->Modify();
+    ApplyOptimizedPlacement(MazeGridData);
+    MazeGridData->MarkPackageDirty();
+#else
+    UE_LOG(LogTemp, Warning, TEXT("OptimizeTargetPlacement is editor-only."));
+#endif
+}
+
+void AMazeManager::WriteGridSidecar()
+{
+#if WITH_EDITOR
+    if (!MazeGridData || !MazeGridData->IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("WriteGridSidecar: Assign a valid MazeGridData first (bake the maze)"));
+        return;
+    }
+
+    // Built from the asset, not the play session's (possibly edited) grid
+    UMazePathfinder* Builder = NewObject<UMazePathfinder>(GetTransientPackage());
+    Builder->Initialize(MazeGridData->Cells, FIntPoint(MazeGridData->SizeX, MazeGridData->SizeY), MazeGridData->CellSize);
+    Builder->BuildLandmarks(PathfindingLandmarks);
+
+    const FString Filename = FMazeGridSidecar::GetPathFor(*MazeGridData);
+    FString Error;
+    if (!Builder->WriteSidecar(Filename, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("WriteGridSidecar: %s"), *Error);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("WriteGridSidecar: Wrote %s (%dx%d, %d landmarks, %lld KB)"), *Filename,
+        MazeGridData->SizeX, MazeGridData->SizeY, Builder->GetLandmarks().Num(), IFileManager::Get().FileSize(*Filename) / 1024);
+#else
+    UE_LOG(LogTemp, Warning, TEXT("WriteGridSidecar is editor-only."));
+#endif
+}
+
+#if WITH_EDITOR
+void AMazeManager::ApplyOptimizedPlacement(UMazeGridData* GridData)
+{
+    LastPlacementResult = FMazePlacementOptimizer::Optimize(*GridData, PlacementWeights);
+    if (!LastPlacementResult.bSuccess)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePlacement: Maze too small or disconnected, markers left unchanged"));
+        return;
+    }
+
+    GridData->SpawnCell = LastPlacementResult.SpawnCell;
+    GridData->ExitCell = LastPlacementResult.ExitCell;
+    GridData->KeyCell = LastPlacementResult.KeyCell;
+
+    if (!bAutoPlaceTargetActors)
+    {
+        return;
+    }
+
+    // Same placement rule as the baked floor actors: actor origin + cell center
+    auto MoveOntoCell = [this, GridData](AActor* Target, FIntPoint Cell)
+    {
+        if (!Target)
+        {
+            return;
+        }
+
+        const FVector CellCenter = GetActorLocation() + FVector(
+            Cell.X * GridData->CellSize + GridData->CellSize * 0.5f,
+            Cell.Y * GridData->CellSize + GridData->CellSize * 0.5f,
+            0.0f);
+
+        Target->Modify();
+        Target->SetActorLocation(FVector(CellCenter.X, CellCenter.Y, Target->GetActorLocation().Z));
+    };
+
+    MoveOntoCell(ExitActor, LastPlacementResult.ExitCell);
+    MoveOntoCell(KeyActor, LastPlacementResult.KeyCell);
+}
+#endif
+
 //=============================================================================
 // PATH VISUALIZATION (Mask 1 — Path Mask)
 //=============================================================================
@@ -437,6 +751,57 @@ void AMazeManager::TogglePath(FVector PlayerWorldLocation)
     }
 }
 
+FMazePackedPath AMazeManager::GetPackedCurrentPath() const
+{
+    FMazePackedPath Packed;
+    if (CurrentPath.bSuccess)
+    {
+        Packed.Encode(CurrentPath.PathGridCoordinates);
+    }
+    return Packed;
+}
+
+void AMazeManager::ShowPackedPath(const FMazePackedPath& PackedPath)
+{
+    if (!Pathfinder)
+    {
+        return;
+    }
+
+    // A path can't be longer than the maze has cells
+    FMazePathResult SharedPath;
+    const int32 NumMazeCells = LoadedMazeSize.X * LoadedMazeSize.Y;
+    if (!PackedPath.Decode(SharedPath.PathGridCoordinates, NumMazeCells) || SharedPath.PathGridCoordinates.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeManager: Received an invalid packed path"));
+        return;
+    }
+
+    // Off-grid cells would wrap into other rows; walls mean another layout
+    for (const FIntPoint& GridPos : SharedPath.PathGridCoordinates)
+    {
+        if (!Pathfinder->IsValidCell(GridPos))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MazeManager: Received a packed path through (%d,%d), which is not floor in this maze"),
+                GridPos.X, GridPos.Y);
+            return;
+        }
+    }
+
+    SharedPath.bSuccess = true;
+    SharedPath.PathLength = SharedPath.PathGridCoordinates.Num();
+    SharedPath.PathWorldPositions.Reserve(SharedPath.PathLength);
+    for (const FIntPoint& GridPos : SharedPath.PathGridCoordinates)
+    {
+        SharedPath.PathWorldPositions.Add(Pathfinder->GridToWorld(GridPos));
+    }
+
+    SetCurrentPath(MoveTemp(SharedPath));
+
+    ApplyPathVisualization();
+    GameState.bPathVisible = true;
+}
+
 //=============================================================================
 // GAME STATE MANAGEMENT
 //=============================================================================
@@ -481,6 +846,362 @@ void AMazeManager::NotifyKeyCollected()
     UpdatePathfindingTarget();
 }
 
+void AMazeManager::RestartRun()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const EMazePathTarget OldTarget = GameState.CurrentTarget;
+
+    // Path overlay and current path (listeners get the removed cells)
+    HidePath();
+    SetCurrentPath(FMazePathResult());
+
+    // Shifted walls go back to where the run started
+    RollbackLastGridTransactions(0);
+
+    // The journal drops its oldest transactions and never records oversized
+    // ones, so a long run can still differ from the asset here
+    if (MazeGridData && GetGridHash() != MazeGridData->GetGridHash())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeManager: Rollback left the grid at %s, expected %s; restoring from %s"),
+            *GetGridHashString(), *FMazeGridHash::ToString(MazeGridData->GetGridHash()), *MazeGridData->GetName());
+
+        EditedCellScratch.Reset();
+        RestoreCellsFromGridData();
+        EditJournal.Reset();
+        RefreshAfterGridEdit(EditedCellScratch);
+    }
+
+    GameState = FMazeGameState();
+    ++RunSerial;
+
+    if (GameState.CurrentTarget != OldTarget)
+    {
+        OnTargetChanged.Broadcast(GameState.CurrentTarget);
+    }
+
+    OnRunRestarted.Broadcast();
+
+    UE_LOG(LogTemp, Log, TEXT("MazeManager: Run restarted in %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool AMazeManager::SwapMaze(UMazeGridData* NewGridData)
+{
+    UMazeGridData* Target = NewGridData ? NewGridData : MazeGridData.Get();
+    if (!Target || !Target->IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeManager: SwapMaze needs a valid MazeGridData"));
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Drop the old path before the grid it refers to goes away
+    HidePath();
+    SetCurrentPath(FMazePathResult());
+
+    // Data: reuses CachedCells and the pathfinder's buffers (same object)
+    MazeGridData = Target;
+    LoadMazeData();
+
+    // Geometry: baked actors for the level's own maze, pooled chunks otherwise
+    const bool bIsLevelMaze = (MazeGridData == LevelGridData);
+    SetBakedLevelActorsVisible(bIsLevelMaze);
+
+    if (RuntimeGeometry)
+    {
+        if (bIsLevelMaze)
+        {
+            RuntimeGeometry->ClearGeometry();
+        }
+        else
+        {
+            RuntimeGeometry->BuildFromCells(CachedCells, LoadedMazeSize, MazeGridData->WallHeight,
+                FloorMesh, WallMesh,
+                GetBakedMeshScale(true, LoadedCellSize, MazeGridData->WallHeight),
+                GetBakedMeshScale(false, LoadedCellSize, MazeGridData->WallHeight),
+                DefaultFloorMaterial, DefaultWallMaterial);
+        }
+    }
+
+    // Targets follow the new maze's markers
+    if (MazeGridData->ExitCell.X >= 0)
+    {
+        MoveActorToCell(ExitActor, MazeGridData->ExitCell);
+    }
+    if (MazeGridData->KeyCell.X >= 0)
+    {
+        MoveActorToCell(KeyActor, MazeGridData->KeyCell);
+    }
+
+    // The maze moved under the world index
+    if (UMazeWorldSubsystem* MazeWorld = GetWorld()->GetSubsystem<UMazeWorldSubsystem>())
+    {
+        MazeWorld->UnregisterMaze(this);
+        MazeWorld->RegisterMaze(this);
+    }
+
+    RestartRun();
+
+    UE_LOG(LogTemp, Log, TEXT("MazeManager: Swapped to %s (%dx%d) in %.2f ms"),
+        *MazeGridData->GetName(), LoadedMazeSize.X, LoadedMazeSize.Y,
+        (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    return true;
+}
+
+void AMazeManager::SetBakedLevelActorsVisible(bool bVisible)
+{
+    if (!bBakedLevelActorsCached)
+    {
+        for (TActorIterator<AStaticMeshActor> It(GetWorld()); It; ++It)
+        {
+            if (It->ActorHasTag(BakedMazeTag))
+            {
+                BakedLevelActors.Add(*It);
+            }
+        }
+        bBakedLevelActorsCached = true;
+    }
+
+    for (const TWeakObjectPtr<AActor>& BakedActor : BakedLevelActors)
+    {
+        if (AActor* Actor = BakedActor.Get())
+        {
+            Actor->SetActorHiddenInGame(!bVisible);
+            Actor->SetActorEnableCollision(bVisible);
+        }
+    }
+}
+
+void AMazeManager::MoveActorToCell(AActor* Target, FIntPoint Cell) const
+{
+    if (Target)
+    {
+        const FVector CellWorld = MazeCellToWorld(Cell);
+        Target->SetActorLocation(FVector(CellWorld.X, CellWorld.Y, Target->GetActorLocation().Z));
+    }
+}
+
+uint64 AMazeManager::GetGridHash() const
+{
+    return Pathfinder ? Pathfinder->GetGridHash() : 0;
+}
+
+FString AMazeManager::GetGridHashString() const
+{
+    return FMazeGridHash::ToString(GetGridHash());
+}
+
+bool AMazeManager::VerifyGridHash(uint64 ExpectedHash, const TCHAR* Context) const
+{
+    const uint64 LocalHash = GetGridHash();
+    if (LocalHash == ExpectedHash)
+    {
+        return true;
+    }
+
+    UE_LOG(LogTemp, Error, TEXT("MazeManager: Grid mismatch (%s) on %s: local %s, expected %s"),
+        Context, *GetName(), *FMazeGridHash::ToString(LocalHash), *FMazeGridHash::ToString(ExpectedHash));
+    return false;
+}
+
+//=============================================================================
+// RUNTIME EDITS
+//=============================================================================
+
+int32 AMazeManager::BeginGridTransaction(FName Label)
+{
+    return EditJournal.Begin(Label);
+}
+
+int32 AMazeManager::EndGridTransaction()
+{
+    return EditJournal.End();
+}
+
+int32 AMazeManager::SetCellsFloor(const TArray<FIntPoint>& Cells, bool bFloor)
+{
+    if (!Pathfinder || !Pathfinder->IsInitialized())
+    {
+        return 0;
+    }
+
+    // Joins the caller's transaction if one is open
+    EditJournal.Begin(NAME_None);
+
+    EditedCellScratch.Reset();
+    for (const FIntPoint& Cell : Cells)
+    {
+        if (Cell.X < 0 || Cell.X >= LoadedMazeSize.X || Cell.Y < 0 || Cell.Y >= LoadedMazeSize.Y)
+        {
+            continue;
+        }
+
+        const int32 Index = Cell.Y * LoadedMazeSize.X + Cell.X;
+        if (WriteRuntimeCell(Index, bFloor))
+        {
+            EditJournal.Record(Index, bFloor ? 0 : 1, bFloor ? 1 : 0);
+            EditedCellScratch.Add(Cell);
+        }
+    }
+
+    EditJournal.End();
+
+    RefreshAfterGridEdit(EditedCellScratch);
+    return EditedCellScratch.Num();
+}
+
+bool AMazeManager::RollbackGridTransaction(int32 TransactionId)
+{
+    EditedCellScratch.Reset();
+    if (!UndoTransaction(TransactionId))
+    {
+        return false;
+    }
+
+    RefreshAfterGridEdit(EditedCellScratch);
+    return true;
+}
+
+int32 AMazeManager::RollbackLastGridTransactions(int32 Count)
+{
+    EditedCellScratch.Reset();
+
+    int32 NumRolledBack = 0;
+    while ((Count <= 0 || NumRolledBack < Count) && UndoTransaction(EditJournal.GetLatestTransactionId()))
+    {
+        ++NumRolledBack;
+    }
+
+    // One refresh for the whole batch
+    RefreshAfterGridEdit(EditedCellScratch);
+    return NumRolledBack;
+}
+
+bool AMazeManager::WriteRuntimeCell(int32 Index, bool bFloor)
+{
+    FMazeCell& Cell = CachedCells[Index];
+    if (Cell.bIsFloor == bFloor)
+    {
+        return false;
+    }
+
+    Cell.bIsFloor = bFloor;
+    Pathfinder->SetCellWalkable(FIntPoint(Index % LoadedMazeSize.X, Index / LoadedMazeSize.X), bFloor);
+    return true;
+}
+
+bool AMazeManager::UndoTransaction(int32 TransactionId)
+{
+    if (!Pathfinder || !EditJournal.TakeTransaction(TransactionId, RollbackScratch))
+    {
+        return false;
+    }
+
+    // Newest edit first, so a cell edited twice ends at its first old value.
+    // No later transaction touched these cells (TakeTransaction checks).
+    for (const FMazeCellEdit& Edit : RollbackScratch)
+    {
+        if (!CachedCells.IsValidIndex(Edit.Index))
+        {
+            continue;
+        }
+
+        if (WriteRuntimeCell(Edit.Index, Edit.OldValue != 0))
+        {
+            EditedCellScratch.Add(FIntPoint(Edit.Index % LoadedMazeSize.X, Edit.Index / LoadedMazeSize.X));
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("MazeManager: Rolled back grid transaction %d (%d edits)"),
+        TransactionId, RollbackScratch.Num());
+    return true;
+}
+
+void AMazeManager::RestoreCellsFromGridData()
+{
+    if (!Pathfinder || !MazeGridData || MazeGridData->Cells.Num() != CachedCells.Num())
+    {
+        return;
+    }
+
+    // Only the differing cells, so geometry and versions refresh as for an edit
+    for (int32 Index = 0; Index < CachedCells.Num(); ++Index)
+    {
+        if (WriteRuntimeCell(Index, MazeGridData->Cells[Index].bIsFloor))
+        {
+            EditedCellScratch.Add(FIntPoint(Index % LoadedMazeSize.X, Index / LoadedMazeSize.X));
+        }
+    }
+}
+
+void AMazeManager::RefreshAfterGridEdit(TArrayView<const FIntPoint> ChangedCells)
+{
+    if (ChangedCells.Num() == 0 || !MazeGridData)
+    {
+        return;
+    }
+
+    // Worker-thread readers: new version, copying only the touched pages
+    GridVersions.Publish(ChangedCells,
+        [this](int32 Index) -> uint8 { return CachedCells[Index].bIsFloor ? 1 : 0; },
+        GetGridHash());
+
+    // Geometry: only the chunks that contain changed cells
+    if (RuntimeGeometry && FloorMesh && WallMesh)
+    {
+        const float WallHeight = MazeGridData->WallHeight;
+        const FVector FloorScale = GetBakedMeshScale(true, LoadedCellSize, WallHeight);
+        const FVector WallScale = GetBakedMeshScale(false, LoadedCellSize, WallHeight);
+        const bool bIsLevelMaze = (MazeGridData == LevelGridData);
+
+        if (bIsLevelMaze && GetGridHash() == MazeGridData->GetGridHash())
+        {
+            // Everything rolled back: the baked actors are right again
+            RuntimeGeometry->ClearGeometry();
+            SetBakedLevelActorsVisible(true);
+        }
+        else if (!RuntimeGeometry->RefreshCells(CachedCells, LoadedMazeSize, WallHeight, FloorScale, WallScale, ChangedCells))
+        {
+            // First edit of the baked maze: baked actors can't change, switch to chunks once
+            SetBakedLevelActorsVisible(false);
+            RuntimeGeometry->BuildFromCells(CachedCells, LoadedMazeSize, WallHeight, FloorMesh, WallMesh,
+                FloorScale, WallScale, DefaultFloorMaterial, DefaultWallMaterial);
+        }
+    }
+
+    // Path: a wall on the route, or any new floor (a possible shortcut)
+    bool bPathAffected = false;
+    for (const FIntPoint& Cell : ChangedCells)
+    {
+        if (PathCellSet.Contains(Cell) || CachedCells[Cell.Y * LoadedMazeSize.X + Cell.X].bIsFloor)
+        {
+            bPathAffected = true;
+            break;
+        }
+    }
+
+    if (bPathAffected && CurrentPath.PathGridCoordinates.Num() > 0)
+    {
+        const FIntPoint Start = CurrentPath.PathGridCoordinates[0];
+        SetCurrentPath(Pathfinder->IsValidCell(Start)
+            ? Pathfinder->FindPath(Start, GetCurrentTargetGridPosition())
+            : FMazePathResult());
+
+        if (GameState.bPathVisible)
+        {
+            if (CurrentPath.bSuccess)
+            {
+                ApplyPathVisualization();
+            }
+            else
+            {
+                ClearPathVisualization();
+            }
+        }
+    }
+}
+
 bool AMazeManager::CanExitMaze() const
 {
     return GameState.bExitDiscovered && GameState.bHasKey;
@@ -604,21 +1325,66 @@ void AMazeManager::RecalculatePath(FVector FromWorldPosition)
         return;
     }
 
-    // Find path
-    CurrentPath = Pathfinder->FindPathFromWorld(FromWorldPosition, TargetGrid);
+    // Find path (listeners are only notified if it differs from the last one)
+    SetCurrentPath(Pathfinder->FindPathFromWorld(FromWorldPosition, TargetGrid));
+}
 
-    // Update path cell set for visualization
-    PathCellSet.Empty();
-    for (const FIntPoint& GridPos : CurrentPath.PathGridCoordinates)
+bool AMazeManager::SetCurrentPath(FMazePathResult&& NewPath)
+{
+    // Same cells in the same order = nothing to tell anyone
+    if (NewPath.bSuccess == CurrentPath.bSuccess &&
+        NewPath.PathGridCoordinates == CurrentPath.PathGridCoordinates)
     {
-        PathCellSet.Add(GridPos);
+        return false;
     }
 
-    // Fire event
-    if (CurrentPath.bSuccess)
+    TSet<FIntPoint> NewCellSet;
+    NewCellSet.Reserve(NewPath.PathGridCoordinates.Num());
+    for (const FIntPoint& GridPos : NewPath.PathGridCoordinates)
+    {
+        NewCellSet.Add(GridPos);
+    }
+
+    // The delta is only worth computing if a native listener wants it
+    PathDeltaAdded.Reset();
+    PathDeltaRemoved.Reset();
+
+    if (OnPathChangedNative.IsBound())
+    {
+        for (const FIntPoint& GridPos : NewPath.PathGridCoordinates)
+        {
+            if (!PathCellSet.Contains(GridPos))
+            {
+                PathDeltaAdded.Add(GridPos);
+            }
+        }
+        for (const FIntPoint& GridPos : CurrentPath.PathGridCoordinates)
+        {
+            if (!NewCellSet.Contains(GridPos))
+            {
+                PathDeltaRemoved.Add(GridPos);
+            }
+        }
+    }
+
+    CurrentPath = MoveTemp(NewPath);
+    PathCellSet = MoveTemp(NewCellSet);
+
+    if (OnPathChangedNative.IsBound())
+    {
+        FMazePathDelta Delta;
+        Delta.Added = PathDeltaAdded;
+        Delta.Removed = PathDeltaRemoved;
+        OnPathChangedNative.Broadcast(CurrentPath.PathGridCoordinates, Delta);
+    }
+
+    // Blueprint adapter: dynamic delegates copy their params, so skip when unbound
+    if (CurrentPath.bSuccess && OnPathUpdated.IsBound())
     {
         OnPathUpdated.Broadcast(CurrentPath.PathWorldPositions);
     }
+
+    return true;
 }
 
 void AMazeManager::ApplyPathVisualization()
@@ -633,9 +1399,6 @@ void AMazeManager::ApplyPathVisualization()
         return;
     }
 
-    // Clear old path instances
-    PathMeshComponent->ClearInstances();
-
     // Ensure mesh and material are set
     PathMeshComponent->SetStaticMesh(FloorMesh);
     if (PathGlowMaterial)
@@ -644,19 +1407,12 @@ void AMazeManager::ApplyPathVisualization()
     }
 
     // Match the floor scale so the overlay aligns perfectly
-    const FVector FloorMeshSize = FloorMesh->GetBoundingBox().GetSize();
-    const float SafeFloorX = FMath::Max(FloorMeshSize.X, 1.0f);
-    const float SafeFloorY = FMath::Max(FloorMeshSize.Y, 1.0f);
-
-    const FVector PathScale(
-        LoadedCellSize / SafeFloorX,
-        LoadedCellSize / SafeFloorY,
-        1.0f
-    );
+    const FVector PathScale = GetBakedMeshScale(true, LoadedCellSize, 0.0f);
 
-    // Add instances for each path cell
+    // Build the path transforms
     const float PathZOffset = 1.0f; // Slight raise to prevent z-fighting
 
+    PathTransformScratch.Reset();
     for (const FIntPoint& GridPos : CurrentPath.PathGridCoordinates)
     {
         const int32 Index = GridPos.Y * LoadedMazeSize.X + GridPos.X;
@@ -665,11 +1421,36 @@ void AMazeManager::ApplyPathVisualization()
             FVector LocalPos = CachedCells[Index].WorldPosition;
             LocalPos.Z = PathZOffset;
 
-            const FTransform PathTransform(FRotator::ZeroRotator, LocalPos, PathScale);
-            PathMeshComponent->AddInstance(PathTransform);
+            PathTransformScratch.Emplace(FRotator::ZeroRotator, LocalPos, PathScale);
         }
     }
 
+    // Reuse the instance slots from the previous path, grow/shrink by the difference
+    const int32 Existing = PathMeshComponent->GetInstanceCount();
+    const int32 Wanted = PathTransformScratch.Num();
+    const int32 Overlap = FMath::Min(Existing, Wanted);
+
+    if (Overlap > 0)
+    {
+        PathMeshComponent->BatchUpdateInstancesTransforms(0, TArrayView<const FTransform>(PathTransformScratch.GetData(), Overlap),
+            /*bWorldSpace=*/ false, /*bMarkRenderStateDirty=*/ true);
+    }
+
+    if (Wanted > Existing)
+    {
+        PathMeshComponent->AddInstances(TArray<FTransform>(PathTransformScratch.GetData() + Existing, Wanted - Existing),
+            /*bShouldReturnIndices=*/ false);
+    }
+    else if (Existing > Wanted)
+    {
+        TArray<int32> ToRemove;
+        for (int32 Index = Existing - 1; Index >= Wanted; --Index)
+        {
+            ToRemove.Add(Index);
+        }
+        PathMeshComponent->RemoveInstances(ToRemove);
+    }
+
     // Make path visible
     PathMeshComponent->SetVisibility(true);
 }
@@ -678,8 +1459,8 @@ void AMazeManager::ClearPathVisualization()
 {
     if (PathMeshComponent)
     {
+        // Instances stay allocated; the next ApplyPathVisualization reuses them
         PathMeshComponent->SetVisibility(false);
-        PathMeshComponent->ClearInstances();
     }
 }
 
@@ -731,4 +1512,78 @@ FIntPoint AMazeManager::ActorToGridPosition(AActor* Actor) const
     }
 
     return GridPos;
-}
\ No newline at end of file
+}
+
+//=============================================================================
+// GRID SPACE
+//=============================================================================
+
+FBox AMazeManager::GetMazeWorldBounds() const
+{
+    if (LoadedMazeSize.X <= 0 || LoadedMazeSize.Y <= 0)
+    {
+        return FBox(ForceInit);
+    }
+
+    const float WallHeight = MazeGridData ? MazeGridData->WallHeight : GenerationConfig.WallHeight;
+    const FBox LocalBounds(
+        FVector::ZeroVector,
+        FVector(LoadedMazeSize.X * LoadedCellSize, LoadedMazeSize.Y * LoadedCellSize, WallHeight)
+    );
+
+    return LocalBounds.TransformBy(GetActorTransform());
+}
+
+bool AMazeManager::WorldToMazeCell(FVector WorldLocation, FIntPoint& OutCell) const
+{
+    OutCell = FIntPoint(-1, -1);
+
+    if (!Pathfinder || LoadedMazeSize.X <= 0 || LoadedMazeSize.Y <= 0)
+    {
+        return false;
+    }
+
+    const FVector LocalPos = GetActorTransform().InverseTransformPosition(WorldLocation);
+    const FIntPoint Cell = Pathfinder->WorldToGrid(LocalPos);
+
+    if (Cell.X < 0 || Cell.X >= LoadedMazeSize.X || Cell.Y < 0 || Cell.Y >= LoadedMazeSize.Y)
+    {
+        return false;
+    }
+
+    OutCell = Cell;
+    return true;
+}
+
+FVector AMazeManager::MazeCellToWorld(FIntPoint Cell) const
+{
+    const FVector LocalPos(
+        Cell.X * LoadedCellSize + LoadedCellSize * 0.5f,
+        Cell.Y * LoadedCellSize + LoadedCellSize * 0.5f,
+        0.0f
+    );
+
+    return GetActorTransform().TransformPosition(LocalPos);
+}
+
+bool AMazeManager::ConvertWorldToCellsBatch(TArrayView<const float> WorldX, TArrayView<const float> WorldY,
+    TArrayView<int32> OutCellIndices, TArrayView<uint8> OutWalkable) const
+{
+    if (!Pathfinder || !Pathfinder->IsInitialized())
+    {
+        return false;
+    }
+
+    Pathfinder->WorldToGridBatch(GridProjection, WorldX, WorldY, OutCellIndices, OutWalkable);
+    return true;
+}
+
+void AMazeManager::RefreshGridProjection()
+{
+    GridProjection = FMazeGridProjection::Make(GetActorTransform(), LoadedCellSize);
+}
+
+void AMazeManager::HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    RefreshGridProjection();
+}
@@ -6,6 +6,10 @@
 #include "Core/MazePathfinder.h"
 #include "GameFramework/Actor.h"
 #include "Core/MazeTypes.h"
+#include "Core/MazePackedPath.h"
+#include "Core/MazePlacement.h"
+#include "Core/MazeEditJournal.h"
+#include "Core/MazeGridSnapshot.h"
 #include "MazeManager.generated.h"
 
 /*=============================================================================
@@ -53,6 +57,8 @@ class UMazeGenerator;
 class UMazePathfinder;
 class UMazeGridData;
 class UHierarchicalInstancedStaticMeshComponent;
+class UMazeRuntimeGeometryComponent;
+class AStaticMeshActor;
 
 // Delegate declarations for Blueprint-bindable events
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMazeGenerated);
@@ -61,6 +67,26 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnExitDiscovered);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnKeyCollected);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTargetChanged, EMazePathTarget, NewTarget);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnHollowMaskUnlocked);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMazeRunRestarted);
+
+/**
+ * What changed between two consecutive paths.
+ * Views into manager-owned scratch arrays: valid only during the broadcast.
+ */
+struct FMazePathDelta
+{
+    /** Cells on the new path that were not on the previous one */
+    TArrayView<const FIntPoint> Added;
+
+    /** Cells on the previous path that are not on the new one */
+    TArrayView<const FIntPoint> Removed;
+};
+
+/**
+ * Native (C++ only) path change event. No copies: the path and the delta
+ * are views. Fires only when the path actually changed.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMazePathChangedNative, TArrayView<const FIntPoint> /*PathCells*/, const FMazePathDelta& /*Delta*/);
 
 /**
  * Main maze manager actor — PRODUCTION VERSION.
@@ -117,6 +143,33 @@ public:
         meta = (ToolTip = "Drag your MazeGridData asset here (created by Bake Maze button)"))
     TObjectPtr<UMazeGridData> MazeGridData;
 
+    /**
+     * Landmarks for the ALT A* heuristic, built once on load.
+     * Costs 2 bytes per cell per landmark; 0 = plain Manhattan A*.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Data",
+        meta = (ClampMin = "0", ClampMax = "16", ToolTip = "Pathfinding landmarks (speeds up A* on looped mazes)"))
+    int32 PathfindingLandmarks = 4;
+
+    /**
+     * Search rooms instead of cells when the grid has the generator's
+     * room layout (rooms on even cells, one connector between linked rooms).
+     * Falls back to the cell search while runtime edits break the layout.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Data",
+        meta = (ToolTip = "Pathfind on the room lattice when the maze layout allows it"))
+    bool bRoomLatticePathfinding = true;
+
+    /**
+     * Large-maze tier: map the walkable and landmark planes from the
+     * asset's sidecar file (see FMazeGridSidecar) instead of building them
+     * on load. Falls back to building if the sidecar is missing or stale.
+     * Write it with "Write Grid Sidecar" after every bake or paint.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Data",
+        meta = (ToolTip = "Load pathfinding planes from <Asset>.mazeplanes (memory-mapped)"))
+    bool bUseGridSidecar = false;
+
     //=========================================================================
     // BAKE CONFIGURATION (Only used during baking, not at runtime)
     //=========================================================================
@@ -146,6 +199,25 @@ public:
         meta = (ToolTip = "Material for baked wall meshes"))
     TObjectPtr<UMaterialInterface> DefaultWallMaterial;
 
+    /** Pick spawn/exit/key cells automatically when baking */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Bake Settings",
+        meta = (ToolTip = "Score layouts at bake time and write the best Spawn/Exit/Key cells into MazeGridData"))
+    bool bOptimizePlacementOnBake = true;
+
+    /** Also move ExitActor and KeyActor onto the chosen cells */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Bake Settings",
+        meta = (EditCondition = "bOptimizePlacementOnBake"))
+    bool bAutoPlaceTargetActors = false;
+
+    /** What makes a layout interesting */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Bake Settings",
+        meta = (EditCondition = "bOptimizePlacementOnBake"))
+    FMazePlacementWeights PlacementWeights;
+
+    /** Scores of the last placement run (read-only, for tuning weights) */
+    UPROPERTY(VisibleAnywhere, Category = "Maze|Bake Settings")
+    FMazePlacementResult LastPlacementResult;
+
     //=========================================================================
     // VISUALIZATION (Runtime only)
     //=========================================================================
@@ -194,10 +266,21 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Maze|Events")
     FOnMazeGenerated OnMazeReady;
 
-    /** Fired when path is recalculated (provides world positions) */
+    /**
+     * Fired when the path changes (provides world positions).
+     * Blueprint adapter over OnPathChangedNative: the array is only copied
+     * into the broadcast when something is actually bound.
+     */
     UPROPERTY(BlueprintAssignable, Category = "Maze|Events")
     FOnPathUpdated OnPathUpdated;
 
+    /**
+     * C++ listeners: fired when the path changes, with the cells added and
+     * removed relative to the previous path. Views are valid only during
+     * the call.
+     */
+    FOnMazePathChangedNative OnPathChangedNative;
+
     /** Fired when player discovers the exit */
     UPROPERTY(BlueprintAssignable, Category = "Maze|Events")
     FOnExitDiscovered OnExitDiscovered;
@@ -217,6 +300,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Maze|Events")
     FOnHollowMaskUnlocked OnHollowMaskUnlocked;
 
+    /** Fired after RestartRun / SwapMaze: game state is fresh, player should respawn */
+    UPROPERTY(BlueprintAssignable, Category = "Maze|Events")
+    FOnMazeRunRestarted OnRunRestarted;
+
     //=========================================================================
     // EDITOR TOOLS (Baking)
     //=========================================================================
@@ -251,6 +338,64 @@ public:
                 ToolTip = "Remove all baked maze actors (tagged 'BakedMaze')"))
     void ClearBakedMaze();
 
+    /**
+     * Re-run key/exit placement on the assigned MazeGridData without
+     * re-baking (e.g. after tweaking PlacementWeights).
+     */
+    UFUNCTION(CallInEditor, Category = "Maze|Bake Tools",
+        meta = (DisplayPriority = 2,
+                ToolTip = "Pick the best Spawn/Exit/Key cells for the current MazeGridData"))
+    void OptimizeTargetPlacement();
+
+    /**
+     * Write the assigned MazeGridData's walkable grid and landmark fields
+     * (PathfindingLandmarks of them) to its .mazeplanes sidecar.
+     */
+    UFUNCTION(CallInEditor, Category = "Maze|Bake Tools",
+        meta = (DisplayPriority = 3,
+                ToolTip = "Write <Asset>.mazeplanes for bUseGridSidecar"))
+    void WriteGridSidecar();
+
+    //=========================================================================
+    // EDITOR TOOLS (Cell painting)
+    //
+    // Fix single corridors after baking without re-rolling the seed.
+    // Each stroke updates the MazeGridData asset, its derived data (only the
+    // area the edit can affect) and the baked actors of the painted cells.
+    // Drive PaintCellsAtWorld from an Editor Utility Widget for mouse
+    // painting, or use the brush buttons below.
+    //=========================================================================
+
+    /** Grid cell at the centre of the brush */
+    UPROPERTY(EditAnywhere, Category = "Maze|Paint Tools")
+    FIntPoint PaintBrushCell = FIntPoint::ZeroValue;
+
+    /** Brush half-size in cells (0 = single cell, 1 = 3x3...) */
+    UPROPERTY(EditAnywhere, Category = "Maze|Paint Tools", meta = (ClampMin = "0", ClampMax = "16"))
+    int32 PaintBrushRadius = 0;
+
+    /** Paint the brush area as floor */
+    UFUNCTION(CallInEditor, Category = "Maze|Paint Tools")
+    void PaintBrushFloor();
+
+    /** Paint the brush area as wall */
+    UFUNCTION(CallInEditor, Category = "Maze|Paint Tools")
+    void PaintBrushWall();
+
+    /**
+     * Paint a square brush around a world position (editor only).
+     * 
+     * @param WorldLocation - Any point inside the centre cell
+     * @param BrushRadius - Half-size in cells
+     * @param bFloor - True = floor, false = wall
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Paint Tools")
+    void PaintCellsAtWorld(FVector WorldLocation, int32 BrushRadius, bool bFloor);
+
+    /** Paint a list of cells (editor only) */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Paint Tools")
+    void PaintCells(const TArray<FIntPoint>& Cells, bool bFloor);
+
     //=========================================================================
     // PUBLIC API (Call from Blueprints or C++)
     //=========================================================================
@@ -282,6 +427,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Maze|Visualization")
     void TogglePath(FVector PlayerWorldLocation);
 
+    /**
+     * Get the current path in packed form (a few dozen bytes).
+     * Replicate or store this instead of PathWorldPositions.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Visualization")
+    FMazePackedPath GetPackedCurrentPath() const;
+
+    /**
+     * Show a path produced elsewhere (co-op partner's Mask 1, replay, cache).
+     * 
+     * @param PackedPath - Path packed with FMazePackedPath::Encode
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Visualization")
+    void ShowPackedPath(const FMazePackedPath& PackedPath);
+
     /**
      * Notify the maze that the player has discovered the exit.
      * Call this from a trigger volume near the exit.
@@ -306,6 +466,120 @@ public:
         meta = (ToolTip = "Call when player picks up the key"))
     void NotifyKeyCollected();
 
+    /**
+     * Start the run over without reloading the map.
+     * Resets FMazeGameState, the current path and the path overlay in place;
+     * the pathfinder and all loaded grid data are kept. Runtime wall edits
+     * are rolled back; any the journal no longer holds (trimmed or too big
+     * to record) are restored from MazeGridData.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|GameState")
+    void RestartRun();
+
+    /**
+     * Switch to another maze without reloading the map, then restart the run.
+     * 
+     * The pathfinder, its search buffers and the geometry pools are reused,
+     * so a maze of similar size costs no new allocations. Mazes other than
+     * the one baked into the level are shown with runtime geometry (the
+     * baked actors are hidden); swapping back shows the baked actors again.
+     * ExitActor / KeyActor move to the new maze's Exit/Key markers if set.
+     * 
+     * @param NewGridData - Maze to switch to (null = reload the current one)
+     * @return False if NewGridData is invalid (nothing changes)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|GameState")
+    bool SwapMaze(UMazeGridData* NewGridData);
+
+    /** Bumped on every load, swap and restart (lets caches spot a new run) */
+    uint32 GetRunSerial() const { return RunSerial; }
+
+    /**
+     * Zobrist hash of the runtime grid (see FMazeGridHash).
+     * Equals MazeGridData's hash until runtime edits change the layout.
+     * Use it as a cache key, or send it to peers to check they run the same maze.
+     */
+    uint64 GetGridHash() const;
+
+    /** Runtime grid hash as 16 hex digits */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Grid")
+    FString GetGridHashString() const;
+
+    /**
+     * Consistency assertion (client vs server, save vs level).
+     * Logs both hashes on mismatch.
+     * 
+     * @param ExpectedHash - Hash reported by the other side
+     * @param Context - What is being checked, for the log
+     * @return True if the runtime grid has that hash
+     */
+    bool VerifyGridHash(uint64 ExpectedHash, const TCHAR* Context) const;
+
+    //=========================================================================
+    // RUNTIME EDITS (shifting walls, doors)
+    //=========================================================================
+
+    /**
+     * Open a grid transaction. Every SetCellsFloor until the matching
+     * EndGridTransaction is rolled back as one unit. Nested calls join the
+     * open transaction.
+     * 
+     * @param Label - What caused the edit (shown in logs)
+     * @return Transaction id (pass to RollbackGridTransaction)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Runtime Edits")
+    int32 BeginGridTransaction(FName Label);
+
+    /** Close the open transaction. Returns its id, 0 if it recorded nothing. */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Runtime Edits")
+    int32 EndGridTransaction();
+
+    /**
+     * Turn cells into floor or wall during play. Outside an open transaction
+     * the call is a transaction of its own.
+     * 
+     * Only the runtime grid changes (pathfinder, path overlay, geometry);
+     * MazeGridData is never modified. Editing the level's baked maze
+     * switches it to runtime geometry until the edits are rolled back.
+     * 
+     * @return Number of cells that flipped
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Runtime Edits")
+    int32 SetCellsFloor(const TArray<FIntPoint>& Cells, bool bFloor);
+
+    /**
+     * Undo one transaction in O(its edit count + later edits).
+     * Refused while a later transaction changed any of the same cells
+     * (roll back newest first, e.g. RollbackLastGridTransactions).
+     * 
+     * @return False if the id is unknown, was already rolled back, or a
+     *         later transaction overlaps it
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Runtime Edits")
+    bool RollbackGridTransaction(int32 TransactionId);
+
+    /**
+     * Undo the newest transactions, newest first (rewind debugging).
+     * 
+     * @param Count - How many to undo; 0 or less = all of them
+     * @return Number of transactions rolled back
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Runtime Edits")
+    int32 RollbackLastGridTransactions(int32 Count = 1);
+
+    /** Log of runtime edits since the maze was loaded */
+    const FMazeEditJournal& GetEditJournal() const { return EditJournal; }
+
+    /**
+     * Consistent, immutable view of the runtime grid for worker threads.
+     * Lock-free; edits publish new versions and never touch this one.
+     * Keep it only for the duration of a query.
+     */
+    FMazeGridSnapshot AcquireGridSnapshot() const { return GridVersions.Acquire(); }
+
+    /** Grid version number (bumped by every runtime edit and rollback) */
+    uint64 GetGridVersion() const { return GridVersions.GetVersion(); }
+
     /**
      * Check if the game should end (exit discovered AND has key).
      */
@@ -337,12 +611,82 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Targets")
     FIntPoint GetCurrentTargetGridPosition() const;
 
+    //=========================================================================
+    // GRID SPACE (used by UMazeWorldSubsystem and other systems)
+    //=========================================================================
+
+    /**
+     * World-space bounding box of the whole grid.
+     * Invalid box if no maze data is loaded.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Grid")
+    FBox GetMazeWorldBounds() const;
+
+    /**
+     * Convert a world position to a cell of this maze.
+     * 
+     * @param WorldLocation - Position in world space
+     * @param OutCell - Grid cell (may be a wall)
+     * @return True if the position lies inside this maze's grid
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Grid")
+    bool WorldToMazeCell(FVector WorldLocation, FIntPoint& OutCell) const;
+
+    /**
+     * Convert a cell of this maze to a world position (cell center, floor level).
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Grid")
+    FVector MazeCellToWorld(FIntPoint Cell) const;
+
+    /** Get the runtime pathfinder (null before BeginPlay) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Pathfinding")
+    UMazePathfinder* GetPathfinder() const { return Pathfinder; }
+
+    /** Grid dimensions of the loaded maze */
+    FIntPoint GetMazeSize() const { return LoadedMazeSize; }
+
+    /** Cells of the current path, start first (empty if none) */
+    TArrayView<const FIntPoint> GetCurrentPathCells() const { return CurrentPath.PathGridCoordinates; }
+
+    /** Pooled chunk geometry (empty while the baked level actors are shown) */
+    const UMazeRuntimeGeometryComponent* GetRuntimeGeometry() const { return RuntimeGeometry; }
+
+    /**
+     * Fill the wanted runtime geometry chunks, most wanted first
+     * (see UMazeRuntimeGeometryComponent::StreamChunks).
+     * 
+     * @return Wanted chunks still empty (0 if chunks aren't streamed)
+     */
+    int32 StreamGeometryChunks(TArrayView<const FIntPoint> WantedChunks, int32 MaxLoads);
+
+    /** Cell size of the loaded maze */
+    float GetCellSize() const { return LoadedCellSize; }
+
+    /**
+     * Cached world -> grid map (inverse actor transform / CellSize).
+     * Refreshed whenever the maze actor moves.
+     */
+    const FMazeGridProjection& GetGridProjection() const { return GridProjection; }
+
+    /**
+     * Bulk WorldToMazeCell for crowds: converts every position in one SIMD pass.
+     * 
+     * @param WorldX - World X of each position
+     * @param WorldY - World Y of each position
+     * @param OutCellIndices - Y * SizeX + X, INDEX_NONE if outside this maze
+     * @param OutWalkable - 1 if the cell is floor, else 0
+     * @return False if no maze data is loaded (outputs untouched)
+     */
+    bool ConvertWorldToCellsBatch(TArrayView<const float> WorldX, TArrayView<const float> WorldY,
+        TArrayView<int32> OutCellIndices, TArrayView<uint8> OutWalkable) const;
+
 protected:
     //=========================================================================
     // ACTOR LIFECYCLE
     //=========================================================================
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // NOTE: OnConstruction is intentionally NOT overridden.
     // The baked maze is static geometry — no editor preview needed.
@@ -358,6 +702,9 @@ protected:
      */
     void LoadMazeData();
 
+    /** Initialize the pathfinder from the grid sidecar; false if unusable */
+    bool InitializePathfinderFromSidecar();
+
     /** Update which target (Exit/Key) the pathfinder should guide toward */
     void UpdatePathfindingTarget();
 
@@ -367,15 +714,63 @@ protected:
     /** Recalculate path from given position to current target */
     void RecalculatePath(FVector FromWorldPosition);
 
+    /**
+     * Replace CurrentPath and notify listeners if it differs from the old one.
+     * 
+     * @return True if the path changed
+     */
+    bool SetCurrentPath(FMazePathResult&& NewPath);
+
     /** Apply glow material to path cells */
     void ApplyPathVisualization();
 
     /** Remove glow from all cells */
     void ClearPathVisualization();
 
+#if WITH_EDITOR
+    /** Run FMazePlacementOptimizer on a grid and store the markers (and move actors if enabled) */
+    void ApplyOptimizedPlacement(UMazeGridData* GridData);
+
+    /** Spawn the baked static mesh actor for one cell (bake and paint) */
+    AStaticMeshActor* SpawnBakedCellActor(FIntPoint Cell, bool bFloor, float CellSize, float WallHeight);
+
+    /** Find the baked actor of every cell (after a level load) */
+    void CacheBakedActorsByCell();
+#endif
+
+    /** Scale that fits FloorMesh / WallMesh to one cell (bake, paint, runtime geometry) */
+    FVector GetBakedMeshScale(bool bFloor, float CellSize, float WallHeight) const;
+
+    /** Cell size the paint brush works in */
+    float GetPaintCellSize() const;
+
+    /** Show or hide the actors baked into the level */
+    void SetBakedLevelActorsVisible(bool bVisible);
+
+    /** Flip one runtime cell (CachedCells + pathfinder). Returns true if it changed. */
+    bool WriteRuntimeCell(int32 Index, bool bFloor);
+
+    /** Write back one transaction's old values; flipped cells go to EditedCellScratch */
+    bool UndoTransaction(int32 TransactionId);
+
+    /** Write every runtime cell that differs from MazeGridData back; flipped cells go to EditedCellScratch */
+    void RestoreCellsFromGridData();
+
+    /** Bring geometry and the path overlay in line after runtime cells flipped */
+    void RefreshAfterGridEdit(TArrayView<const FIntPoint> ChangedCells);
+
+    /** Move an actor onto a grid cell (keeps its Z) */
+    void MoveActorToCell(AActor* Target, FIntPoint Cell) const;
+
     /** Helper: Convert actor's world position to grid position */
     FIntPoint ActorToGridPosition(AActor* Actor) const;
 
+    /** Rebuild GridProjection from the current actor transform */
+    void RefreshGridProjection();
+
+    /** RootComponent->TransformUpdated handler */
+    void HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
 private:
     //=========================================================================
     // INTERNAL OBJECTS
@@ -401,6 +796,18 @@ private:
     UPROPERTY(VisibleAnywhere, Category = "Maze|Components")
     TObjectPtr<UHierarchicalInstancedStaticMeshComponent> PathMeshComponent;
 
+    /** Pooled chunk geometry for mazes that aren't baked into the level */
+    UPROPERTY(VisibleAnywhere, Category = "Maze|Components")
+    TObjectPtr<UMazeRuntimeGeometryComponent> RuntimeGeometry;
+
+    /** The grid the level was baked with (its actors are the level geometry) */
+    UPROPERTY()
+    TObjectPtr<UMazeGridData> LevelGridData;
+
+    /** Baked level actors, found once for hiding/showing on swap */
+    TArray<TWeakObjectPtr<AActor>> BakedLevelActors;
+    bool bBakedLevelActorsCached = false;
+
     //=========================================================================
     // CACHED DATA (loaded from Data Asset at runtime)
     //=========================================================================
@@ -414,12 +821,43 @@ private:
     /** Cell size (from Data Asset) */
     float LoadedCellSize = 200.0f;
 
+    /** World -> grid map for batch conversion (see GetGridProjection) */
+    FMazeGridProjection GridProjection;
+
+    /** Binding on RootComponent->TransformUpdated */
+    FDelegateHandle RootTransformUpdatedHandle;
+
     /** Current computed path */
     FMazePathResult CurrentPath;
 
+    /** Scratch transforms for the path overlay (reused between updates) */
+    TArray<FTransform> PathTransformScratch;
+
+    /** See GetRunSerial */
+    uint32 RunSerial = 0;
+
+    /** Runtime edits since LoadMazeData (see SetCellsFloor) */
+    FMazeEditJournal EditJournal;
+
+    /** Copy-on-write versions of the runtime grid (see AcquireGridSnapshot) */
+    FMazeGridVersionStore GridVersions;
+
+    /** Scratch for runtime edits and rollbacks (reused) */
+    TArray<FMazeCellEdit> RollbackScratch;
+    TArray<FIntPoint> EditedCellScratch;
+
     /** Grid positions that are on the current path (for quick lookup) */
     TSet<FIntPoint> PathCellSet;
 
+#if WITH_EDITOR
+    /** Baked actor per grid cell, so painting touches only the edited cells */
+    TMap<FIntPoint, TWeakObjectPtr<AActor>> BakedActorsByCell;
+#endif
+
+    /** Scratch storage for FMazePathDelta (reused between broadcasts) */
+    TArray<FIntPoint> PathDeltaAdded;
+    TArray<FIntPoint> PathDeltaRemoved;
+
     //=========================================================================
     // BAKE TAG (for finding/deleting baked actors)
     //=========================================================================
@@ -0,0 +1,239 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazePickupRouteComponent.h"
+#include "MazeDifficultyDirector.h"
+#include "MazeManager.h"
+#include "Core/MazePathfinder.h"
+#include "GameFramework/Actor.h"
+
+UMazePickupRouteComponent::UMazePickupRouteComponent()
+{
+    // Solved on demand, invalidated by the director's cell change event
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMazePickupRouteComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    UMazeDifficultyDirectorComponent* DirectorPtr = Director.Get();
+    if (!DirectorPtr && GetOwner())
+    {
+        DirectorPtr = GetOwner()->FindComponentByClass<UMazeDifficultyDirectorComponent>();
+    }
+
+    if (!DirectorPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePickupRoute: No difficulty director on %s, no route will be planned"),
+            *GetNameSafe(GetOwner()));
+        return;
+    }
+
+    BoundDirector = DirectorPtr;
+    CellChangedHandle = DirectorPtr->OnPlayerCellChangedNative.AddUObject(this, &UMazePickupRouteComponent::HandlePlayerCellChanged);
+}
+
+void UMazePickupRouteComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get())
+    {
+        DirectorPtr->OnPlayerCellChangedNative.Remove(CellChangedHandle);
+    }
+    CellChangedHandle.Reset();
+    BoundDirector.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UMazePickupRouteComponent::HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics)
+{
+    bRouteDirty = true;
+}
+
+//=============================================================================
+// PICKUPS
+//=============================================================================
+
+void UMazePickupRouteComponent::SetPickupCells(const TArray<FIntPoint>& Cells)
+{
+    PickupCells = Cells;
+    bMatrixDirty = true;
+    bRouteDirty = true;
+}
+
+void UMazePickupRouteComponent::RemovePickupCell(FIntPoint Cell)
+{
+    if (PickupCells.Remove(Cell) > 0)
+    {
+        bMatrixDirty = true;
+        bRouteDirty = true;
+    }
+}
+
+//=============================================================================
+// ROUTE
+//=============================================================================
+
+bool UMazePickupRouteComponent::GetPickupOrder(TArray<FIntPoint>& OutCells)
+{
+    UpdateRoute();
+    OutCells = OrderedPickups;
+    return OutCells.Num() > 0;
+}
+
+FIntPoint UMazePickupRouteComponent::GetNextPickupCell()
+{
+    UpdateRoute();
+    return OrderedPickups.Num() > 0 ? OrderedPickups[0] : FIntPoint(-1, -1);
+}
+
+int32 UMazePickupRouteComponent::GetRouteLength()
+{
+    UpdateRoute();
+    return RouteLength;
+}
+
+bool UMazePickupRouteComponent::IsRouteOptimal()
+{
+    UpdateRoute();
+    return bRouteOptimal;
+}
+
+void UMazePickupRouteComponent::GetUnreachablePickups(TArray<FIntPoint>& OutCells)
+{
+    UpdateRoute();
+    OutCells = UnreachablePickups;
+}
+
+void UMazePickupRouteComponent::UpdateRoute()
+{
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    const AMazeManager* Maze = DirectorPtr ? DirectorPtr->GetCurrentMaze() : nullptr;
+    const UMazePathfinder* Pathfinder = Maze ? Maze->GetPathfinder() : nullptr;
+
+    if (!Pathfinder || !Pathfinder->IsInitialized())
+    {
+        OrderedPickups.Reset();
+        UnreachablePickups.Reset();
+        RouteLength = INDEX_NONE;
+        bRouteOptimal = false;
+        bRouteDirty = true;
+        return;
+    }
+
+    // Layout edits and maze swaps invalidate everything
+    if (MatrixMaze.Get() != Maze || MatrixGridHash != Pathfinder->GetGridHash() || bMatrixHasExit != bEndAtExit)
+    {
+        bMatrixDirty = true;
+    }
+
+    const FIntPoint PlayerCell = DirectorPtr->GetPlayerCell();
+    if (!bMatrixDirty && !bRouteDirty && PlayerCell == RouteFromCell)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    //=========================================================================
+    // PICKUP MATRIX (all pairs, one batched pass)
+    //=========================================================================
+
+    if (bMatrixDirty)
+    {
+        MatrixPoints = PickupCells;
+        if (bEndAtExit)
+        {
+            MatrixPoints.Add(Maze->GetExitGridPosition());
+        }
+
+        Pathfinder->BuildDistanceMatrix(MatrixPoints, PointMatrix);
+
+        MatrixMaze = Maze;
+        MatrixGridHash = Pathfinder->GetGridHash();
+        bMatrixHasExit = bEndAtExit;
+        bMatrixDirty = false;
+    }
+
+    //=========================================================================
+    // PLAYER ROW + NODE LIST (player first, exit last)
+    //=========================================================================
+
+    RouteFromCell = PlayerCell;
+    bRouteDirty = false;
+    OrderedPickups.Reset();
+    UnreachablePickups.Reset();
+    RouteLength = INDEX_NONE;
+    bRouteOptimal = false;
+
+    Pathfinder->BuildDistanceField({ PlayerCell }, PlayerDistances);
+
+    const int32 NumPickups = PickupCells.Num();
+    const int32 MazeWidth = Maze->GetMazeSize().X;
+    auto DistanceFromPlayer = [&](FIntPoint Cell)
+    {
+        return Pathfinder->IsValidCell(Cell) ? PlayerDistances[Cell.Y * MazeWidth + Cell.X] : INDEX_NONE;
+    };
+
+    NodePoints.Reset();
+    for (int32 i = 0; i < NumPickups; ++i)
+    {
+        if (DistanceFromPlayer(MatrixPoints[i]) != INDEX_NONE)
+        {
+            NodePoints.Add(i);
+        }
+        else
+        {
+            UnreachablePickups.Add(MatrixPoints[i]);
+        }
+    }
+
+    const bool bUseExit = bMatrixHasExit && DistanceFromPlayer(MatrixPoints.Last()) != INDEX_NONE;
+    if (bUseExit)
+    {
+        NodePoints.Add(MatrixPoints.Num() - 1);
+    }
+
+    if (NodePoints.Num() == 0)
+    {
+        LastSolveMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+        return;
+    }
+
+    // Node 0 is the player, node k is MatrixPoints[NodePoints[k - 1]]
+    const int32 Num = NodePoints.Num() + 1;
+    const int32 MatrixSize = MatrixPoints.Num();
+    NodeMatrix.SetNumUninitialized(Num * Num, EAllowShrinking::No);
+    NodeMatrix[0] = 0;
+
+    for (int32 A = 1; A < Num; ++A)
+    {
+        const int32 PointA = NodePoints[A - 1];
+        const int32 FromPlayer = DistanceFromPlayer(MatrixPoints[PointA]);
+        NodeMatrix[A] = FromPlayer;
+        NodeMatrix[A * Num] = FromPlayer;
+
+        for (int32 B = 1; B < Num; ++B)
+        {
+            NodeMatrix[A * Num + B] = PointMatrix[PointA * MatrixSize + NodePoints[B - 1]];
+        }
+    }
+
+    FMazeTour Tour;
+    if (Planner.Solve(NodeMatrix, Num, 0, bUseExit ? Num - 1 : INDEX_NONE, Tour))
+    {
+        for (int32 i = 1; i < Tour.Order.Num(); ++i)
+        {
+            const int32 Point = NodePoints[Tour.Order[i] - 1];
+            if (Point < NumPickups)
+            {
+                OrderedPickups.Add(MatrixPoints[Point]);
+            }
+        }
+
+        RouteLength = Tour.Length;
+        bRouteOptimal = Tour.bOptimal;
+    }
+
+    LastSolveMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
@@ -0,0 +1,149 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Core/MazeTourPlanner.h"
+#include "MazePickupRouteComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    Lazy caching:
+        - Moving to a new cell only marks the route as stale
+        - The route is solved again the next time something asks for it,
+          so a hint system that polls once a second pays once a second
+
+    Two cache levels:
+        - Pickup-to-pickup distances only change when the pickups or the
+          maze layout change
+        - Player-to-pickup distances change every cell: one BFS
+=============================================================================*/
+
+class AMazeManager;
+class UMazeDifficultyDirectorComponent;
+struct FMazeLostnessMetrics;
+
+/**
+ * Shortest order to collect every pickup from where the player stands.
+ *
+ * Add next to a UMazeDifficultyDirectorComponent (player pawn), tell it
+ * the pickup cells, and read GetNextPickupCell / GetPickupOrder for hints.
+ * Bots can use it the same way from their own pawn.
+ *
+ * Up to 16 pickups are ordered exactly (Held-Karp); more use 2-opt.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazePickupRouteComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazePickupRouteComponent();
+
+    /** Optional: director to follow. Empty = the one on the owning actor. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Pickups")
+    TObjectPtr<UMazeDifficultyDirectorComponent> Director;
+
+    /** Finish the route at the maze exit (it is not counted as a pickup) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Pickups")
+    bool bEndAtExit = false;
+
+    //=========================================================================
+    // PICKUPS
+    //=========================================================================
+
+    /** Replace the set of cells to collect */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    void SetPickupCells(const TArray<FIntPoint>& Cells);
+
+    /** A pickup was collected (or destroyed) */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    void RemovePickupCell(FIntPoint Cell);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Pickups")
+    TArray<FIntPoint> GetPickupCells() const { return PickupCells; }
+
+    //=========================================================================
+    // ROUTE (solved lazily, cached until the player changes cell)
+    //=========================================================================
+
+    /**
+     * Reachable pickups in the order to collect them.
+     * @return False if there is no maze or nothing reachable to collect
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    bool GetPickupOrder(TArray<FIntPoint>& OutCells);
+
+    /** First pickup on the route, (-1,-1) if none */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    FIntPoint GetNextPickupCell();
+
+    /** Cells walked along the whole route (exit leg included), -1 if none */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    int32 GetRouteLength();
+
+    /** False if there were too many pickups to order exactly */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    bool IsRouteOptimal();
+
+    /** Pickups the player cannot reach from their cell */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Pickups")
+    void GetUnreachablePickups(TArray<FIntPoint>& OutCells);
+
+    /** Cost of the last solve */
+    float GetLastSolveMs() const { return LastSolveMs; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Director callback: the route is stale */
+    void HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics);
+
+    /** Re-solve if anything changed since the last solve */
+    void UpdateRoute();
+
+private:
+    TWeakObjectPtr<UMazeDifficultyDirectorComponent> BoundDirector;
+    FDelegateHandle CellChangedHandle;
+
+    TArray<FIntPoint> PickupCells;
+
+    //=========================================================================
+    // PICKUP MATRIX CACHE (pickups + exit; until pickups or layout change)
+    //=========================================================================
+
+    TWeakObjectPtr<const AMazeManager> MatrixMaze;
+    uint64 MatrixGridHash = 0;
+    bool bMatrixDirty = true;
+
+    /** Was bEndAtExit set when the matrix was built? */
+    bool bMatrixHasExit = false;
+
+    /** Pickup cells, then the exit cell if bEndAtExit */
+    TArray<FIntPoint> MatrixPoints;
+    TArray<int32> PointMatrix;
+
+    //=========================================================================
+    // ROUTE CACHE (until the player changes cell)
+    //=========================================================================
+
+    bool bRouteDirty = true;
+    FIntPoint RouteFromCell = FIntPoint(-1, -1);
+
+    /** Pickups in visiting order */
+    TArray<FIntPoint> OrderedPickups;
+    TArray<FIntPoint> UnreachablePickups;
+    int32 RouteLength = INDEX_NONE;
+    bool bRouteOptimal = false;
+
+    /** Reused between solves */
+    FMazeTourPlanner Planner;
+    TArray<int32> PlayerDistances;
+    TArray<int32> NodeMatrix;
+    TArray<int32> NodePoints;
+
+    float LastSolveMs = 0.0f;
+};
@@ -0,0 +1,126 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazePropScatterComponent.h"
+#include "MazeManager.h"
+#include "Core/MazeGridData.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+UMazePropScatterComponent::UMazePropScatterComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMazePropScatterComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (bScatterOnBeginPlay)
+    {
+        ScatterProps();
+    }
+}
+
+UMazeGridData* UMazePropScatterComponent::ResolveGridData() const
+{
+    if (GridDataOverride)
+    {
+        return GridDataOverride;
+    }
+
+    const AMazeManager* Maze = Cast<AMazeManager>(GetOwner());
+    return Maze ? Maze->MazeGridData.Get() : nullptr;
+}
+
+UHierarchicalInstancedStaticMeshComponent* UMazePropScatterComponent::GetOrCreateRuleComponent(int32 RuleIndex)
+{
+    if (RuleComponents.IsValidIndex(RuleIndex) && RuleComponents[RuleIndex])
+    {
+        return RuleComponents[RuleIndex];
+    }
+
+    AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return nullptr;
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* NewComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(
+        Owner, NAME_None, RF_Transactional);
+    NewComponent->SetupAttachment(this);
+    NewComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    NewComponent->RegisterComponent();
+    Owner->AddInstanceComponent(NewComponent);
+
+    if (RuleComponents.Num() <= RuleIndex)
+    {
+        RuleComponents.SetNum(RuleIndex + 1);
+    }
+    RuleComponents[RuleIndex] = NewComponent;
+
+    return NewComponent;
+}
+
+void UMazePropScatterComponent::ScatterProps()
+{
+    const UMazeGridData* GridData = ResolveGridData();
+    if (!GridData || !GridData->IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazePropScatter: No valid MazeGridData to scatter on"));
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 TotalPlaced = 0;
+
+    TArray<FTransform> Transforms;
+    for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+    {
+        const FMazeScatterRule& Rule = Rules[RuleIndex];
+        UHierarchicalInstancedStaticMeshComponent* RuleComponent = GetOrCreateRuleComponent(RuleIndex);
+
+        if (!RuleComponent)
+        {
+            continue;
+        }
+
+        RuleComponent->ClearInstances();
+        if (!Rule.Mesh)
+        {
+            continue;
+        }
+
+        // Offset the seed per rule so two identical rules don't stack
+        const int32 RuleSeed = static_cast<int32>(HashCombineFast(GetTypeHash(Seed), GetTypeHash(RuleIndex)));
+        FMazePropScatterer::Scatter(*GridData, Rule, RuleSeed, Transforms);
+
+        RuleComponent->SetStaticMesh(Rule.Mesh);
+        RuleComponent->SetCollisionEnabled(Rule.bEnableCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+        RuleComponent->AddInstances(Transforms, /*bShouldReturnIndices=*/ false);
+
+        TotalPlaced += Transforms.Num();
+    }
+
+    // Rules that were removed since the last scatter keep an empty component
+    for (int32 RuleIndex = Rules.Num(); RuleIndex < RuleComponents.Num(); ++RuleIndex)
+    {
+        if (RuleComponents[RuleIndex])
+        {
+            RuleComponents[RuleIndex]->ClearInstances();
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MazePropScatter: Placed %d props from %d rules in %.2f ms"),
+        TotalPlaced, Rules.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UMazePropScatterComponent::ClearProps()
+{
+    for (UHierarchicalInstancedStaticMeshComponent* RuleComponent : RuleComponents)
+    {
+        if (RuleComponent)
+        {
+            RuleComponent->ClearInstances();
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Core/MazePropScatter.h"
+#include "MazePropScatterComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    USceneComponent:
+        - A component with a transform that can have child components
+        - Here it is the parent of one HISM per scatter rule, so moving
+          the component moves every scattered prop with it
+
+    NewObject + RegisterComponent:
+        - Components created outside the constructor must be registered
+          before they render or collide
+        - Instance components are listed in AddInstanceComponent so the
+          editor shows and serializes them with the actor
+=============================================================================*/
+
+class UMazeGridData;
+class UHierarchicalInstancedStaticMeshComponent;
+
+/**
+ * Scatters props (debris, bodies, candles...) across the floor of a maze.
+ *
+ * Add to BP_MazeManager (it picks up the manager's MazeGridData) or to any
+ * actor placed at the maze origin with GridDataOverride set.
+ *
+ * Every rule outputs straight into its own HISM component, so thousands of
+ * props cost one draw call per mesh. Components are reused between
+ * re-scatters instead of being destroyed and recreated.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazePropScatterComponent : public USceneComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazePropScatterComponent();
+
+    /** What to scatter and where */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    TArray<FMazeScatterRule> Rules;
+
+    /** Same seed = same placements */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    int32 Seed = 1337;
+
+    /**
+     * Optional: scatter on this grid instead of the owning MazeManager's.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    TObjectPtr<UMazeGridData> GridDataOverride;
+
+    /** Scatter automatically when play begins (otherwise keep the editor result) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scatter")
+    bool bScatterOnBeginPlay = false;
+
+    /** Run every rule and fill the HISM components */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Maze|Scatter")
+    void ScatterProps();
+
+    /** Remove every scattered instance (components are kept for reuse) */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Maze|Scatter")
+    void ClearProps();
+
+protected:
+    virtual void BeginPlay() override;
+
+    /** Grid to scatter on: override, else the owning maze's data */
+    UMazeGridData* ResolveGridData() const;
+
+    /** Get (or create) the HISM for a rule index */
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateRuleComponent(int32 RuleIndex);
+
+private:
+    /** One HISM per rule, reused across scatters */
+    UPROPERTY(VisibleAnywhere, Category = "Maze|Scatter")
+    TArray<TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> RuleComponents;
+};
@@ -0,0 +1,365 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeRuntimeGeometryComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+
+UMazeRuntimeGeometryComponent::UMazeRuntimeGeometryComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMazeRuntimeGeometryComponent::BuildFromCells(const TArray<FMazeCell>& Cells, FIntPoint GridSize, float WallHeight,
+    UStaticMesh* FloorMesh, UStaticMesh* WallMesh, const FVector& FloorScale, const FVector& WallScale,
+    UMaterialInterface* FloorMaterial, UMaterialInterface* WallMaterial)
+{
+    if (Cells.Num() != GridSize.X * GridSize.Y || !FloorMesh || !WallMesh)
+    {
+        ClearGeometry();
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 Size = FMath::Max(ChunkSize, 1);
+    const FIntPoint NewChunkCount((GridSize.X + Size - 1) / Size, (GridSize.Y + Size - 1) / Size);
+    const int32 NumActive = NewChunkCount.X * NewChunkCount.Y;
+
+    const int32 Reused = FMath::Min(NumActive, Chunks.Num());
+
+    ++BuildSerial;
+    ActiveChunkCount = NewChunkCount;
+    BuiltGridSize = GridSize;
+    BuiltWallHeight = WallHeight;
+    BuiltFloorScale = FloorScale;
+    BuiltWallScale = WallScale;
+    ResidentChunks.Init(false, NumActive);
+    ResidentCount = 0;
+    ChunkWantedSerial.Init(0, NumActive);
+
+    for (int32 ChunkY = 0; ChunkY < NewChunkCount.Y; ++ChunkY)
+    {
+        for (int32 ChunkX = 0; ChunkX < NewChunkCount.X; ++ChunkX)
+        {
+            FMazeGeometryChunk& Chunk = GetOrCreateChunk(ChunkY * NewChunkCount.X + ChunkX);
+
+            // SetStaticMesh / SetMaterial are no-ops when nothing changed
+            Chunk.Floors->SetStaticMesh(FloorMesh);
+            Chunk.Walls->SetStaticMesh(WallMesh);
+            if (FloorMaterial)
+            {
+                Chunk.Floors->SetMaterial(0, FloorMaterial);
+            }
+            if (WallMaterial)
+            {
+                Chunk.Walls->SetMaterial(0, WallMaterial);
+            }
+
+            // Streamed chunks stay empty until a streaming source wants them
+            if (bStreamChunks)
+            {
+                UnloadChunk(ChunkY * NewChunkCount.X + ChunkX);
+            }
+            else
+            {
+                LoadChunk(ChunkY * NewChunkCount.X + ChunkX, Cells);
+            }
+        }
+    }
+
+    // Leftover chunks from a bigger maze: empty but keep for later
+    for (int32 ChunkIndex = NumActive; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        for (UHierarchicalInstancedStaticMeshComponent* Component : { Chunks[ChunkIndex].Floors.Get(), Chunks[ChunkIndex].Walls.Get() })
+        {
+            if (Component)
+            {
+                Component->ClearInstances();
+                Component->SetVisibility(false);
+                Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            }
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("MazeRuntimeGeometry: %dx%d grid in %d chunks (%d reused, %d filled) in %.2f ms"),
+        GridSize.X, GridSize.Y, NumActive, Reused, ResidentCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool UMazeRuntimeGeometryComponent::RefreshCells(const TArray<FMazeCell>& Cells, FIntPoint GridSize, float WallHeight,
+    const FVector& FloorScale, const FVector& WallScale, TArrayView<const FIntPoint> ChangedCells)
+{
+    const int32 Size = FMath::Max(ChunkSize, 1);
+    const FIntPoint ExpectedChunkCount((GridSize.X + Size - 1) / Size, (GridSize.Y + Size - 1) / Size);
+
+    if (!HasGeometry() || ExpectedChunkCount != ActiveChunkCount || Cells.Num() != GridSize.X * GridSize.Y)
+    {
+        return false;
+    }
+
+    // Each touched chunk is rebuilt once, however many of its cells changed
+    DirtyChunkScratch.Reset();
+    for (const FIntPoint& Cell : ChangedCells)
+    {
+        if (Cell.X >= 0 && Cell.X < GridSize.X && Cell.Y >= 0 && Cell.Y < GridSize.Y)
+        {
+            DirtyChunkScratch.AddUnique(FIntPoint(Cell.X / Size, Cell.Y / Size));
+        }
+    }
+
+    // Empty streamed chunks read the edited grid when they are filled
+    for (const FIntPoint& ChunkCoord : DirtyChunkScratch)
+    {
+        const int32 ChunkIndex = ChunkCoord.Y * ActiveChunkCount.X + ChunkCoord.X;
+        if (ResidentChunks[ChunkIndex])
+        {
+            FillChunk(Chunks[ChunkIndex], ChunkCoord, Size, Cells, GridSize, WallHeight, FloorScale, WallScale);
+        }
+    }
+
+    return true;
+}
+
+void UMazeRuntimeGeometryComponent::ClearGeometry()
+{
+    for (FMazeGeometryChunk& Chunk : Chunks)
+    {
+        for (UHierarchicalInstancedStaticMeshComponent* Component : { Chunk.Floors.Get(), Chunk.Walls.Get() })
+        {
+            if (Component)
+            {
+                Component->ClearInstances();
+                Component->SetVisibility(false);
+                Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            }
+        }
+    }
+
+    ++BuildSerial;
+    ActiveChunkCount = FIntPoint::ZeroValue;
+    ResidentChunks.Empty();
+    ResidentCount = 0;
+    ChunkWantedSerial.Reset();
+}
+
+//=============================================================================
+// STREAMING
+//=============================================================================
+
+int32 UMazeRuntimeGeometryComponent::StreamChunks(const TArray<FMazeCell>& Cells, TArrayView<const FIntPoint> WantedChunks, int32 MaxLoads)
+{
+    if (!bStreamChunks || !HasGeometry() || Cells.Num() != BuiltGridSize.X * BuiltGridSize.Y)
+    {
+        return 0;
+    }
+
+    ++StreamSerial;
+    int32 NumWanted = 0;
+    int32 NumLoaded = 0;
+    int32 NumPending = 0;
+
+    // Only the top MaxResidentChunks can be resident at once; the rest would
+    // just evict chunks wanted more
+    for (const FIntPoint& Chunk : WantedChunks)
+    {
+        if (NumWanted >= MaxResidentChunks)
+        {
+            break;
+        }
+
+        if (Chunk.X < 0 || Chunk.X >= ActiveChunkCount.X || Chunk.Y < 0 || Chunk.Y >= ActiveChunkCount.Y)
+        {
+            continue;
+        }
+
+        const int32 ChunkIndex = Chunk.Y * ActiveChunkCount.X + Chunk.X;
+        if (ChunkWantedSerial[ChunkIndex] == StreamSerial)
+        {
+            continue;
+        }
+
+        ChunkWantedSerial[ChunkIndex] = StreamSerial;
+        ++NumWanted;
+
+        if (!ResidentChunks[ChunkIndex])
+        {
+            if (NumLoaded < MaxLoads)
+            {
+                LoadChunk(ChunkIndex, Cells);
+                ++NumLoaded;
+            }
+            else
+            {
+                ++NumPending;
+            }
+        }
+    }
+
+    // Over the limit: empty chunks not wanted now, longest-unwanted first
+    if (ResidentCount > MaxResidentChunks)
+    {
+        EvictScratch.Reset();
+        for (TConstSetBitIterator<> It(ResidentChunks); It; ++It)
+        {
+            if (ChunkWantedSerial[It.GetIndex()] != StreamSerial)
+            {
+                EvictScratch.Add(It.GetIndex());
+            }
+        }
+
+        EvictScratch.Sort([this](int32 A, int32 B) { return ChunkWantedSerial[A] < ChunkWantedSerial[B]; });
+        for (int32 i = 0; i < EvictScratch.Num() && ResidentCount > MaxResidentChunks; ++i)
+        {
+            UnloadChunk(EvictScratch[i]);
+        }
+    }
+
+    return NumPending;
+}
+
+bool UMazeRuntimeGeometryComponent::IsChunkResident(FIntPoint Chunk) const
+{
+    if (Chunk.X < 0 || Chunk.X >= ActiveChunkCount.X || Chunk.Y < 0 || Chunk.Y >= ActiveChunkCount.Y)
+    {
+        return false;
+    }
+
+    return ResidentChunks[Chunk.Y * ActiveChunkCount.X + Chunk.X];
+}
+
+void UMazeRuntimeGeometryComponent::LoadChunk(int32 ChunkIndex, const TArray<FMazeCell>& Cells)
+{
+    FMazeGeometryChunk& Chunk = Chunks[ChunkIndex];
+    const FIntPoint ChunkCoord(ChunkIndex % ActiveChunkCount.X, ChunkIndex / ActiveChunkCount.X);
+
+    FillChunk(Chunk, ChunkCoord, FMath::Max(ChunkSize, 1), Cells, BuiltGridSize, BuiltWallHeight, BuiltFloorScale, BuiltWallScale);
+
+    Chunk.Floors->SetVisibility(true);
+    Chunk.Walls->SetVisibility(true);
+    Chunk.Floors->SetCollisionEnabled(bEnableCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+    Chunk.Walls->SetCollisionEnabled(bEnableCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+
+    if (!ResidentChunks[ChunkIndex])
+    {
+        ResidentChunks[ChunkIndex] = true;
+        ++ResidentCount;
+    }
+}
+
+void UMazeRuntimeGeometryComponent::UnloadChunk(int32 ChunkIndex)
+{
+    FMazeGeometryChunk& Chunk = Chunks[ChunkIndex];
+    for (UHierarchicalInstancedStaticMeshComponent* Component : { Chunk.Floors.Get(), Chunk.Walls.Get() })
+    {
+        Component->ClearInstances();
+        Component->SetVisibility(false);
+        Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+
+    if (ResidentChunks[ChunkIndex])
+    {
+        ResidentChunks[ChunkIndex] = false;
+        --ResidentCount;
+    }
+}
+
+const FMazeGeometryChunk* UMazeRuntimeGeometryComponent::GetChunk(FIntPoint Chunk) const
+{
+    if (Chunk.X < 0 || Chunk.X >= ActiveChunkCount.X || Chunk.Y < 0 || Chunk.Y >= ActiveChunkCount.Y)
+    {
+        return nullptr;
+    }
+
+    return &Chunks[Chunk.Y * ActiveChunkCount.X + Chunk.X];
+}
+
+FMazeGeometryChunk& UMazeRuntimeGeometryComponent::GetOrCreateChunk(int32 ChunkIndex)
+{
+    if (Chunks.Num() <= ChunkIndex)
+    {
+        Chunks.SetNum(ChunkIndex + 1);
+    }
+
+    FMazeGeometryChunk& Chunk = Chunks[ChunkIndex];
+    if (!Chunk.Floors)
+    {
+        Chunk.Floors = CreatePooledComponent(TEXT("Floors"));
+    }
+    if (!Chunk.Walls)
+    {
+        Chunk.Walls = CreatePooledComponent(TEXT("Walls"));
+    }
+
+    return Chunk;
+}
+
+UHierarchicalInstancedStaticMeshComponent* UMazeRuntimeGeometryComponent::CreatePooledComponent(const TCHAR* Kind)
+{
+    // Runtime-only pool: transient, never saved with the level
+    UHierarchicalInstancedStaticMeshComponent* NewComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(
+        GetOwner(), MakeUniqueObjectName(GetOwner(), UHierarchicalInstancedStaticMeshComponent::StaticClass(),
+            *FString::Printf(TEXT("RuntimeMaze%s"), Kind)), RF_Transient);
+
+    NewComponent->SetupAttachment(this);
+    NewComponent->RegisterComponent();
+    return NewComponent;
+}
+
+void UMazeRuntimeGeometryComponent::FillChunk(FMazeGeometryChunk& Chunk, FIntPoint ChunkCoord, int32 Size,
+    const TArray<FMazeCell>& Cells, FIntPoint GridSize, float WallHeight, const FVector& FloorScale, const FVector& WallScale)
+{
+    FloorScratch.Reset();
+    WallScratch.Reset();
+
+    const int32 EndX = FMath::Min((ChunkCoord.X + 1) * Size, GridSize.X);
+    const int32 EndY = FMath::Min((ChunkCoord.Y + 1) * Size, GridSize.Y);
+
+    for (int32 Y = ChunkCoord.Y * Size; Y < EndY; ++Y)
+    {
+        for (int32 X = ChunkCoord.X * Size; X < EndX; ++X)
+        {
+            const FMazeCell& Cell = Cells[Y * GridSize.X + X];
+            if (Cell.bIsFloor)
+            {
+                FloorScratch.Emplace(FQuat::Identity, FVector(Cell.WorldPosition.X, Cell.WorldPosition.Y, 0.0f), FloorScale);
+            }
+            else
+            {
+                WallScratch.Emplace(FQuat::Identity, FVector(Cell.WorldPosition.X, Cell.WorldPosition.Y, WallHeight * 0.5f), WallScale);
+            }
+        }
+    }
+
+    ApplyInstances(Chunk.Floors, FloorScratch);
+    ApplyInstances(Chunk.Walls, WallScratch);
+}
+
+void UMazeRuntimeGeometryComponent::ApplyInstances(UHierarchicalInstancedStaticMeshComponent* Component, const TArray<FTransform>& Transforms)
+{
+    const int32 Existing = Component->GetInstanceCount();
+    const int32 Wanted = Transforms.Num();
+    const int32 Overlap = FMath::Min(Existing, Wanted);
+
+    // Reuse the slots we have
+    if (Overlap > 0)
+    {
+        Component->BatchUpdateInstancesTransforms(0, TArrayView<const FTransform>(Transforms.GetData(), Overlap),
+            /*bWorldSpace=*/ false, /*bMarkRenderStateDirty=*/ true, /*bTeleport=*/ true);
+    }
+
+    // Grow or shrink only by the difference
+    if (Wanted > Existing)
+    {
+        Component->AddInstances(TArray<FTransform>(Transforms.GetData() + Existing, Wanted - Existing),
+            /*bShouldReturnIndices=*/ false);
+    }
+    else if (Existing > Wanted)
+    {
+        TArray<int32> ToRemove;
+        ToRemove.Reserve(Existing - Wanted);
+        for (int32 Index = Existing - 1; Index >= Wanted; --Index)
+        {
+            ToRemove.Add(Index);
+        }
+        Component->RemoveInstances(ToRemove);
+    }
+}
@@ -0,0 +1,200 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Core/MazeTypes.h"
+#include "MazeRuntimeGeometryComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    BatchUpdateInstancesTransforms:
+        - Overwrites the transforms of existing instances in one call
+        - Much cheaper than ClearInstances + AddInstances: no render
+          buffers are freed and reallocated, the slots are simply reused
+
+    Chunking:
+        - The grid is split into ChunkSize x ChunkSize blocks, each with its
+          own floor and wall HISM
+        - Per-chunk bounds let the renderer cull whole blocks, and a chunk
+          can be shown, hidden or rebuilt without touching the others
+
+    Streaming (bStreamChunks):
+        - Chunks start empty; a streaming source (UMazeChunkPrefetchComponent)
+          hands over the chunks it wants, most wanted first
+        - Each call fills at most a few of them (the load budget) and
+          empties the longest-unwanted ones once MaxResidentChunks is hit
+=============================================================================*/
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+/**
+ * Floor and wall HISMs for one block of the grid.
+ */
+USTRUCT()
+struct FMazeGeometryChunk
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Floors;
+
+    UPROPERTY()
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Walls;
+};
+
+/**
+ * Maze geometry built at runtime (used when swapping to a maze that was not
+ * baked into the level).
+ *
+ * POOLING:
+ *   Chunk components are never destroyed. Building a new maze reuses the
+ *   existing chunks and their instance slots; only the difference in
+ *   instance count is added or removed. Chunks the new maze doesn't need
+ *   are emptied and hidden, and come back on the next larger maze.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazeRuntimeGeometryComponent : public USceneComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazeRuntimeGeometryComponent();
+
+    /** Cells per chunk side */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Maze|Runtime Geometry", meta = (ClampMin = "4", ClampMax = "64"))
+    int32 ChunkSize = 16;
+
+    /** Give runtime floors and walls collision */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Maze|Runtime Geometry")
+    bool bEnableCollision = true;
+
+    /** Only fill the chunks a streaming source asks for (see StreamChunks) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Maze|Runtime Geometry|Streaming")
+    bool bStreamChunks = false;
+
+    /** Filled chunks kept before the longest-unwanted ones are emptied */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Maze|Runtime Geometry|Streaming", meta = (ClampMin = "1"))
+    int32 MaxResidentChunks = 64;
+
+    /**
+     * Fill the chunks with a grid, reusing every existing component and slot.
+     *
+     * @param Cells - Grid cells (row-major, WorldPosition = cell centre in maze space)
+     * @param GridSize - Grid dimensions
+     * @param WallHeight - Wall height (walls are centred at half of it)
+     * @param FloorScale / WallScale - Scale that fits each mesh to a cell
+     */
+    void BuildFromCells(const TArray<FMazeCell>& Cells, FIntPoint GridSize, float WallHeight,
+        UStaticMesh* FloorMesh, UStaticMesh* WallMesh, const FVector& FloorScale, const FVector& WallScale,
+        UMaterialInterface* FloorMaterial, UMaterialInterface* WallMaterial);
+
+    /**
+     * Rebuild only the chunks that contain changed cells (runtime edits).
+     * Meshes, materials and chunk layout stay as BuildFromCells set them.
+     * 
+     * @param Cells - Full grid after the edit
+     * @param ChangedCells - Cells whose floor/wall state flipped
+     * @return False if there is no geometry or the grid size differs (call BuildFromCells)
+     */
+    bool RefreshCells(const TArray<FMazeCell>& Cells, FIntPoint GridSize, float WallHeight,
+        const FVector& FloorScale, const FVector& WallScale, TArrayView<const FIntPoint> ChangedCells);
+
+    /**
+     * Fill wanted chunks and empty unwanted ones (bStreamChunks only).
+     * 
+     * @param Cells - Full grid (the one BuildFromCells / RefreshCells got)
+     * @param WantedChunks - Chunks to have filled, most wanted first
+     * @param MaxLoads - Most chunks filled by this call
+     * @return Wanted chunks still empty after this call
+     */
+    int32 StreamChunks(const TArray<FMazeCell>& Cells, TArrayView<const FIntPoint> WantedChunks, int32 MaxLoads);
+
+    /** Is a chunk filled? (always true for built chunks when not streaming) */
+    bool IsChunkResident(FIntPoint Chunk) const;
+
+    /** Filled chunks */
+    int32 GetResidentChunkCount() const { return ResidentCount; }
+
+    /** Bumped by every BuildFromCells / ClearGeometry (all chunks emptied or rebuilt) */
+    uint32 GetBuildSerial() const { return BuildSerial; }
+
+    /** Empty and hide every chunk (components stay pooled) */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Runtime Geometry")
+    void ClearGeometry();
+
+    /** Is any geometry currently built? */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Runtime Geometry")
+    bool HasGeometry() const { return ActiveChunkCount.X * ActiveChunkCount.Y > 0; }
+
+    /** Chunks in use along X and Y */
+    FIntPoint GetChunkCount() const { return ActiveChunkCount; }
+
+    /** Chunk containing a cell */
+    FIntPoint GetChunkOfCell(FIntPoint Cell) const { return FIntPoint(Cell.X / ChunkSize, Cell.Y / ChunkSize); }
+
+    /** Components of an active chunk (null if out of range) */
+    const FMazeGeometryChunk* GetChunk(FIntPoint Chunk) const;
+
+private:
+    /** Get (or create) the pooled chunk at a linear index */
+    FMazeGeometryChunk& GetOrCreateChunk(int32 ChunkIndex);
+
+    /** Create one pooled HISM */
+    UHierarchicalInstancedStaticMeshComponent* CreatePooledComponent(const TCHAR* Kind);
+
+    /** Fill one chunk's floor and wall HISMs from the grid */
+    void FillChunk(FMazeGeometryChunk& Chunk, FIntPoint ChunkCoord, int32 Size,
+        const TArray<FMazeCell>& Cells, FIntPoint GridSize, float WallHeight, const FVector& FloorScale, const FVector& WallScale);
+
+    /** Fill a chunk and make it visible and collidable */
+    void LoadChunk(int32 ChunkIndex, const TArray<FMazeCell>& Cells);
+
+    /** Empty and hide a chunk */
+    void UnloadChunk(int32 ChunkIndex);
+
+    /** Make a HISM hold exactly these transforms, reusing its existing slots */
+    static void ApplyInstances(UHierarchicalInstancedStaticMeshComponent* Component, const TArray<FTransform>& Transforms);
+
+    /** Pooled chunks (linear, more than the active count after a smaller maze) */
+    UPROPERTY(VisibleAnywhere, Category = "Maze|Runtime Geometry")
+    TArray<FMazeGeometryChunk> Chunks;
+
+    /** Chunks used by the current maze */
+    FIntPoint ActiveChunkCount = FIntPoint::ZeroValue;
+
+    /** Scratch transform arrays (kept between builds) */
+    TArray<FTransform> FloorScratch;
+    TArray<FTransform> WallScratch;
+
+    /** Chunks touched by a RefreshCells call */
+    TArray<FIntPoint> DirtyChunkScratch;
+
+    //=========================================================================
+    // STREAMING STATE (per active chunk)
+    //=========================================================================
+
+    /** Build settings, kept so chunks can be filled later */
+    FIntPoint BuiltGridSize = FIntPoint::ZeroValue;
+    float BuiltWallHeight = 0.0f;
+    FVector BuiltFloorScale = FVector::OneVector;
+    FVector BuiltWallScale = FVector::OneVector;
+
+    /** See GetBuildSerial */
+    uint32 BuildSerial = 0;
+
+    /** Is the chunk filled? */
+    TBitArray<> ResidentChunks;
+    int32 ResidentCount = 0;
+
+    /** StreamSerial of the last call that wanted the chunk */
+    TArray<uint32> ChunkWantedSerial;
+    uint32 StreamSerial = 0;
+
+    /** Resident chunks the current StreamChunks call did not want */
+    TArray<int32> EvictScratch;
+};
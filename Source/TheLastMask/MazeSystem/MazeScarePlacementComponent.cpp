@@ -0,0 +1,413 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeScarePlacementComponent.h"
+#include "MazeDifficultyDirector.h"
+#include "MazeManager.h"
+#include "MazeDebugVisualizer.h"
+#include "Core/MazePathfinder.h"
+#include "GameFramework/Actor.h"
+
+namespace MazeScares
+{
+    const FIntPoint Offsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+    /** Walkable neighbours of Cell other than Exclude. Returns how many. */
+    int32 GatherOpenNeighbors(const UMazePathfinder& Pathfinder, FIntPoint Cell, FIntPoint Exclude, FIntPoint (&OutNeighbors)[4])
+    {
+        int32 Count = 0;
+        for (const FIntPoint& Offset : Offsets)
+        {
+            const FIntPoint Neighbor = Cell + Offset;
+            if (Neighbor != Exclude && Pathfinder.IsValidCell(Neighbor))
+            {
+                OutNeighbors[Count++] = Neighbor;
+            }
+        }
+        return Count;
+    }
+}
+
+UMazeScarePlacementComponent::UMazeScarePlacementComponent()
+{
+    // Driven entirely by the director's cell change event
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMazeScarePlacementComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // maze.debug scare.view / scare.candidates (no subsystem in shipping builds)
+    if (UMazeDebugVisualizerSubsystem* DebugView = GetWorld()->GetSubsystem<UMazeDebugVisualizerSubsystem>())
+    {
+        TWeakObjectPtr<UMazeScarePlacementComponent> WeakThis(this);
+
+        DebugView->RegisterLayer(TEXT("scare.view"), [WeakThis](const AMazeManager& Maze, FMazeDebugSample& Sample)
+        {
+            const UMazeScarePlacementComponent* Self = WeakThis.Get();
+            if (!Self || Self->ViewMaze.Get() != &Maze)
+            {
+                return false;
+            }
+
+            const int32 SizeX = Maze.GetMazeSize().X;
+            for (const int32 Index : Self->ViewIndices)
+            {
+                const FIntPoint Cell(Index % SizeX, Index / SizeX);
+                if (Sample.Rect.Contains(Cell))
+                {
+                    Sample.At(Cell.X, Cell.Y) = 1.0f;
+                }
+            }
+            return true;
+        });
+
+        DebugView->RegisterLayer(TEXT("scare.candidates"), [WeakThis](const AMazeManager& Maze, FMazeDebugSample& Sample)
+        {
+            const UMazeScarePlacementComponent* Self = WeakThis.Get();
+            if (!Self || Self->ViewMaze.Get() != &Maze)
+            {
+                return false;
+            }
+
+            for (const FMazeScareCandidate& Candidate : Self->Candidates)
+            {
+                if (Sample.Rect.Contains(Candidate.Cell))
+                {
+                    Sample.At(Candidate.Cell.X, Candidate.Cell.Y) = Candidate.Probability;
+                }
+            }
+            return true;
+        });
+    }
+
+    UMazeDifficultyDirectorComponent* DirectorPtr = Director.Get();
+    if (!DirectorPtr && GetOwner())
+    {
+        DirectorPtr = GetOwner()->FindComponentByClass<UMazeDifficultyDirectorComponent>();
+    }
+
+    if (!DirectorPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeScarePlacement: No difficulty director on %s, scares will not be placed"),
+            *GetNameSafe(GetOwner()));
+        return;
+    }
+
+    BoundDirector = DirectorPtr;
+    CellChangedHandle = DirectorPtr->OnPlayerCellChangedNative.AddUObject(this, &UMazeScarePlacementComponent::HandlePlayerCellChanged);
+}
+
+void UMazeScarePlacementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get())
+    {
+        DirectorPtr->OnPlayerCellChangedNative.Remove(CellChangedHandle);
+    }
+    CellChangedHandle.Reset();
+    BoundDirector.Reset();
+
+    if (UMazeDebugVisualizerSubsystem* DebugView = GetWorld()->GetSubsystem<UMazeDebugVisualizerSubsystem>())
+    {
+        DebugView->UnregisterLayer(TEXT("scare.view"));
+        DebugView->UnregisterLayer(TEXT("scare.candidates"));
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+//=============================================================================
+// UPDATE (once per player cell change)
+//=============================================================================
+
+void UMazeScarePlacementComponent::HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Candidates.Reset();
+
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    const AMazeManager* Maze = DirectorPtr ? DirectorPtr->GetCurrentMaze() : nullptr;
+    const UMazePathfinder* Pathfinder = Maze ? Maze->GetPathfinder() : nullptr;
+
+    if (!Pathfinder || !Pathfinder->IsInitialized())
+    {
+        LastPlayerCell = FIntPoint(-1, -1);
+        FinalizeCandidates();
+        return;
+    }
+
+    // Only a one-cell step tells us which way the player is heading
+    if (Maze != ViewMaze.Get())
+    {
+        LastPlayerCell = FIntPoint(-1, -1);
+    }
+    const FIntPoint Step = NewCell - LastPlayerCell;
+    const FIntPoint CameFrom = FMath::Abs(Step.X) + FMath::Abs(Step.Y) == 1 ? LastPlayerCell : FIntPoint(-1, -1);
+    LastPlayerCell = NewCell;
+
+    RebuildViewSet(*Maze, NewCell);
+    PredictRoute(*Maze, NewCell, CameFrom, Metrics.Lostness);
+    FinalizeCandidates();
+
+    LastUpdateMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UMazeScarePlacementComponent::RebuildViewSet(const AMazeManager& Maze, FIntPoint Origin)
+{
+    const UMazePathfinder& Pathfinder = *Maze.GetPathfinder();
+    const FIntPoint Size = Maze.GetMazeSize();
+    const int32 NumCells = Size.X * Size.Y;
+
+    // Clear only what the last update set (full reset on a new maze)
+    if (ViewMaze.Get() != &Maze || ViewBits.Num() != NumCells)
+    {
+        ViewMaze = &Maze;
+        ViewBits.Init(false, NumCells);
+    }
+    else
+    {
+        for (const int32 Index : ViewIndices)
+        {
+            ViewBits[Index] = false;
+        }
+    }
+    ViewIndices.Reset();
+
+    // Walls block sight; see UMazePathfinder::ForEachVisibleCell
+    Pathfinder.ForEachVisibleCell(Origin, ViewRadius, [this, &Size](FIntPoint Cell)
+    {
+        const int32 Index = Cell.Y * Size.X + Cell.X;
+        if (!ViewBits[Index])
+        {
+            ViewBits[Index] = true;
+            ViewIndices.Add(Index);
+        }
+    });
+}
+
+void UMazeScarePlacementComponent::PredictRoute(const AMazeManager& Maze, FIntPoint Origin, FIntPoint CameFrom, float Lostness)
+{
+    const UMazePathfinder& Pathfinder = *Maze.GetPathfinder();
+    const TArray<int32>& TargetField = BoundDirector->GetTargetDistanceField();
+    const FIntPoint Size = Maze.GetMazeSize();
+
+    if (TargetField.Num() != Size.X * Size.Y || !Pathfinder.IsValidCell(Origin))
+    {
+        return;
+    }
+
+    // Unreachable cells rank last when choosing the downhill branch
+    auto Rank = [&TargetField, &Size](FIntPoint Cell)
+    {
+        const int32 Distance = TargetField[Cell.Y * Size.X + Cell.X];
+        return Distance == INDEX_NONE ? MAX_int32 : Distance;
+    };
+
+    FIntPoint Options[4];
+    FIntPoint Previous = CameFrom;
+    FIntPoint Current = Origin;
+    float Probability = 1.0f;
+    int32 Junctions = 0;
+
+    for (int32 StepsAhead = 1; StepsAhead <= MaxLookaheadCells; ++StepsAhead)
+    {
+        const int32 NumOptions = MazeScares::GatherOpenNeighbors(Pathfinder, Current, Previous, Options);
+        if (NumOptions == 0)
+        {
+            // Dead end: the player turns around, the prediction stops here
+            break;
+        }
+
+        int32 Chosen = 0;
+        for (int32 i = 1; i < NumOptions; ++i)
+        {
+            if (Rank(Options[i]) < Rank(Options[Chosen]))
+            {
+                Chosen = i;
+            }
+        }
+
+        if (NumOptions > 1)
+        {
+            if (Junctions == PredictedJunctions)
+            {
+                break;
+            }
+            ++Junctions;
+
+            // Oriented players take the downhill branch, lost ones pick any
+            const float Uniform = 1.0f / NumOptions;
+            const float TakeChosen = FMath::Lerp(FMath::Max(OrientedChoiceProbability, Uniform), Uniform,
+                FMath::Clamp(Lostness, 0.0f, 1.0f));
+            const float TakeOther = (1.0f - TakeChosen) / (NumOptions - 1);
+
+            // Wrong turns: a candidate a few cells into each other branch
+            for (int32 i = 0; i < NumOptions; ++i)
+            {
+                if (i == Chosen)
+                {
+                    continue;
+                }
+
+                FIntPoint BranchPrevious = Current;
+                FIntPoint BranchCell = Options[i];
+                int32 Depth = 1;
+                FIntPoint BranchNext[4];
+
+                while (Depth < WrongTurnDepth &&
+                    MazeScares::GatherOpenNeighbors(Pathfinder, BranchCell, BranchPrevious, BranchNext) == 1)
+                {
+                    BranchPrevious = BranchCell;
+                    BranchCell = BranchNext[0];
+                    ++Depth;
+                }
+
+                AddCandidate(BranchCell, Probability * TakeOther, StepsAhead + Depth - 1, Junctions, true);
+            }
+
+            Probability *= TakeChosen;
+        }
+
+        Previous = Current;
+        Current = Options[Chosen];
+
+        if (StepsAhead >= MinStepsAhead)
+        {
+            AddCandidate(Current, Probability, StepsAhead, Junctions, false);
+        }
+
+        if (Rank(Current) == 0)
+        {
+            break;
+        }
+    }
+}
+
+void UMazeScarePlacementComponent::AddCandidate(FIntPoint Cell, float Probability, int32 StepsAhead, int32 JunctionsAhead, bool bWrongTurn)
+{
+    if (Probability < MinCandidateProbability || IsCellInView(Cell))
+    {
+        return;
+    }
+
+    FMazeScareCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+    Candidate.Cell = Cell;
+    Candidate.Probability = Probability;
+    Candidate.StepsAhead = StepsAhead;
+    Candidate.JunctionsAhead = JunctionsAhead;
+    Candidate.bWrongTurn = bWrongTurn;
+}
+
+void UMazeScarePlacementComponent::FinalizeCandidates()
+{
+    // Most likely first; nearer first on ties
+    Candidates.Sort([](const FMazeScareCandidate& A, const FMazeScareCandidate& B)
+    {
+        return A.Probability != B.Probability ? A.Probability > B.Probability : A.StepsAhead < B.StepsAhead;
+    });
+
+    const int32 Num = Candidates.Num();
+    AliasThreshold.SetNumUninitialized(Num, EAllowShrinking::No);
+    AliasIndex.SetNumUninitialized(Num, EAllowShrinking::No);
+    AliasScaled.SetNumUninitialized(Num, EAllowShrinking::No);
+    AliasSmall.Reset();
+    AliasLarge.Reset();
+
+    float Total = 0.0f;
+    for (const FMazeScareCandidate& Candidate : Candidates)
+    {
+        Total += Candidate.Probability;
+    }
+
+    if (Num == 0 || Total <= 0.0f)
+    {
+        return;
+    }
+
+    /*
+        Vose's alias method: scale weights so they average 1, then pair
+        each under-full column with an over-full one that tops it up.
+    */
+    for (int32 i = 0; i < Num; ++i)
+    {
+        AliasScaled[i] = Candidates[i].Probability * Num / Total;
+        (AliasScaled[i] < 1.0f ? AliasSmall : AliasLarge).Add(i);
+    }
+
+    while (AliasSmall.Num() > 0 && AliasLarge.Num() > 0)
+    {
+        const int32 Small = AliasSmall.Pop(EAllowShrinking::No);
+        const int32 Large = AliasLarge.Pop(EAllowShrinking::No);
+
+        AliasThreshold[Small] = AliasScaled[Small];
+        AliasIndex[Small] = Large;
+
+        AliasScaled[Large] = (AliasScaled[Large] + AliasScaled[Small]) - 1.0f;
+        (AliasScaled[Large] < 1.0f ? AliasSmall : AliasLarge).Add(Large);
+    }
+
+    // Leftovers are full columns (float error can leave some in either list)
+    for (const int32 Index : AliasLarge)
+    {
+        AliasThreshold[Index] = 1.0f;
+        AliasIndex[Index] = Index;
+    }
+    for (const int32 Index : AliasSmall)
+    {
+        AliasThreshold[Index] = 1.0f;
+        AliasIndex[Index] = Index;
+    }
+}
+
+//=============================================================================
+// QUERIES
+//=============================================================================
+
+bool UMazeScarePlacementComponent::GetBestScareCandidate(FMazeScareCandidate& OutCandidate) const
+{
+    if (Candidates.Num() == 0)
+    {
+        return false;
+    }
+
+    OutCandidate = Candidates[0];
+    return true;
+}
+
+bool UMazeScarePlacementComponent::PickScareCandidate(FMazeScareCandidate& OutCandidate) const
+{
+    if (Candidates.Num() == 0 || AliasThreshold.Num() != Candidates.Num())
+    {
+        return false;
+    }
+
+    const int32 Column = FMath::RandHelper(Candidates.Num());
+    OutCandidate = Candidates[FMath::FRand() < AliasThreshold[Column] ? Column : AliasIndex[Column]];
+    return true;
+}
+
+FVector UMazeScarePlacementComponent::GetCandidateWorldLocation(const FMazeScareCandidate& Candidate) const
+{
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    const AMazeManager* Maze = DirectorPtr ? DirectorPtr->GetCurrentMaze() : nullptr;
+    return Maze ? Maze->MazeCellToWorld(Candidate.Cell) : FVector::ZeroVector;
+}
+
+bool UMazeScarePlacementComponent::IsCellInView(FIntPoint Cell) const
+{
+    const AMazeManager* Maze = ViewMaze.Get();
+    if (!Maze)
+    {
+        return false;
+    }
+
+    const FIntPoint Size = Maze->GetMazeSize();
+    if (Cell.X < 0 || Cell.X >= Size.X || Cell.Y < 0 || Cell.Y >= Size.Y)
+    {
+        return false;
+    }
+
+    const int32 Index = Cell.Y * Size.X + Cell.X;
+    return ViewBits.IsValidIndex(Index) && ViewBits[Index];
+}
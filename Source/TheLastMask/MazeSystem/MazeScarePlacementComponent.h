@@ -0,0 +1,219 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MazeScarePlacementComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    TBitArray:
+        - Packed array of bools (1 bit each)
+        - The view set for a 101x101 maze is ~1.3 KB, and "is this cell
+          visible?" is a single bit test
+
+    Native multicast delegates (AddUObject):
+        - C++-only events: no reflection, no parameter copies
+        - AddUObject holds a weak reference, so a destroyed listener is
+          skipped instead of crashing; we still remove it in EndPlay
+
+    ALIAS METHOD (Vose):
+        - Weighted random pick in O(1): one random column, one coin flip
+        - Each column holds its own weight plus a share of one "alias"
+        - Tables are built in O(n) once per update, then any number of
+          picks cost the same
+=============================================================================*/
+
+class AMazeManager;
+class UMazeDifficultyDirectorComponent;
+struct FMazeLostnessMetrics;
+
+/**
+ * A cell where a scare could go.
+ */
+USTRUCT(BlueprintType)
+struct FMazeScareCandidate
+{
+    GENERATED_BODY()
+
+    /** Grid cell (floor) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Scares")
+    FIntPoint Cell = FIntPoint(-1, -1);
+
+    /** Predicted chance the player walks through this cell (0..1) */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Scares")
+    float Probability = 0.0f;
+
+    /** Cells between the player and this cell along the predicted walk */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Scares")
+    int32 StepsAhead = 0;
+
+    /** Junctions passed before reaching this cell */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Scares")
+    int32 JunctionsAhead = 0;
+
+    /** True if this cell is down a branch the player is NOT expected to take */
+    UPROPERTY(BlueprintReadOnly, Category = "Maze|Scares")
+    bool bWrongTurn = false;
+};
+
+/**
+ * Picks jump-scare trigger cells on the player's likely route but out of sight.
+ *
+ * Add next to a UMazeDifficultyDirectorComponent (player pawn). On every
+ * cell change the director reports, this component:
+ *   1. Marks every floor cell visible from the player cell (ray casts
+ *      through the grid, walls block) in a bitset
+ *   2. Walks the predicted route: keep going the way the player moves,
+ *      and at each junction take the branch downhill on the director's
+ *      target distance field. K junctions deep.
+ *   3. Gives each cell a probability: at a junction a confident player
+ *      takes the downhill branch, a lost player (director Lostness)
+ *      picks any branch. Wrong branches get a candidate a few cells in.
+ *   4. Drops visible and unlikely cells, sorts the rest, builds alias tables
+ *
+ * PERFORMANCE:
+ *   - One update is ~ViewRadius^2 * 8 + MaxLookaheadCells cell reads
+ *     (a few microseconds), and only when the player changes cell
+ *   - No allocations after the first update (scratch arrays are reused)
+ *   - Every query is O(1)
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazeScarePlacementComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazeScarePlacementComponent();
+
+    //=========================================================================
+    // SETUP
+    //=========================================================================
+
+    /** Optional: director to follow. Empty = the one on the owning actor. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares")
+    TObjectPtr<UMazeDifficultyDirectorComponent> Director;
+
+    //=========================================================================
+    // TUNING
+    //=========================================================================
+
+    /** K: how many junction choices ahead to predict */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 PredictedJunctions = 3;
+
+    /** Hard cap on the predicted walk (cells) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "4", ClampMax = "256"))
+    int32 MaxLookaheadCells = 40;
+
+    /** Never place a scare closer than this (cells along the route) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "1"))
+    int32 MinStepsAhead = 3;
+
+    /** How far into a wrong branch its candidate sits (cells) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "1", ClampMax = "16"))
+    int32 WrongTurnDepth = 3;
+
+    /** Chance an oriented player (Lostness 0) takes the downhill branch */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float OrientedChoiceProbability = 0.8f;
+
+    /** Cells less likely than this are not candidates */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float MinCandidateProbability = 0.05f;
+
+    /**
+     * How far the player can see (cells). Rays are cast in every direction:
+     * the camera turns faster than the player changes cell.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scares|Tuning", meta = (ClampMin = "1", ClampMax = "64"))
+    int32 ViewRadius = 12;
+
+    //=========================================================================
+    // QUERIES (all O(1))
+    //=========================================================================
+
+    /**
+     * Most likely out-of-view cell on the predicted route.
+     * @return False if there is no candidate right now
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Scares")
+    bool GetBestScareCandidate(FMazeScareCandidate& OutCandidate) const;
+
+    /**
+     * Random candidate, weighted by probability (alias method).
+     * @return False if there is no candidate right now
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Scares")
+    bool PickScareCandidate(FMazeScareCandidate& OutCandidate) const;
+
+    /** World position of a candidate cell (cell centre, floor level) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Scares")
+    FVector GetCandidateWorldLocation(const FMazeScareCandidate& Candidate) const;
+
+    /** Can the player see this cell from where they stand? */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Scares")
+    bool IsCellInView(FIntPoint Cell) const;
+
+    /** Number of candidates right now */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Scares")
+    int32 GetNumCandidates() const { return Candidates.Num(); }
+
+    /** All candidates, most likely first */
+    const TArray<FMazeScareCandidate>& GetCandidates() const { return Candidates; }
+
+    /** Cost of the last update */
+    float GetLastUpdateMs() const { return LastUpdateMs; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Director callback: rebuild the view set and candidates */
+    void HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics);
+
+    /** Mark every floor cell visible from Origin */
+    void RebuildViewSet(const AMazeManager& Maze, FIntPoint Origin);
+
+    /** Walk K junctions ahead and collect out-of-view candidates */
+    void PredictRoute(const AMazeManager& Maze, FIntPoint Origin, FIntPoint CameFrom, float Lostness);
+
+    /** Sort candidates and build the alias tables */
+    void FinalizeCandidates();
+
+    /** Add a candidate unless it is visible or too unlikely */
+    void AddCandidate(FIntPoint Cell, float Probability, int32 StepsAhead, int32 JunctionsAhead, bool bWrongTurn);
+
+private:
+    /** Director we are bound to */
+    TWeakObjectPtr<UMazeDifficultyDirectorComponent> BoundDirector;
+    FDelegateHandle CellChangedHandle;
+
+    /** Maze the view set was sized for */
+    TWeakObjectPtr<const AMazeManager> ViewMaze;
+
+    /** Previous player cell (movement direction for the prediction) */
+    FIntPoint LastPlayerCell = FIntPoint(-1, -1);
+
+    /** Visible floor cells (Index = Y * SizeX + X) */
+    TBitArray<> ViewBits;
+
+    /** Indices set in ViewBits (so clearing costs only what was set) */
+    TArray<int32> ViewIndices;
+
+    /** Current candidates, most likely first */
+    TArray<FMazeScareCandidate> Candidates;
+
+    /** Alias tables: column i keeps i with AliasThreshold[i], else AliasIndex[i] */
+    TArray<float> AliasThreshold;
+    TArray<int32> AliasIndex;
+
+    /** Scratch for the alias build */
+    TArray<int32> AliasSmall;
+    TArray<int32> AliasLarge;
+    TArray<float> AliasScaled;
+
+    float LastUpdateMs = 0.0f;
+};
@@ -0,0 +1,155 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeScentSubsystem.h"
+#include "MazeDebugVisualizer.h"
+#include "MazeManager.h"
+#include "Core/MazePathfinder.h"
+#include "Engine/World.h"
+
+void UMazeScentSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // maze.debug scent (no subsystem in shipping builds)
+    if (UMazeDebugVisualizerSubsystem* DebugView = InWorld.GetSubsystem<UMazeDebugVisualizerSubsystem>())
+    {
+        TWeakObjectPtr<UMazeScentSubsystem> WeakThis(this);
+
+        DebugView->RegisterLayer(TEXT("scent"), [WeakThis](const AMazeManager& Maze, FMazeDebugSample& Sample)
+        {
+            const UMazeScentSubsystem* Self = WeakThis.Get();
+            const FMazeScentField* Field = Self ? Self->GetScentField(Maze) : nullptr;
+            const FIntPoint Size = Maze.GetMazeSize();
+            if (!Field || Field->GetSize() != Size)
+            {
+                return false;
+            }
+
+            // Only the cells the visualizer shows
+            const double Now = Self->GetNow();
+            for (int32 Y = Sample.Rect.Min.Y; Y < Sample.Rect.Max.Y; ++Y)
+            {
+                for (int32 X = Sample.Rect.Min.X; X < Sample.Rect.Max.X; ++X)
+                {
+                    const float Strength = Field->GetStrength(FIntPoint(X, Y), Now);
+                    if (Strength > 0.0f)
+                    {
+                        Sample.At(X, Y) = Strength;
+                    }
+                }
+            }
+            return true;
+        });
+    }
+}
+
+void UMazeScentSubsystem::Deinitialize()
+{
+    if (UMazeDebugVisualizerSubsystem* DebugView = GetWorld()->GetSubsystem<UMazeDebugVisualizerSubsystem>())
+    {
+        DebugView->UnregisterLayer(TEXT("scent"));
+    }
+
+    Fields.Reset();
+
+    Super::Deinitialize();
+}
+
+double UMazeScentSubsystem::GetNow() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetTimeSeconds() : 0.0;
+}
+
+//=============================================================================
+// FIELDS
+//=============================================================================
+
+const FMazeScentField* UMazeScentSubsystem::GetScentField(const AMazeManager& Maze) const
+{
+    const FScentEntry* Entry = Fields.FindByPredicate([&Maze](const FScentEntry& Candidate)
+    {
+        return Candidate.Maze.Get() == &Maze;
+    });
+
+    return Entry ? &Entry->Field : nullptr;
+}
+
+FMazeScentField* UMazeScentSubsystem::FindOrAddField(const AMazeManager& Maze)
+{
+    const FIntPoint Size = Maze.GetMazeSize();
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        return nullptr;
+    }
+
+    FScentEntry* Entry = Fields.FindByPredicate([&Maze](const FScentEntry& Candidate)
+    {
+        return Candidate.Maze.Get() == &Maze;
+    });
+
+    if (!Entry)
+    {
+        // Drop mazes that were destroyed (streamed out)
+        Fields.RemoveAllSwap([](const FScentEntry& Candidate) { return !Candidate.Maze.IsValid(); });
+
+        Entry = &Fields.AddDefaulted_GetRef();
+        Entry->Maze = &Maze;
+    }
+
+    // A regenerated maze of a different size starts with no trails
+    if (Entry->Field.GetSize() != Size)
+    {
+        Entry->Field.Reset(Size, GetNow());
+    }
+
+    Entry->Field.SetDecay(HalfLife, MinStrength);
+    return &Entry->Field;
+}
+
+//=============================================================================
+// DEPOSIT / QUERIES
+//=============================================================================
+
+void UMazeScentSubsystem::DepositScent(AMazeManager* Maze, FIntPoint Cell, float Amount)
+{
+    if (FMazeScentField* Field = Maze ? FindOrAddField(*Maze) : nullptr)
+    {
+        Field->Deposit(Cell, GetNow(), Amount, MaxStrength);
+    }
+}
+
+void UMazeScentSubsystem::ClearScent(AMazeManager* Maze)
+{
+    Fields.RemoveAllSwap([Maze](const FScentEntry& Candidate) { return Candidate.Maze.Get() == Maze; });
+}
+
+float UMazeScentSubsystem::GetScentAtCell(AMazeManager* Maze, FIntPoint Cell) const
+{
+    const FMazeScentField* Field = Maze ? GetScentField(*Maze) : nullptr;
+    return Field ? Field->GetStrength(Cell, GetNow()) : 0.0f;
+}
+
+bool UMazeScentSubsystem::FindStrongestScentNeighbor(AMazeManager* Maze, FIntPoint Cell, FIntPoint& OutCell, float& OutStrength) const
+{
+    OutCell = FIntPoint(-1, -1);
+    OutStrength = 0.0f;
+
+    const FMazeScentField* Field = Maze ? GetScentField(*Maze) : nullptr;
+    if (!Field)
+    {
+        return false;
+    }
+
+    // Walls that appeared after the player walked through block the trail
+    const UMazePathfinder* Pathfinder = Maze->GetPathfinder();
+    const TArrayView<const uint8> Walkable = Pathfinder ? TArrayView<const uint8>(Pathfinder->GetWalkableGrid()) : TArrayView<const uint8>();
+
+    return Field->FindStrongestNeighbor(Cell, GetNow(), Walkable, OutCell, OutStrength);
+}
+
+FIntPoint UMazeScentSubsystem::GetFreshestScentCell(AMazeManager* Maze) const
+{
+    const FMazeScentField* Field = Maze ? GetScentField(*Maze) : nullptr;
+    return Field ? Field->GetFreshestCell() : FIntPoint(-1, -1);
+}
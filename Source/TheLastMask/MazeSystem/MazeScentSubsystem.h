@@ -0,0 +1,102 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/MazeScentField.h"
+#include "MazeScentSubsystem.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    UWorldSubsystem (not tickable):
+        - One instance per world, found with GetWorld()->GetSubsystem<T>()
+        - This one never ticks: scent fades lazily when it is read, so
+          there is nothing to do between deposits and queries
+=============================================================================*/
+
+class AMazeManager;
+
+/**
+ * Scent trails per maze.
+ *
+ * UMazeScentTrailComponent (on the player) deposits scent in every cell the
+ * player walks through; enemy AI reads it back to follow the trail:
+ *
+ *   Cell = FindStrongestScentNeighbor(Maze, EnemyCell) -> step there, repeat
+ *
+ * Older scent is weaker, so following the strongest neighbour leads
+ * along the trail towards where the player went, not where they came from.
+ *
+ * PERFORMANCE:
+ *   - Deposit / read: one cell, O(1)
+ *   - Strongest neighbour: four cells
+ *   - Nothing per frame; a maze's grid is only allocated on its first deposit
+ */
+UCLASS()
+class THELASTMASK_API UMazeScentSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    /** Seconds for scent to fade to half strength */
+    float HalfLife = 20.0f;
+
+    /** Weaker scent reads as none (ends the trail) */
+    float MinStrength = 0.05f;
+
+    /** Cap on a single cell's scent (lingering cannot build it up forever) */
+    float MaxStrength = 4.0f;
+
+    //=========================================================================
+    // DEPOSIT
+    //=========================================================================
+
+    /** Add scent to a cell */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Scent")
+    void DepositScent(AMazeManager* Maze, FIntPoint Cell, float Amount = 1.0f);
+
+    /** Remove every trail in a maze */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Scent")
+    void ClearScent(AMazeManager* Maze);
+
+    //=========================================================================
+    // QUERIES
+    //=========================================================================
+
+    /** Scent strength in a cell right now (0 = none) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Scent")
+    float GetScentAtCell(AMazeManager* Maze, FIntPoint Cell) const;
+
+    /**
+     * Open neighbour (4-way) with the strongest scent.
+     * @return False if no neighbour smells of the player
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Scent")
+    bool FindStrongestScentNeighbor(AMazeManager* Maze, FIntPoint Cell, FIntPoint& OutCell, float& OutStrength) const;
+
+    /** Last cell scent was left in (-1,-1 if none) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Scent")
+    FIntPoint GetFreshestScentCell(AMazeManager* Maze) const;
+
+    /** Field of a maze (null before its first deposit) */
+    const FMazeScentField* GetScentField(const AMazeManager& Maze) const;
+
+private:
+    struct FScentEntry
+    {
+        TWeakObjectPtr<const AMazeManager> Maze;
+        FMazeScentField Field;
+    };
+
+    /** Field for a maze, created / resized for its current grid */
+    FMazeScentField* FindOrAddField(const AMazeManager& Maze);
+
+    double GetNow() const;
+
+    TArray<FScentEntry> Fields;
+};
@@ -0,0 +1,75 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeScentTrailComponent.h"
+#include "MazeScentSubsystem.h"
+#include "MazeDifficultyDirector.h"
+#include "MazeManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UMazeScentTrailComponent::UMazeScentTrailComponent()
+{
+    // Only tops up the current cell; entering cells is event driven
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickInterval = 0.5f;
+}
+
+void UMazeScentTrailComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    UMazeDifficultyDirectorComponent* DirectorPtr = Director.Get();
+    if (!DirectorPtr && GetOwner())
+    {
+        DirectorPtr = GetOwner()->FindComponentByClass<UMazeDifficultyDirectorComponent>();
+    }
+
+    if (!DirectorPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeScentTrail: No difficulty director on %s, no scent will be left"),
+            *GetNameSafe(GetOwner()));
+        SetComponentTickEnabled(false);
+        return;
+    }
+
+    BoundDirector = DirectorPtr;
+    CellChangedHandle = DirectorPtr->OnPlayerCellChangedNative.AddUObject(this, &UMazeScentTrailComponent::HandlePlayerCellChanged);
+}
+
+void UMazeScentTrailComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get())
+    {
+        DirectorPtr->OnPlayerCellChangedNative.Remove(CellChangedHandle);
+    }
+    CellChangedHandle.Reset();
+    BoundDirector.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UMazeScentTrailComponent::HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics)
+{
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    UMazeScentSubsystem* Scent = GetWorld()->GetSubsystem<UMazeScentSubsystem>();
+    if (bLeavingScent && DirectorPtr && Scent)
+    {
+        Scent->DepositScent(DirectorPtr->GetCurrentMaze(), NewCell, ScentPerCell);
+    }
+}
+
+void UMazeScentTrailComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const UMazeDifficultyDirectorComponent* DirectorPtr = BoundDirector.Get();
+    if (!bLeavingScent || !DirectorPtr || LingerScentPerSecond <= 0.0f)
+    {
+        return;
+    }
+
+    if (UMazeScentSubsystem* Scent = GetWorld()->GetSubsystem<UMazeScentSubsystem>())
+    {
+        Scent->DepositScent(DirectorPtr->GetCurrentMaze(), DirectorPtr->GetPlayerCell(), LingerScentPerSecond * DeltaTime);
+    }
+}
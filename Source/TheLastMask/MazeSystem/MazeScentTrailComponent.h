@@ -0,0 +1,68 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MazeScentTrailComponent.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    Event-driven deposits:
+        - Scent is laid when the director reports a new player cell, not
+          polled every frame
+        - A slow tick (TickInterval) tops up the current cell while the
+          player stands still, so hiding in a corner leaves a strong mark
+=============================================================================*/
+
+class UMazeDifficultyDirectorComponent;
+struct FMazeLostnessMetrics;
+
+/**
+ * Leaves the player's scent trail in UMazeScentSubsystem.
+ *
+ * Add next to a UMazeDifficultyDirectorComponent (player pawn). Enemies
+ * follow the trail with UMazeScentSubsystem::FindStrongestScentNeighbor.
+ */
+UCLASS(ClassGroup = "Maze", meta = (BlueprintSpawnableComponent))
+class THELASTMASK_API UMazeScentTrailComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMazeScentTrailComponent();
+
+    /** Optional: director to follow. Empty = the one on the owning actor. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scent")
+    TObjectPtr<UMazeDifficultyDirectorComponent> Director;
+
+    /** Scent left on entering a cell */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scent", meta = (ClampMin = "0.0"))
+    float ScentPerCell = 1.0f;
+
+    /** Extra scent per second while staying in the same cell (0 = off) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Maze|Scent", meta = (ClampMin = "0.0"))
+    float LingerScentPerSecond = 0.25f;
+
+    /** Stop (or resume) leaving a trail, e.g. while a cloaking mask is worn */
+    UFUNCTION(BlueprintCallable, Category = "Maze|Scent")
+    void SetLeavingScent(bool bLeave) { bLeavingScent = bLeave; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|Scent")
+    bool IsLeavingScent() const { return bLeavingScent; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /** Director callback: scent the new cell */
+    void HandlePlayerCellChanged(FIntPoint NewCell, const FMazeLostnessMetrics& Metrics);
+
+private:
+    TWeakObjectPtr<UMazeDifficultyDirectorComponent> BoundDirector;
+    FDelegateHandle CellChangedHandle;
+
+    bool bLeavingScent = true;
+};
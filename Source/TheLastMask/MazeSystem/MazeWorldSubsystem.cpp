@@ -0,0 +1,190 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeWorldSubsystem.h"
+#include "MazeManager.h"
+
+void UMazeWorldSubsystem::RegisterMaze(AMazeManager* Maze)
+{
+    if (!Maze)
+    {
+        return;
+    }
+
+    const FBox WorldBounds = Maze->GetMazeWorldBounds();
+    if (!WorldBounds.IsValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MazeWorldSubsystem: %s has no grid data, not registered"),
+            *Maze->GetName());
+        return;
+    }
+
+    FMazeEntry NewEntry;
+    NewEntry.Maze = Maze;
+    NewEntry.Bounds = FBox2D(FVector2D(WorldBounds.Min), FVector2D(WorldBounds.Max));
+    NewEntry.Area = NewEntry.Bounds.GetArea();
+
+    // Re-registering refreshes the bounds (e.g. after a maze swap)
+    const int32 ExistingIndex = Entries.IndexOfByPredicate(
+        [Maze](const FMazeEntry& Entry) { return Entry.Maze.Get() == Maze; });
+
+    if (ExistingIndex != INDEX_NONE)
+    {
+        Entries[ExistingIndex] = NewEntry;
+    }
+    else
+    {
+        Entries.Add(NewEntry);
+    }
+
+    RebuildIndex();
+}
+
+void UMazeWorldSubsystem::UnregisterMaze(AMazeManager* Maze)
+{
+    const int32 NumRemoved = Entries.RemoveAll(
+        [Maze](const FMazeEntry& Entry) { return !Entry.Maze.IsValid() || Entry.Maze.Get() == Maze; });
+
+    if (NumRemoved > 0)
+    {
+        RebuildIndex();
+    }
+}
+
+void UMazeWorldSubsystem::RebuildIndex()
+{
+    Buckets.Reset();
+
+    // Bucket size = largest maze extent, so every maze touches at most 2x2 buckets
+    BucketSize = 1.0;
+    for (const FMazeEntry& Entry : Entries)
+    {
+        const FVector2D Extent = Entry.Bounds.GetSize();
+        BucketSize = FMath::Max(BucketSize, FMath::Max(Extent.X, Extent.Y));
+    }
+
+    // Smallest first so nested sub-mazes win the lookup
+    TArray<int32> SortedEntries;
+    SortedEntries.Reserve(Entries.Num());
+    for (int32 i = 0; i < Entries.Num(); ++i)
+    {
+        SortedEntries.Add(i);
+    }
+    SortedEntries.Sort([this](int32 A, int32 B) { return Entries[A].Area < Entries[B].Area; });
+
+    for (const int32 EntryIndex : SortedEntries)
+    {
+        const FBox2D& Bounds = Entries[EntryIndex].Bounds;
+        const FIntPoint MinBucket = GetBucket(Bounds.Min);
+        const FIntPoint MaxBucket = GetBucket(Bounds.Max);
+
+        for (int32 BY = MinBucket.Y; BY <= MaxBucket.Y; ++BY)
+        {
+            for (int32 BX = MinBucket.X; BX <= MaxBucket.X; ++BX)
+            {
+                Buckets.FindOrAdd(FIntPoint(BX, BY)).Add(EntryIndex);
+            }
+        }
+    }
+}
+
+FIntPoint UMazeWorldSubsystem::GetBucket(const FVector2D& Point) const
+{
+    return FIntPoint(
+        FMath::FloorToInt32(Point.X / BucketSize),
+        FMath::FloorToInt32(Point.Y / BucketSize)
+    );
+}
+
+AMazeManager* UMazeWorldSubsystem::FindMazeAtLocation(FVector WorldLocation, FIntPoint& OutCell) const
+{
+    OutCell = FIntPoint(-1, -1);
+
+    const FVector2D Point(WorldLocation);
+    const TArray<int32, TInlineAllocator<2>>* Candidates = Buckets.Find(GetBucket(Point));
+    if (!Candidates)
+    {
+        return nullptr;
+    }
+
+    for (const int32 EntryIndex : *Candidates)
+    {
+        const FMazeEntry& Entry = Entries[EntryIndex];
+        if (!Entry.Bounds.IsInside(Point))
+        {
+            continue;
+        }
+
+        // The AABB is loose for rotated mazes; the grid test is exact
+        AMazeManager* Maze = Entry.Maze.Get();
+        if (Maze && Maze->WorldToMazeCell(WorldLocation, OutCell))
+        {
+            return Maze;
+        }
+    }
+
+    OutCell = FIntPoint(-1, -1);
+    return nullptr;
+}
+
+bool UMazeWorldSubsystem::IsLocationWalkable(FVector WorldLocation) const
+{
+    FIntPoint Cell;
+    const AMazeManager* Maze = FindMazeAtLocation(WorldLocation, Cell);
+    return Maze && Maze->GetPathfinder() && Maze->GetPathfinder()->IsValidCell(Cell);
+}
+
+FMazePathResult UMazeWorldSubsystem::FindPathBetweenLocations(FVector WorldStart, FVector WorldEnd, AMazeManager*& OutMaze) const
+{
+    OutMaze = nullptr;
+
+    FIntPoint StartCell;
+    FIntPoint EndCell;
+    AMazeManager* StartMaze = FindMazeAtLocation(WorldStart, StartCell);
+    AMazeManager* EndMaze = FindMazeAtLocation(WorldEnd, EndCell);
+
+    if (!StartMaze || StartMaze != EndMaze || !StartMaze->GetPathfinder())
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("MazeWorldSubsystem: Start and end are not in the same maze"));
+        return FMazePathResult();
+    }
+
+    UMazePathfinder* Pathfinder = StartMaze->GetPathfinder();
+
+    // Snap wall hits onto the nearest floor, same as ShowPath does
+    if (!Pathfinder->IsValidCell(StartCell))
+    {
+        StartCell = Pathfinder->FindNearestWalkableCell(StartCell);
+    }
+    if (!Pathfinder->IsValidCell(EndCell))
+    {
+        EndCell = Pathfinder->FindNearestWalkableCell(EndCell);
+    }
+
+    FMazePathResult Result = Pathfinder->FindPath(StartCell, EndCell);
+
+    // Pathfinder works in maze-local space; callers here think in world space
+    const FTransform& MazeTransform = StartMaze->GetActorTransform();
+    for (FVector& Position : Result.PathWorldPositions)
+    {
+        Position = MazeTransform.TransformPosition(Position);
+    }
+
+    OutMaze = StartMaze;
+    return Result;
+}
+
+TArray<AMazeManager*> UMazeWorldSubsystem::GetAllMazes() const
+{
+    TArray<AMazeManager*> Mazes;
+    Mazes.Reserve(Entries.Num());
+
+    for (const FMazeEntry& Entry : Entries)
+    {
+        if (AMazeManager* Maze = Entry.Maze.Get())
+        {
+            Mazes.Add(Maze);
+        }
+    }
+
+    return Mazes;
+}
@@ -0,0 +1,130 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/MazePathfinder.h"
+#include "MazeWorldSubsystem.generated.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    UWorldSubsystem:
+        - An object that lives exactly as long as its UWorld
+        - Created automatically by the engine, no spawning or placing needed
+        - Get it from anywhere: GetWorld()->GetSubsystem<UMazeWorldSubsystem>()
+        - Blueprints can get it with the "Get MazeWorldSubsystem" node
+
+    TWeakObjectPtr<T>:
+        - A reference that does NOT keep the object alive
+        - Returns null once the actor is destroyed
+        - Used here so a forgotten Unregister never dangles
+
+    FBox2D:
+        - Axis-aligned 2D box (Min/Max corners)
+        - IsInside(Point) is a handful of compares
+=============================================================================*/
+
+class AMazeManager;
+
+/**
+ * Registry of every AMazeManager in the world.
+ *
+ * Levels can contain several mazes (main maze, sub-mazes, test grounds).
+ * Instead of iterating actors to find "the" manager, systems ask this
+ * subsystem which maze owns a world position.
+ *
+ * SPATIAL INDEX:
+ *   World XY is split into square buckets sized to the largest maze.
+ *   Each maze is listed in every bucket its bounds overlap (so at most
+ *   four buckets per maze). A lookup hashes the point to one bucket and
+ *   tests only the handful of mazes listed there -> O(1).
+ *
+ *   Mazes in a bucket are sorted smallest-first, so a sub-maze placed
+ *   inside a bigger maze wins over its parent.
+ */
+UCLASS()
+class THELASTMASK_API UMazeWorldSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //=========================================================================
+    // REGISTRATION (called by AMazeManager)
+    //=========================================================================
+
+    /** Add a maze to the registry. Safe to call again to refresh its bounds. */
+    void RegisterMaze(AMazeManager* Maze);
+
+    /** Remove a maze from the registry. */
+    void UnregisterMaze(AMazeManager* Maze);
+
+    //=========================================================================
+    // QUERIES
+    //=========================================================================
+
+    /**
+     * Find the maze that contains a world position.
+     *
+     * @param WorldLocation - Position in world space
+     * @param OutCell - Grid cell inside the returned maze (or (-1,-1))
+     * @return Owning maze, or nullptr if the point is outside every maze
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|World")
+    AMazeManager* FindMazeAtLocation(FVector WorldLocation, FIntPoint& OutCell) const;
+
+    /**
+     * Is this world position on a walkable cell of any maze?
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|World")
+    bool IsLocationWalkable(FVector WorldLocation) const;
+
+    /**
+     * Find a path between two world positions.
+     * Both positions must be inside the same maze.
+     *
+     * @param WorldStart - Start position in world space
+     * @param WorldEnd - End position in world space
+     * @param OutMaze - The maze the path was found in (nullptr on failure)
+     * @return Path result; PathWorldPositions are in WORLD space
+     */
+    UFUNCTION(BlueprintCallable, Category = "Maze|World")
+    FMazePathResult FindPathBetweenLocations(FVector WorldStart, FVector WorldEnd, AMazeManager*& OutMaze) const;
+
+    /** Get every registered maze (destroyed mazes are skipped) */
+    UFUNCTION(BlueprintCallable, Category = "Maze|World")
+    TArray<AMazeManager*> GetAllMazes() const;
+
+    /** Number of registered mazes */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Maze|World")
+    int32 GetMazeCount() const { return Entries.Num(); }
+
+private:
+    /** One registered maze and its world-space footprint */
+    struct FMazeEntry
+    {
+        TWeakObjectPtr<AMazeManager> Maze;
+
+        /** World-space XY bounds of the whole grid */
+        FBox2D Bounds;
+
+        /** Bounds area, used to prefer sub-mazes over their parent */
+        double Area = 0.0;
+    };
+
+    /** Rebuild the bucket index after a registration change */
+    void RebuildIndex();
+
+    /** Bucket coordinate containing a world XY position */
+    FIntPoint GetBucket(const FVector2D& Point) const;
+
+    /** All registered mazes */
+    TArray<FMazeEntry> Entries;
+
+    /** Bucket -> indices into Entries (smallest maze first) */
+    TMap<FIntPoint, TArray<int32, TInlineAllocator<2>>> Buckets;
+
+    /** Edge length of one bucket in world units */
+    double BucketSize = 1.0;
+};
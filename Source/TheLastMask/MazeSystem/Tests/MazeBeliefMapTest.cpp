@@ -0,0 +1,165 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeSystem/Core/MazeBeliefMap.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MazeBeliefMapTest
+{
+    /** Odd width so rows don't line up with the 4-wide SIMD blocks */
+    const FIntPoint Size(29, 17);
+    constexpr float Rate = 0.2f;
+
+    TArray<uint8> MakeWalkable(int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        TArray<uint8> Walkable;
+        Walkable.SetNumUninitialized(Size.X * Size.Y);
+        for (uint8& Cell : Walkable)
+        {
+            Cell = Random.FRand() < 0.65f ? 1 : 0;
+        }
+        return Walkable;
+    }
+
+    /** Sum of the map over every padded cell (walls included, they must hold 0) */
+    double SumAll(const FMazeBeliefMap& Map)
+    {
+        double Sum = 0.0;
+        for (const float Value : Map.GetValues())
+        {
+            Sum += Value;
+        }
+        return Sum;
+    }
+
+    /** Scalar reference step on the unpadded grid */
+    void ReferenceDiffuse(const TArray<uint8>& Walkable, TArray<double>& Values)
+    {
+        auto IsFloor = [&](int32 X, int32 Y)
+        {
+            return X >= 0 && X < Size.X && Y >= 0 && Y < Size.Y && Walkable[Y * Size.X + X] != 0;
+        };
+
+        TArray<double> Next;
+        Next.SetNumZeroed(Values.Num());
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                if (!IsFloor(X, Y))
+                {
+                    continue;
+                }
+
+                int32 NumNeighbors = 0;
+                double Incoming = 0.0;
+                for (const FIntPoint& Step : { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) })
+                {
+                    if (IsFloor(X + Step.X, Y + Step.Y))
+                    {
+                        ++NumNeighbors;
+                        Incoming += Values[(Y + Step.Y) * Size.X + X + Step.X];
+                    }
+                }
+                Next[Y * Size.X + X] = (1.0 - Rate * NumNeighbors) * Values[Y * Size.X + X] + Rate * Incoming;
+            }
+        }
+        Values = MoveTemp(Next);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeBeliefMapMassTest, "TheLastMask.Maze.BeliefMap.MassConservation",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeBeliefMapMassTest::RunTest(const FString& Parameters)
+{
+    using namespace MazeBeliefMapTest;
+
+    const TArray<uint8> Walkable = MakeWalkable(3);
+
+    FMazeBeliefTopology Topology;
+    Topology.Build(Walkable, Size, Rate, 1);
+    if (!TestTrue(TEXT("Topology valid"), Topology.IsValid()))
+    {
+        return false;
+    }
+
+    // Uniform start: total 1, and stays 1 through diffusion
+    FMazeBeliefMap Map;
+    Map.Reset(Topology);
+    TestTrue(TEXT("Reset total is 1"), FMath::IsNearlyEqual(SumAll(Map), 1.0, 1e-4));
+
+    Map.Diffuse(Topology, 50);
+    const float Uniform = 1.0f / Topology.GetNumFloor();
+    TestTrue(TEXT("Uniform belief stays uniform"), FMath::IsNearlyEqual(Map.GetProbability(Topology, FIntPoint(0, 0)), Walkable[0] ? Uniform : 0.0f, 1e-5f));
+    TestTrue(TEXT("Mass conserved from uniform"), FMath::IsNearlyEqual(SumAll(Map), 1.0, 1e-4));
+
+    // Point start: compare every cell with a scalar reference, walls stay empty
+    FIntPoint Start(-1, -1);
+    for (int32 Index = 0; Index < Walkable.Num() && Start.X < 0; ++Index)
+    {
+        if (Walkable[Index] && Index >= Walkable.Num() / 2)
+        {
+            Start = FIntPoint(Index % Size.X, Index / Size.X);
+        }
+    }
+
+    Map.Collapse(Topology, Start);
+    TArray<double> Reference;
+    Reference.SetNumZeroed(Walkable.Num());
+    Reference[Start.Y * Size.X + Start.X] = 1.0;
+
+    for (int32 Step = 1; Step <= 40; ++Step)
+    {
+        Map.Diffuse(Topology, 1);
+        ReferenceDiffuse(Walkable, Reference);
+
+        const double Sum = SumAll(Map);
+        if (!FMath::IsNearlyEqual(Sum, 1.0, 1e-4))
+        {
+            AddError(FString::Printf(TEXT("Step %d: total %f, expected 1"), Step, Sum));
+            return false;
+        }
+    }
+
+    for (int32 Y = 0; Y < Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < Size.X; ++X)
+        {
+            const float Value = Map.GetValues()[Topology.ToPadded(FIntPoint(X, Y))];
+            if (!FMath::IsNearlyEqual(static_cast<double>(Value), Reference[Y * Size.X + X], 1e-5))
+            {
+                AddError(FString::Printf(TEXT("Cell (%d, %d): %f, reference %f"), X, Y, Value, Reference[Y * Size.X + X]));
+                return false;
+            }
+            if (!Walkable[Y * Size.X + X] && Value != 0.0f)
+            {
+                AddError(FString::Printf(TEXT("Wall (%d, %d) holds belief"), X, Y));
+                return false;
+            }
+        }
+    }
+
+    // Observations remove mass; Settle renormalizes what is left
+    for (int32 X = 0; X < Size.X; ++X)
+    {
+        Map.ClearCell(Topology.ToPadded(FIntPoint(X, Start.Y)));
+    }
+    Map.Settle(Topology, TArrayView<const int32>());
+
+    double ProbabilitySum = 0.0;
+    for (int32 Y = 0; Y < Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < Size.X; ++X)
+        {
+            ProbabilitySum += Map.GetProbability(Topology, FIntPoint(X, Y));
+        }
+    }
+    TestTrue(TEXT("Probabilities sum to 1 after observing"), FMath::IsNearlyEqual(ProbabilitySum, 1.0, 1e-4));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,123 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeTestGrids.h"
+#include "MazeSystem/Core/MazeDerivedData.h"
+#include "MazeSystem/Core/MazeGridHash.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MazeDerivedDataTest
+{
+    /**
+     * Do two builds describe the same grid? Component ids are not stable
+     * after edits, so regions are compared as a one-to-one id mapping.
+     */
+    bool Matches(const FMazeDerivedData& Incremental, const FMazeDerivedData& Full, FString& OutMismatch)
+    {
+        if (Incremental.Size != Full.Size || Incremental.FloorCount != Full.FloorCount || Incremental.NumComponents != Full.NumComponents)
+        {
+            OutMismatch = FString::Printf(TEXT("counts: floor %d vs %d, components %d vs %d"),
+                Incremental.FloorCount, Full.FloorCount, Incremental.NumComponents, Full.NumComponents);
+            return false;
+        }
+
+        TMap<int32, int32> IncrementalToFull;
+        TMap<int32, int32> FullToIncremental;
+
+        for (int32 Index = 0; Index < Full.Topology.Num(); ++Index)
+        {
+            if (Incremental.Topology[Index] != Full.Topology[Index])
+            {
+                OutMismatch = FString::Printf(TEXT("topology at cell %d"), Index);
+                return false;
+            }
+            if (Incremental.Clearance[Index] != Full.Clearance[Index])
+            {
+                OutMismatch = FString::Printf(TEXT("clearance at cell %d: %d vs %d"), Index, Incremental.Clearance[Index], Full.Clearance[Index]);
+                return false;
+            }
+
+            const int32 IncrementalId = Incremental.Components[Index];
+            const int32 FullId = Full.Components[Index];
+            if ((IncrementalId == INDEX_NONE) != (FullId == INDEX_NONE))
+            {
+                OutMismatch = FString::Printf(TEXT("component wall/floor at cell %d"), Index);
+                return false;
+            }
+            if (FullId == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const int32& MappedFull = IncrementalToFull.FindOrAdd(IncrementalId, FullId);
+            const int32& MappedIncremental = FullToIncremental.FindOrAdd(FullId, IncrementalId);
+            if (MappedFull != FullId || MappedIncremental != IncrementalId)
+            {
+                OutMismatch = FString::Printf(TEXT("component split/merge at cell %d"), Index);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeDerivedDataRefreshTest, "TheLastMask.Maze.DerivedData.RefreshMatchesRebuild",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeDerivedDataRefreshTest::RunTest(const FString& Parameters)
+{
+    // Wide enough that clearance reaches MaxClearance in open areas
+    const FIntPoint Size(48, 40);
+    UMazeGridData* Grid = MazeTestGrids::MakeRandom(Size, 21, 0.75f);
+    FRandomStream Random(5);
+
+    TArray<FIntPoint> Batch;
+    for (int32 Step = 0; Step < 300; ++Step)
+    {
+        Batch.Reset();
+
+        // Mix scattered cells with straight walls that split or join regions
+        if (Random.FRand() < 0.3f)
+        {
+            const bool bHorizontal = Random.FRand() < 0.5f;
+            const FIntPoint Start(Random.RandHelper(Size.X), Random.RandHelper(Size.Y));
+            const int32 Length = Random.RandRange(4, 30);
+            for (int32 i = 0; i < Length; ++i)
+            {
+                Batch.Add(bHorizontal ? FIntPoint(Start.X + i, Start.Y) : FIntPoint(Start.X, Start.Y + i));
+            }
+        }
+        else
+        {
+            const int32 Count = Random.RandRange(1, 8);
+            for (int32 i = 0; i < Count; ++i)
+            {
+                Batch.Add(FIntPoint(Random.RandHelper(Size.X), Random.RandHelper(Size.Y)));
+            }
+        }
+
+        // Out of bounds cells in line batches are ignored by PaintCells
+        Grid->PaintCells(Batch, Random.FRand() < 0.5f);
+
+        FMazeDerivedData Full;
+        Full.Build(Grid->Cells, Size);
+
+        FString Mismatch;
+        if (!MazeDerivedDataTest::Matches(Grid->GetDerivedData(), Full, Mismatch))
+        {
+            AddError(FString::Printf(TEXT("Step %d: incremental refresh differs from a full rebuild (%s)"), Step, *Mismatch));
+            return false;
+        }
+
+        if (Grid->GetGridHash() != FMazeGridHash::Compute(Grid->Cells, Size))
+        {
+            AddError(FString::Printf(TEXT("Step %d: incremental grid hash differs from a full hash"), Step));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
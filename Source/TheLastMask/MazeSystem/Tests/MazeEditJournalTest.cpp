@@ -0,0 +1,137 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeSystem/Core/MazeEditJournal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MazeEditJournalTest
+{
+    /** A walkability byte grid edited through a journal, like AMazeManager does */
+    struct FJournaledGrid
+    {
+        TArray<uint8> Cells;
+        FMazeEditJournal Journal;
+
+        explicit FJournaledGrid(int32 NumCells)
+        {
+            Cells.Init(0, NumCells);
+        }
+
+        /** Flip the given cells in one transaction, returns its id */
+        int32 Flip(FName Label, std::initializer_list<int32> Indices)
+        {
+            Journal.Begin(Label);
+            for (const int32 Index : Indices)
+            {
+                const uint8 NewValue = Cells[Index] ? 0 : 1;
+                Journal.Record(Index, Cells[Index], NewValue);
+                Cells[Index] = NewValue;
+            }
+            return Journal.End();
+        }
+
+        /** Undo one transaction, false if the journal refused */
+        bool Rollback(int32 Id)
+        {
+            TArray<FMazeCellEdit> Edits;
+            if (!Journal.TakeTransaction(Id, Edits))
+            {
+                return false;
+            }
+            for (const FMazeCellEdit& Edit : Edits)
+            {
+                Cells[Edit.Index] = Edit.OldValue;
+            }
+            return true;
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeEditJournalRollbackTest, "TheLastMask.Maze.EditJournal.Rollback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeEditJournalRollbackTest::RunTest(const FString& Parameters)
+{
+    using namespace MazeEditJournalTest;
+
+    FJournaledGrid Grid(64);
+    const TArray<uint8> Original = Grid.Cells;
+
+    // A cell edited twice in one transaction is restored to its first old value
+    const int32 First = Grid.Flip(TEXT("First"), { 1, 2, 3, 2 });
+    const int32 Second = Grid.Flip(TEXT("Second"), { 3, 4, 5 });
+    TestTrue(TEXT("Ids are positive and increasing"), First > 0 && Second > First);
+    TestEqual(TEXT("Latest id"), Grid.Journal.GetLatestTransactionId(), Second);
+
+    // Empty transactions are discarded
+    Grid.Journal.Begin(TEXT("Empty"));
+    TestEqual(TEXT("Empty transaction closes to 0"), Grid.Journal.End(), 0);
+    TestEqual(TEXT("Empty transaction not kept"), Grid.Journal.GetTransactions().Num(), 2);
+
+    // Nested Begin joins the open transaction
+    const int32 Outer = Grid.Journal.Begin(TEXT("Outer"));
+    TestEqual(TEXT("Nested Begin returns the open id"), Grid.Journal.Begin(TEXT("Inner")), Outer);
+    Grid.Journal.Record(10, Grid.Cells[10], 1);
+    Grid.Cells[10] = 1;
+    TestEqual(TEXT("Inner End keeps it open"), Grid.Journal.End(), 0);
+    TestTrue(TEXT("Still open"), Grid.Journal.IsOpen());
+    TestEqual(TEXT("Outer End closes it"), Grid.Journal.End(), Outer);
+
+    // Out of order: First overlaps Second (cell 3), so it must wait
+    TestFalse(TEXT("Overlapped older transaction refused"), Grid.Rollback(First));
+
+    // Outer touches no cell of the others, so it can go in any order
+    TestTrue(TEXT("Independent transaction rolls back out of order"), Grid.Rollback(Outer));
+    TestEqual(TEXT("Independent cell restored"), Grid.Cells[10], static_cast<uint8>(0));
+
+    TestTrue(TEXT("Roll back Second"), Grid.Rollback(Second));
+    TestTrue(TEXT("Roll back First"), Grid.Rollback(First));
+    TestTrue(TEXT("Grid back to the original"), Grid.Cells == Original);
+
+    TestFalse(TEXT("Second rollback of the same id refused"), Grid.Rollback(First));
+    TestFalse(TEXT("Unknown id refused"), Grid.Rollback(12345));
+    TestEqual(TEXT("Journal empty"), Grid.Journal.GetTransactions().Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeEditJournalTrimTest, "TheLastMask.Maze.EditJournal.Trim",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeEditJournalTrimTest::RunTest(const FString& Parameters)
+{
+    using namespace MazeEditJournalTest;
+
+    FJournaledGrid Grid(64);
+    Grid.Journal.MaxEdits = 10;
+
+    const int32 A = Grid.Flip(TEXT("A"), { 0, 1, 2, 3 });
+    const TArray<uint8> AfterA = Grid.Cells;
+    const int32 B = Grid.Flip(TEXT("B"), { 4, 5, 6, 7 });
+    const int32 C = Grid.Flip(TEXT("C"), { 8, 9, 10, 11 });
+
+    // 12 edits > 10: the oldest transaction is forgotten, the rest kept
+    TestEqual(TEXT("Oldest transaction dropped"), Grid.Journal.GetTransactions().Num(), 2);
+    TestEqual(TEXT("Oldest remaining is B"), Grid.Journal.GetTransactions()[0].Id, B);
+    TestFalse(TEXT("Dropped transaction can't roll back"), Grid.Rollback(A));
+
+    // What is left still rolls back to the state after A
+    TestTrue(TEXT("Roll back C"), Grid.Rollback(C));
+    TestTrue(TEXT("Roll back B"), Grid.Rollback(B));
+    TestTrue(TEXT("Back to the state after A"), Grid.Cells == AfterA);
+
+    // A transaction larger than MaxEdits on its own is dropped at once
+    const int32 Huge = Grid.Flip(TEXT("Huge"), { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 });
+    TestEqual(TEXT("Oversized transaction closes to 0"), Huge, 0);
+    TestEqual(TEXT("Oversized transaction not kept"), Grid.Journal.GetTransactions().Num(), 0);
+
+    // And the journal keeps working afterwards
+    const TArray<uint8> BeforeD = Grid.Cells;
+    const int32 D = Grid.Flip(TEXT("D"), { 40, 41 });
+    TestTrue(TEXT("Journal usable after trimming"), D > 0 && Grid.Rollback(D) && Grid.Cells == BeforeD);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
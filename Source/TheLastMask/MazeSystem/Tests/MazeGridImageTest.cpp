@@ -0,0 +1,130 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeTestGrids.h"
+#include "MazeSystem/Core/MazeGridImage.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MazeGridImageTest
+{
+    /** Odd, non-square size: exercises PBM row padding and the RawSize path */
+    const FIntPoint GridSize(37, 23);
+
+    FString TempFile(const TCHAR* Extension)
+    {
+        return FPaths::Combine(FPaths::AutomationTransientDir(), FString::Printf(TEXT("MazeGridImageTest.%s"), Extension));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeGridImageRoundTripTest, "TheLastMask.Maze.GridImage.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeGridImageRoundTripTest::RunTest(const FString& Parameters)
+{
+    using namespace MazeGridImageTest;
+
+    UMazeGridData* Source = MazeTestGrids::MakeRandom(GridSize, 7);
+
+    for (const TCHAR* Extension : { TEXT("pgm"), TEXT("pbm"), TEXT("raw"), TEXT("png") })
+    {
+        const FString Filename = TempFile(Extension);
+        FString Error;
+
+        if (!TestTrue(FString::Printf(TEXT("Export .%s"), Extension), FMazeGridImageCodec::Export(*Source, Filename, Error)))
+        {
+            AddError(Error);
+            continue;
+        }
+
+        UMazeGridData* Loaded = MazeTestGrids::MakeRandom(FIntPoint(4, 4), 1);
+        if (!TestTrue(FString::Printf(TEXT("Import .%s"), Extension), FMazeGridImageCodec::Import(*Loaded, Filename, Error, GridSize)))
+        {
+            AddError(Error);
+            continue;
+        }
+
+        TestTrue(FString::Printf(TEXT(".%s layout matches"), Extension), MazeTestGrids::SameLayout(*Source, *Loaded));
+        TestTrue(FString::Printf(TEXT(".%s grid hash matches"), Extension), Source->GetGridHash() == Loaded->GetGridHash());
+
+        // Derived data is built during the streamed import
+        TestEqual(FString::Printf(TEXT(".%s component count"), Extension), Loaded->GetComponentCount(), Source->GetComponentCount());
+
+        // 1-bit PBM has no room for markers
+        if (FCString::Strcmp(Extension, TEXT("pbm")) != 0)
+        {
+            TestTrue(FString::Printf(TEXT(".%s spawn marker"), Extension), Loaded->SpawnCell == Source->SpawnCell);
+            TestTrue(FString::Printf(TEXT(".%s exit marker"), Extension), Loaded->ExitCell == Source->ExitCell);
+            TestTrue(FString::Printf(TEXT(".%s key marker"), Extension), Loaded->KeyCell == Source->KeyCell);
+        }
+
+        IFileManager::Get().Delete(*Filename);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeGridImageTruncatedTest, "TheLastMask.Maze.GridImage.Truncated",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeGridImageTruncatedTest::RunTest(const FString& Parameters)
+{
+    using namespace MazeGridImageTest;
+
+    UMazeGridData* Source = MazeTestGrids::MakeRandom(GridSize, 11);
+
+    // Every failure must leave the grid exactly as it was
+    UMazeGridData* Existing = MazeTestGrids::MakeRandom(FIntPoint(9, 6), 3);
+    const uint64 ExistingHash = Existing->GetGridHash();
+    const FIntPoint ExistingSpawn = Existing->SpawnCell;
+
+    auto ExpectRefused = [&](const FString& What, const FString& Filename, FIntPoint RawSize)
+    {
+        FString Error;
+        TestFalse(What + TEXT(" is refused"), FMazeGridImageCodec::Import(*Existing, Filename, Error, RawSize));
+        TestFalse(What + TEXT(" reports an error"), Error.IsEmpty());
+        TestTrue(What + TEXT(" leaves the grid untouched"),
+            Existing->SizeX == 9 && Existing->SizeY == 6 && Existing->IsValid()
+            && Existing->GetGridHash() == ExistingHash && Existing->SpawnCell == ExistingSpawn);
+    };
+
+    for (const TCHAR* Extension : { TEXT("pgm"), TEXT("pbm"), TEXT("raw") })
+    {
+        const FString Filename = TempFile(Extension);
+        FString Error;
+        TestTrue(FString::Printf(TEXT("Export .%s"), Extension), FMazeGridImageCodec::Export(*Source, Filename, Error));
+
+        TArray<uint8> Bytes;
+        TestTrue(TEXT("Read back export"), FFileHelper::LoadFileToArray(Bytes, *Filename));
+
+        // Last row cut short
+        Bytes.SetNum(Bytes.Num() - 3);
+        FFileHelper::SaveArrayToFile(Bytes, *Filename);
+        ExpectRefused(FString::Printf(TEXT("Truncated .%s"), Extension), Filename, GridSize);
+
+        // Header only (raw has none, so this is an empty file)
+        Bytes.SetNum(FCString::Strcmp(Extension, TEXT("raw")) == 0 ? 0 : 12);
+        FFileHelper::SaveArrayToFile(Bytes, *Filename);
+        ExpectRefused(FString::Printf(TEXT("Header-only .%s"), Extension), Filename, GridSize);
+
+        IFileManager::Get().Delete(*Filename);
+    }
+
+    // Unsupported netpbm type (ASCII P2)
+    {
+        const FString Filename = TempFile(TEXT("pgm"));
+        FFileHelper::SaveStringToFile(TEXT("P2\n2 2\n255\n0 255\n255 0\n"), *Filename);
+        ExpectRefused(TEXT("ASCII PGM"), Filename, FIntPoint::ZeroValue);
+        IFileManager::Get().Delete(*Filename);
+    }
+
+    // Missing file
+    ExpectRefused(TEXT("Missing file"), TempFile(TEXT("pgm")), FIntPoint::ZeroValue);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
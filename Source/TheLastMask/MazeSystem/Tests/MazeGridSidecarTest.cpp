@@ -0,0 +1,118 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeSystem/Core/MazeGridSidecar.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeGridSidecarRoundTripTest, "TheLastMask.Maze.GridSidecar.WriteAndOpen",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeGridSidecarRoundTripTest::RunTest(const FString& Parameters)
+{
+    const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("MazeGridSidecarTest.mazeplanes"));
+
+    // Odd size so the walkable plane doesn't end on the alignment
+    const FIntPoint Size(131, 77);
+    const uint64 GridHash = 0x0123456789ABCDEFull;
+    const TArray<FIntPoint> Landmarks = { FIntPoint(0, 0), FIntPoint(130, 76), FIntPoint(65, 40) };
+
+    FRandomStream Random(17);
+    TArray<uint8> Walkable;
+    Walkable.SetNumUninitialized(Size.X * Size.Y);
+    for (uint8& Cell : Walkable)
+    {
+        Cell = Random.FRand() < 0.6f ? 1 : 0;
+    }
+
+    TArray<uint16> Distances;
+    Distances.SetNumUninitialized(Walkable.Num() * Landmarks.Num());
+    for (uint16& Distance : Distances)
+    {
+        Distance = static_cast<uint16>(Random.RandHelper(MAX_uint16 + 1));
+    }
+
+    FString Error;
+    if (!TestTrue(TEXT("Write"), FMazeGridSidecar::Write(Filename, Size, GridHash, Walkable, Landmarks, Distances, Error)))
+    {
+        AddError(Error);
+        return false;
+    }
+
+    {
+        FMazeGridSidecar Sidecar;
+        if (!TestTrue(TEXT("Open"), Sidecar.Open(Filename, Error)))
+        {
+            AddError(Error);
+            return false;
+        }
+
+        TestTrue(TEXT("Size"), Sidecar.GetSize() == Size);
+        TestTrue(TEXT("Grid hash"), Sidecar.GetGridHash() == GridHash);
+        TestEqual(TEXT("Landmark count"), Sidecar.GetNumLandmarks(), Landmarks.Num());
+
+        TArray<FIntPoint> ReadLandmarks;
+        Sidecar.GetLandmarks(ReadLandmarks);
+        TestTrue(TEXT("Landmark cells"), ReadLandmarks == Landmarks);
+
+        const TArrayView<const uint8> ReadWalkable = Sidecar.GetWalkable();
+        TestTrue(TEXT("Walkable plane"), ReadWalkable.Num() == Walkable.Num()
+            && FMemory::Memcmp(ReadWalkable.GetData(), Walkable.GetData(), Walkable.Num()) == 0);
+
+        const TArrayView<const uint16> ReadDistances = Sidecar.GetLandmarkDistances();
+        TestTrue(TEXT("Landmark plane"), ReadDistances.Num() == Distances.Num()
+            && FMemory::Memcmp(ReadDistances.GetData(), Distances.GetData(), Distances.Num() * sizeof(uint16)) == 0);
+
+        // Planes start on the alignment, so each can be paged independently
+        const UPTRINT PlaneGap = reinterpret_cast<UPTRINT>(ReadDistances.GetData()) - reinterpret_cast<UPTRINT>(ReadWalkable.GetData());
+        TestEqual(TEXT("Planes aligned"), static_cast<int64>(PlaneGap % FMazeGridSidecar::PlaneAlignment), static_cast<int64>(0));
+
+        Sidecar.Close();
+        TestFalse(TEXT("Closed"), Sidecar.IsOpen());
+    }
+
+    // Mismatched inputs are refused at write time
+    TestFalse(TEXT("Short walkable plane refused"),
+        FMazeGridSidecar::Write(Filename, Size, GridHash, TArrayView<const uint8>(Walkable.GetData(), Walkable.Num() - 1), Landmarks, Distances, Error));
+    TestFalse(TEXT("Short landmark plane refused"),
+        FMazeGridSidecar::Write(Filename, Size, GridHash, Walkable, Landmarks, TArrayView<const uint16>(Distances.GetData(), Distances.Num() - 1), Error));
+
+    // Damaged files are refused at open time
+    TArray<uint8> Bytes;
+    TestTrue(TEXT("Read back sidecar"), FFileHelper::LoadFileToArray(Bytes, *Filename));
+
+    auto ExpectRefused = [&](const FString& What, const TArray<uint8>& FileBytes)
+    {
+        FFileHelper::SaveArrayToFile(FileBytes, *Filename);
+
+        FMazeGridSidecar Sidecar;
+        FString OpenError;
+        TestFalse(What + TEXT(" refused"), Sidecar.Open(Filename, OpenError));
+        TestFalse(What + TEXT(" reports an error"), OpenError.IsEmpty());
+        TestFalse(What + TEXT(" left closed"), Sidecar.IsOpen());
+    };
+
+    {
+        TArray<uint8> Damaged = Bytes;
+        Damaged[0] ^= 0xFF;
+        ExpectRefused(TEXT("Bad magic"), Damaged);
+    }
+    {
+        TArray<uint8> Damaged = Bytes;
+        Damaged.SetNum(Damaged.Num() - 1);
+        ExpectRefused(TEXT("Truncated file"), Damaged);
+    }
+    {
+        TArray<uint8> Damaged = Bytes;
+        Damaged.SetNum(16);
+        ExpectRefused(TEXT("Header-only file"), Damaged);
+    }
+
+    IFileManager::Get().Delete(*Filename);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
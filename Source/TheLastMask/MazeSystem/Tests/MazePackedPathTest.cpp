@@ -0,0 +1,167 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeSystem/Core/MazePackedPath.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+/*=============================================================================
+    UNREAL ENGINE CONCEPTS EXPLAINED:
+
+    IMPLEMENT_SIMPLE_AUTOMATION_TEST:
+        - Declares a test class and registers it by name
+        - Shows up in Session Frontend > Automation (or -ExecCmds="Automation RunTests TheLastMask")
+        - RunTest returns false (or logs errors via TestTrue etc.) to fail
+
+    WITH_DEV_AUTOMATION_TESTS:
+        - Defined in editor and development builds, 0 in shipping
+        - Keeps the tests out of the shipped game
+=============================================================================*/
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazePackedPathRoundTripTest, "TheLastMask.Maze.PackedPath.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazePackedPathRoundTripTest::RunTest(const FString& Parameters)
+{
+    // Long straight runs (multi-byte varints), turns in every direction, single steps
+    TArray<FIntPoint> Path;
+    FIntPoint Cell(5, 5);
+    Path.Add(Cell);
+    auto Walk = [&](const FIntPoint& Step, int32 Count)
+    {
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Cell += Step;
+            Path.Add(Cell);
+        }
+    };
+    Walk(FIntPoint(1, 0), 300);
+    Walk(FIntPoint(0, 1), 1);
+    Walk(FIntPoint(-1, 0), 40);
+    Walk(FIntPoint(0, -1), 3);
+    Walk(FIntPoint(1, 0), 1);
+    Walk(FIntPoint(0, 1), 33);
+
+    FMazePackedPath Packed;
+    TestTrue(TEXT("Encode succeeds"), Packed.Encode(Path));
+    TestEqual(TEXT("NumCells"), Packed.NumCells, Path.Num());
+    TestTrue(TEXT("StartCell"), Packed.StartCell == Path[0]);
+
+    TArray<FIntPoint> Decoded;
+    TestTrue(TEXT("Decode succeeds"), Packed.Decode(Decoded));
+    TestTrue(TEXT("Decoded path matches"), Decoded == Path);
+
+    // Single cell and empty paths
+    FMazePackedPath Single;
+    TestTrue(TEXT("Encode single cell"), Single.Encode(TArrayView<const FIntPoint>(Path.GetData(), 1)));
+    TestTrue(TEXT("Decode single cell"), Single.Decode(Decoded) && Decoded.Num() == 1 && Decoded[0] == Path[0]);
+
+    FMazePackedPath Empty;
+    TestTrue(TEXT("Encode empty"), Empty.Encode(TArrayView<const FIntPoint>()));
+    TestTrue(TEXT("Empty is empty"), Empty.IsEmpty());
+    TestTrue(TEXT("Decode empty"), Empty.Decode(Decoded) && Decoded.Num() == 0);
+
+    // Through the replication path
+    FBitWriter Writer(0, true);
+    bool bSuccess = false;
+    Packed.NetSerialize(Writer, nullptr, bSuccess);
+    TestTrue(TEXT("NetSerialize save"), bSuccess);
+
+    FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+    FMazePackedPath Received;
+    Received.NetSerialize(Reader, nullptr, bSuccess);
+    TestTrue(TEXT("NetSerialize load"), bSuccess);
+    TestTrue(TEXT("Received matches sent"), Received == Packed);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazePackedPathMalformedTest, "TheLastMask.Maze.PackedPath.Malformed",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazePackedPathMalformedTest::RunTest(const FString& Parameters)
+{
+    TArray<FIntPoint> Decoded;
+
+    // Non-neighbouring cells cannot be packed
+    {
+        const TArray<FIntPoint> Gap = { FIntPoint(0, 0), FIntPoint(2, 0) };
+        FMazePackedPath Packed;
+        TestFalse(TEXT("Encode refuses a gap"), Packed.Encode(Gap));
+        TestTrue(TEXT("Refused encode leaves an empty path"), Packed.IsEmpty());
+    }
+
+    // A valid base to corrupt: 3 east, 2 south = 6 cells
+    const TArray<FIntPoint> Path = { FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(2, 0), FIntPoint(3, 0), FIntPoint(3, 1), FIntPoint(3, 2) };
+    FMazePackedPath Valid;
+    TestTrue(TEXT("Encode base path"), Valid.Encode(Path));
+
+    // NumCells that disagrees with the runs (the allocation bomb case)
+    {
+        FMazePackedPath Bad = Valid;
+        Bad.NumCells = 100000000;
+        TestFalse(TEXT("Decode refuses an inflated NumCells"), Bad.Decode(Decoded));
+        TestEqual(TEXT("Nothing allocated for an inflated NumCells"), Decoded.Max(), 0);
+
+        Bad.NumCells = Valid.NumCells - 1;
+        TestFalse(TEXT("Decode refuses a short NumCells"), Bad.Decode(Decoded));
+    }
+
+    // MaxCells cap
+    {
+        TestFalse(TEXT("Decode refuses a path over MaxCells"), Valid.Decode(Decoded, Valid.NumCells - 1));
+        TestTrue(TEXT("Decode accepts a path at MaxCells"), Valid.Decode(Decoded, Valid.NumCells));
+    }
+
+    // Truncated varint (continuation bit on the last byte)
+    {
+        FMazePackedPath Bad = Valid;
+        Bad.Runs.Last() |= 0x80;
+        TestFalse(TEXT("Decode refuses a truncated varint"), Bad.Decode(Decoded));
+    }
+
+    // Runs with no cells, and a negative count
+    {
+        FMazePackedPath Bad;
+        Bad.Runs.Add(0);
+        TestFalse(TEXT("Decode refuses runs without cells"), Bad.Decode(Decoded));
+
+        Bad.NumCells = -5;
+        TestFalse(TEXT("Decode refuses a negative NumCells"), Bad.Decode(Decoded));
+    }
+
+    // Inflated NumCells through the replication path
+    {
+        FMazePackedPath Bad = Valid;
+        Bad.NumCells = 1000;
+
+        FBitWriter Writer(0, true);
+        bool bSuccess = false;
+        Bad.NetSerialize(Writer, nullptr, bSuccess);
+
+        FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+        FMazePackedPath Received;
+        Received.NetSerialize(Reader, nullptr, bSuccess);
+        TestFalse(TEXT("NetSerialize refuses runs that disagree with NumCells"), bSuccess);
+        TestTrue(TEXT("Refused load leaves an empty path"), Received.IsEmpty());
+    }
+
+    // Truncated packet
+    {
+        FBitWriter Writer(0, true);
+        bool bSuccess = false;
+        FMazePackedPath Sent = Valid;
+        Sent.NetSerialize(Writer, nullptr, bSuccess);
+
+        FBitReader Reader(Writer.GetData(), Writer.GetNumBits() - 8);
+        FMazePackedPath Received;
+        Received.NetSerialize(Reader, nullptr, bSuccess);
+        TestFalse(TEXT("NetSerialize refuses a truncated packet"), bSuccess);
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,76 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MazeSystem/Core/MazeGridData.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Grids shared by the maze automation tests.
+ * Random layouts (not generated mazes) so rooms, dead ends, junctions and
+ * disconnected regions all show up in a small grid.
+ */
+namespace MazeTestGrids
+{
+    /** Fill Grid with a seeded random layout and rebuild its derived data */
+    inline void FillRandom(UMazeGridData& Grid, FIntPoint Size, int32 Seed, float FloorChance = 0.6f)
+    {
+        FRandomStream Random(Seed);
+
+        Grid.SizeX = Size.X;
+        Grid.SizeY = Size.Y;
+        Grid.Seed = Seed;
+        Grid.Cells.Reset(Size.X * Size.Y);
+
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                const FVector WorldPos(X * Grid.CellSize + Grid.CellSize * 0.5f, Y * Grid.CellSize + Grid.CellSize * 0.5f, 0.0f);
+                Grid.Cells.Emplace(FIntPoint(X, Y), WorldPos, Random.FRand() < FloorChance);
+            }
+        }
+
+        // Markers in distinct floor cells
+        Grid.SpawnCell = FIntPoint(0, 0);
+        Grid.ExitCell = FIntPoint(Size.X - 1, Size.Y - 1);
+        Grid.KeyCell = FIntPoint(Size.X / 2, Size.Y / 2);
+        for (const FIntPoint& Marker : { Grid.SpawnCell, Grid.ExitCell, Grid.KeyCell })
+        {
+            Grid.Cells[Marker.Y * Size.X + Marker.X].bIsFloor = true;
+        }
+
+        Grid.RebuildDerivedData();
+    }
+
+    /** New transient grid with a seeded random layout */
+    inline UMazeGridData* MakeRandom(FIntPoint Size, int32 Seed, float FloorChance = 0.6f)
+    {
+        UMazeGridData* Grid = NewObject<UMazeGridData>(GetTransientPackage());
+        FillRandom(*Grid, Size, Seed, FloorChance);
+        return Grid;
+    }
+
+    /** Same size and floor/wall layout? */
+    inline bool SameLayout(const UMazeGridData& A, const UMazeGridData& B)
+    {
+        if (A.SizeX != B.SizeX || A.SizeY != B.SizeY || A.Cells.Num() != B.Cells.Num())
+        {
+            return false;
+        }
+
+        for (int32 Index = 0; Index < A.Cells.Num(); ++Index)
+        {
+            if (A.Cells[Index].bIsFloor != B.Cells[Index].bIsFloor)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
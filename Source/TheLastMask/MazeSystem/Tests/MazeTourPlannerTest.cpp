@@ -0,0 +1,139 @@
+// Copyright The Last Mask Team. All Rights Reserved.
+
+#include "MazeSystem/Core/MazeTourPlanner.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MazeTourPlannerTest
+{
+    /** Manhattan distances between random points: symmetric, like maze distances */
+    TArray<int32> MakeMatrix(int32 Num, FRandomStream& Random)
+    {
+        TArray<FIntPoint> Points;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Points.Add(FIntPoint(Random.RandHelper(64), Random.RandHelper(64)));
+        }
+
+        TArray<int32> Matrix;
+        Matrix.SetNumUninitialized(Num * Num);
+        for (int32 A = 0; A < Num; ++A)
+        {
+            for (int32 B = 0; B < Num; ++B)
+            {
+                Matrix[A * Num + B] = FMath::Abs(Points[A].X - Points[B].X) + FMath::Abs(Points[A].Y - Points[B].Y);
+            }
+        }
+        return Matrix;
+    }
+
+    /** Shortest route by trying every order of Stops[Depth..] */
+    void BruteForce(const TArray<int32>& Matrix, int32 Num, int32 End, TArray<int32>& Stops, int32 Depth, int32 Last, int32 Length, int32& InOutBest)
+    {
+        if (Depth == Stops.Num())
+        {
+            InOutBest = FMath::Min(InOutBest, End == INDEX_NONE ? Length : Length + Matrix[Last * Num + End]);
+            return;
+        }
+
+        for (int32 i = Depth; i < Stops.Num(); ++i)
+        {
+            Stops.Swap(Depth, i);
+            BruteForce(Matrix, Num, End, Stops, Depth + 1, Stops[Depth], Length + Matrix[Last * Num + Stops[Depth]], InOutBest);
+            Stops.Swap(Depth, i);
+        }
+    }
+
+    /** Does Order visit every node once, start and end where asked, and add up to Length? */
+    bool IsValidTour(const FMazeTour& Tour, const TArray<int32>& Matrix, int32 Num, int32 Start, int32 End)
+    {
+        if (Tour.Order.Num() != Num || Tour.Order[0] != Start || (End != INDEX_NONE && Tour.Order.Last() != End))
+        {
+            return false;
+        }
+
+        TBitArray<> Seen(false, Num);
+        int32 Length = 0;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            const int32 Node = Tour.Order[i];
+            if (Node < 0 || Node >= Num || Seen[Node])
+            {
+                return false;
+            }
+            Seen[Node] = true;
+            Length += i > 0 ? Matrix[Tour.Order[i - 1] * Num + Node] : 0;
+        }
+        return Length == Tour.Length;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMazeTourPlannerExactTest, "TheLastMask.Maze.TourPlanner.MatchesBruteForce",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMazeTourPlannerExactTest::RunTest(const FString& Parameters)
+{
+    using namespace MazeTourPlannerTest;
+
+    FMazeTourPlanner Planner;
+    FRandomStream Random(9);
+
+    // 1..9 nodes, open and fixed-end routes; the planner is reused, like in game
+    for (int32 Num = 1; Num <= 9; ++Num)
+    {
+        for (int32 Trial = 0; Trial < 6; ++Trial)
+        {
+            const TArray<int32> Matrix = MakeMatrix(Num, Random);
+            const int32 Start = Random.RandHelper(Num);
+            const int32 End = (Num > 1 && (Trial & 1)) ? (Start + 1 + Random.RandHelper(Num - 1)) % Num : INDEX_NONE;
+
+            TArray<int32> Stops;
+            for (int32 Node = 0; Node < Num; ++Node)
+            {
+                if (Node != Start && Node != End)
+                {
+                    Stops.Add(Node);
+                }
+            }
+
+            int32 Expected = MAX_int32;
+            BruteForce(Matrix, Num, End, Stops, 0, Start, 0, Expected);
+
+            FMazeTour Tour;
+            const FString What = FString::Printf(TEXT("%d nodes, trial %d"), Num, Trial);
+            if (!TestTrue(What + TEXT(": solved"), Planner.Solve(Matrix, Num, Start, End, Tour)))
+            {
+                continue;
+            }
+
+            TestTrue(What + TEXT(": exact"), Tour.bOptimal);
+            TestTrue(What + TEXT(": valid tour"), IsValidTour(Tour, Matrix, Num, Start, End));
+            TestEqual(What + TEXT(": optimal length"), Tour.Length, Expected);
+        }
+    }
+
+    // Past MaxExactStops 2-opt takes over: not optimal, but still a valid tour
+    {
+        const int32 Num = FMazeTourPlanner::MaxExactStops + 6;
+        const TArray<int32> Matrix = MakeMatrix(Num, Random);
+
+        FMazeTour Tour;
+        TestTrue(TEXT("Large solve"), Planner.Solve(Matrix, Num, 0, Num - 1, Tour));
+        TestFalse(TEXT("Large solve is approximate"), Tour.bOptimal);
+        TestTrue(TEXT("Large solve is a valid tour"), IsValidTour(Tour, Matrix, Num, 0, Num - 1));
+    }
+
+    // Bad inputs
+    {
+        const TArray<int32> Matrix = MakeMatrix(4, Random);
+        FMazeTour Tour;
+        TestFalse(TEXT("Start out of range refused"), Planner.Solve(Matrix, 4, 4, INDEX_NONE, Tour));
+        TestFalse(TEXT("End equal to Start refused"), Planner.Solve(Matrix, 4, 1, 1, Tour));
+        TestFalse(TEXT("Matrix size mismatch refused"), Planner.Solve(Matrix, 3, 0, INDEX_NONE, Tour));
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
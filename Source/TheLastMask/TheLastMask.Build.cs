@@ -22,7 +22,10 @@ public class TheLastMask : ModuleRules
             "Engine",
             
             // Needed for Enhanced Input (UE5 input system)
-            "EnhancedInput"
+            "EnhancedInput",
+
+            // Needed for PNG import/export of maze grids (IImageWrapper)
+            "ImageWrapper"
         });
     }
 }